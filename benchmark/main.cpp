@@ -0,0 +1,732 @@
+#include "geometry.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+/* build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers */
+
+namespace {
+
+/* keeps results observable so the optimizer cannot drop the measured work */
+volatile double sink{};
+
+template <typename F>
+void
+measure(std::string_view name, std::size_t ops, F && f)
+{
+  auto const start = std::chrono::steady_clock::now();
+  sink = sink + f();
+  auto const stop = std::chrono::steady_clock::now();
+
+  auto const ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  std::printf("%-48.*s %12.2f ns/op %14.0f op/s\n",
+              static_cast<int>(name.size()), name.data(),
+              ns / static_cast<double>(ops),
+              static_cast<double>(ops) / ns * 1e9);
+}
+
+template <typename F>
+void
+throughput(std::string_view name, std::size_t bytes, F && f)
+{
+  auto const start = std::chrono::steady_clock::now();
+  sink = sink + f();
+  auto const stop = std::chrono::steady_clock::now();
+
+  auto const ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  std::printf("%-48.*s %12.3f GB/s\n",
+              static_cast<int>(name.size()), name.data(),
+              static_cast<double>(bytes) / ns);
+}
+
+constexpr std::array<geo::Vector3d, 4> cubic_ctrls{
+  geo::Vector3d(1.0, 0.0, 0.0),
+  geo::Vector3d(1.0, 0.558, 0.0),
+  geo::Vector3d(0.558, 1.0, 0.0),
+  geo::Vector3d(0.0, 1.0, 0.0)
+};
+
+template <typename Bezier, typename... Args>
+void
+bezier_containers(std::string_view name, std::size_t count, Args && ... args)
+{
+  std::vector<Bezier> beziers;
+  beziers.reserve(count);
+
+  measure(std::string(name) + " construct", count, [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      beziers.emplace_back(cubic_ctrls.cbegin(), cubic_ctrls.cend(), args...);
+    }
+    return static_cast<double>(beziers.size());
+  });
+
+  measure(std::string(name) + " evaluate_at", count, [&] {
+    double sum{};
+    for (auto const & bezier : beziers) {
+      sum += geo::evaluate_at(bezier, 0.5).x;
+    }
+    return sum;
+  });
+}
+
+/* deterministic uniform numbers in [0, 1) */
+struct UniformRandom
+{
+  double
+  operator()() noexcept
+  {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<double>(state >> 11) * 0x1p-53;
+  }
+
+  std::uint64_t state{1};
+};
+
+/* uniform points in the unit square or cube, from 10^3 up to max_points */
+template <typename Point>
+void
+convex_hulls(std::string_view name, std::size_t max_points)
+{
+  /* vertices in 2D, triangles in 3D */
+  using Boundary = std::conditional_t<geo::traits::dimension_v<Point> == 2, Point, std::array<Point, 3>>;
+
+  UniformRandom random;
+  for (std::size_t size = 1000; size <= max_points; size *= 10) {
+    std::vector<Point> points(size);
+    for (auto & point : points) {
+      if constexpr (geo::traits::dimension_v<Point> == 2) {
+        point = Point(random(), random());
+      } else {
+        point = Point(random(), random(), random());
+      }
+    }
+
+    auto const label = std::string(name) + " 10^" + std::to_string(std::lround(std::log10(static_cast<double>(size))));
+    measure(label + " seq", size, [&] {
+      std::vector<Boundary> hull;
+      geo::convex_hull(geo::execution::seq, points, std::back_inserter(hull));
+      return static_cast<double>(hull.size());
+    });
+    measure(label + " par", size, [&] {
+      std::vector<Boundary> hull;
+      geo::convex_hull(geo::execution::par, points, std::back_inserter(hull));
+      return static_cast<double>(hull.size());
+    });
+  }
+}
+
+struct CountingSink
+{
+  template <typename Geometry>
+  void
+  operator()(Geometry const &) noexcept
+  {
+    ++count;
+  }
+
+  std::size_t count{};
+};
+
+/* parses text fed in chunks of the size used by the stream drivers */
+template <typename Parser>
+void
+parse_text(std::string_view name, std::string const & text)
+{
+  throughput(name, text.size(), [&] {
+    CountingSink counter;
+    Parser parser(counter);
+    for (std::size_t i = 0; i < text.size(); i += geo::io::parse_chunk_size) {
+      parser.feed(std::string_view(text).substr(i, geo::io::parse_chunk_size));
+    }
+    parser.finish();
+    return static_cast<double>(counter.count);
+  });
+}
+
+} // namespace
+
+/* usage: geometry_benchmarks [largest convex hull input, default 10^8] */
+int main(int argc, char ** argv)
+{
+  constexpr std::size_t count = 1'000'000;
+  std::size_t const max_hull_points = argc > 1 ? std::stoull(argv[1]) : 100'000'000;
+
+  bezier_containers<geo::Bezier<3, geo::Vector3d>>("Bezier<std::vector>", count);
+  bezier_containers<geo::InlineBezier<3, geo::Vector3d>>("Bezier<InlineVector>", count);
+  {
+    std::pmr::monotonic_buffer_resource arena(count * sizeof(cubic_ctrls));
+    bezier_containers<geo::pmr::Bezier<3, geo::Vector3d>>(
+      "Bezier<std::pmr::vector> (arena)", count,
+      std::pmr::polymorphic_allocator<geo::Vector3d>(&arena));
+  }
+
+  {
+    std::vector<geo::Bezier<3, geo::Vector3d>> beziers;
+    beziers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      auto const offset = geo::Vector3d(static_cast<double>(i % 4096), static_cast<double>(i / 4096), 0.0);
+      std::array<geo::Vector3d, 4> ctrls;
+      std::ranges::transform(cubic_ctrls, ctrls.begin(), [&](auto const & ctrl) { return ctrl + offset; });
+      beziers.emplace_back(ctrls.cbegin(), ctrls.cend());
+    }
+
+    geo::BezierBatch<3, double, 3> const batch(beziers);
+    geo::CompressedBezierBatch<3, double, 3> const compressed16(beziers);
+    geo::CompressedBezierBatch<3, double, 3, std::uint32_t> const compressed32(beziers);
+    std::printf("%-48s %12zu bytes/curve\n", "BezierBatch", sizeof(cubic_ctrls));
+    std::printf("%-48s %12.2f bytes/curve\n", "CompressedBezierBatch<uint16_t>",
+                static_cast<double>(compressed16.bytes()) / static_cast<double>(count));
+    std::printf("%-48s %12.2f bytes/curve\n", "CompressedBezierBatch<uint32_t>",
+                static_cast<double>(compressed32.bytes()) / static_cast<double>(count));
+
+    std::array<std::vector<double>, 3> components;
+    for (auto & component : components) {
+      component.resize(count);
+    }
+    std::array<std::span<double>, 3> const out{components[0], components[1], components[2]};
+    measure("BezierBatch evaluate_at", count, [&] {
+      geo::evaluate_at(batch, 0.5, out);
+      return components[0][count - 1];
+    });
+    measure("CompressedBezierBatch<uint16_t> evaluate_at", count, [&] {
+      geo::evaluate_at(compressed16, 0.5, out);
+      return components[0][count - 1];
+    });
+
+    /* sample -> transform -> bounds, through buffers and lazily */
+    constexpr std::size_t samples = 8;
+    auto const xf = geo::Affine3d::translation(geo::Vector3d(1.0, 2.0, 3.0));
+    measure("sample/transform/bounds (buffers)", count * samples, [&] {
+      std::vector<geo::Vector3d> points;
+      for (auto const & bezier : beziers) {
+        for (std::size_t i = 0; i < samples; ++i) {
+          points.push_back(geo::evaluate_at(bezier, static_cast<double>(i) / (samples - 1)));
+        }
+      }
+      std::vector<geo::Vector3d> moved;
+      geo::transform(xf, points, std::back_inserter(moved));
+      double max_x = -1e300;
+      for (auto const & p : moved) {
+        max_x = std::max(max_x, p.x);
+      }
+      return max_x;
+    });
+    measure("sample/transform/bounds (views)", count * samples, [&] {
+      double max_x = -1e300;
+      for (auto const & p : beziers | geo::views::sample(samples) | geo::views::transform_points(xf)) {
+        max_x = std::max(max_x, p.x);
+      }
+      return max_x;
+    });
+  }
+
+  {
+    /* SVG-like path segments: lines, quadratics and cubics in one batch */
+    using Segment = std::variant<geo::Line<geo::Vector2d>, geo::InlineBezier<2, geo::Vector2d>, geo::InlineBezier<3, geo::Vector2d>>;
+    UniformRandom random;
+    std::vector<Segment> path;
+    std::vector<geo::InlineBezier<5, geo::Vector2d>> quintics;
+    path.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      std::array<geo::Vector2d, 6> ctrls;
+      for (auto & ctrl : ctrls) {
+        ctrl = geo::Vector2d(random(), random());
+      }
+      if (i % 3 == 0) {
+        path.emplace_back(geo::Line<geo::Vector2d>(ctrls[0], ctrls[1]));
+      } else if (i % 3 == 1) {
+        path.emplace_back(geo::InlineBezier<2, geo::Vector2d>(ctrls.cbegin(), ctrls.cbegin() + 3));
+      } else {
+        path.emplace_back(geo::InlineBezier<3, geo::Vector2d>(ctrls.cbegin(), ctrls.cbegin() + 4));
+      }
+      quintics.emplace_back(ctrls.cbegin(), ctrls.cend());
+    }
+    measure("normalize_degree mixed path to cubics", count, [&] {
+      geo::BezierBatch<3, double, 2> batch;
+      static_cast<void>(geo::normalize_degree(path, batch));
+      return batch.lane(1, 0)[count - 1];
+    });
+    measure("reduce<3> quintic", count, [&] {
+      double error = 0.0;
+      for (auto const & quintic : quintics) {
+        error = std::max(error, geo::reduce<3>(quintic).error);
+      }
+      return error;
+    });
+  }
+
+  {
+    /* a point cloud rotated per frame by an orientation, AoS, SoA and
+     * through the equivalent Affine, and slerped keyframes of many objects */
+    using geo::Quaterniond;
+    UniformRandom random;
+    std::vector<geo::Vector3d> cloud(count);
+    std::array<std::vector<double>, 3> soa;
+    for (auto & p : cloud) {
+      p = geo::Vector3d(random(), random(), random());
+      soa[0].push_back(p.x);
+      soa[1].push_back(p.y);
+      soa[2].push_back(p.z);
+    }
+    auto const q = Quaterniond::rotation(geo::Vector3d(1.0, 2.0, 3.0), 0.3);
+    std::vector<geo::Vector3d> rotated(count);
+    measure("transform Affine3d AoS", count, [&] {
+      geo::transform(q.to_matrix(), cloud, rotated.begin());
+      return rotated.back().x;
+    });
+    measure("rotate quaternion AoS", count, [&] {
+      geo::rotate(q, cloud, rotated.begin());
+      return rotated.back().x;
+    });
+    measure("rotate quaternion AoS (parallel)", count, [&] {
+      geo::rotate(geo::execution::par, q, cloud, rotated.begin());
+      return rotated.back().x;
+    });
+    std::array<std::vector<double>, 3> out{std::vector<double>(count), std::vector<double>(count), std::vector<double>(count)};
+    measure("rotate quaternion SoA", count, [&] {
+      geo::rotate(q, {std::span<double const>(soa[0]), std::span<double const>(soa[1]), std::span<double const>(soa[2])},
+                  {std::span<double>(out[0]), std::span<double>(out[1]), std::span<double>(out[2])});
+      return out[0].back();
+    });
+
+    std::vector<Quaterniond> from, to, frames(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      from.push_back(Quaterniond::rotation(geo::Vector3d(random(), random(), random() + 0.1), 6.0 * random()));
+      to.push_back(Quaterniond::rotation(geo::Vector3d(random(), random(), random() + 0.1), 6.0 * random()));
+    }
+    measure("slerp keyframes", count, [&] {
+      geo::slerp(from, to, 0.4, frames.begin());
+      return frames.back().w;
+    });
+    measure("nlerp keyframes", count, [&] {
+      for (std::size_t i = 0; i < count; ++i) {
+        frames[i] = geo::nlerp(from[i], to[i], 0.4);
+      }
+      return frames.back().w;
+    });
+  }
+
+  {
+    /* enclosures of a cubic over parameter intervals, as for culling */
+    using Exact = geo::Interval<double>;
+    using Fast = geo::Interval<double, geo::policy::fast>;
+    auto const enclosing = [](auto interval) {
+      using Point = geo::Vector2x<decltype(interval)>;
+      geo::Bezier<3, Point, std::array<Point, 4>> retval;
+      for (std::size_t i = 0; i < 4; ++i) {
+        retval.ctrls[i] = Point(cubic_ctrls[i].x, cubic_ctrls[i].y);
+      }
+      return retval;
+    };
+    auto const exact = enclosing(Exact{});
+    auto const fast = enclosing(Fast{});
+    std::vector<double> parameters(count);
+    UniformRandom random;
+    for (auto & t : parameters) {
+      t = random() * 0.99;
+    }
+    measure("evaluate_at cubic interval exact", count, [&] {
+      double sum = 0.0;
+      for (double const t : parameters) {
+        sum += geo::evaluate_at(exact, Exact(t, t + 0.01)).x.width();
+      }
+      return sum;
+    });
+    measure("evaluate_at cubic interval fast", count, [&] {
+      double sum = 0.0;
+      for (double const t : parameters) {
+        sum += geo::evaluate_at(fast, Fast(t, t + 0.01)).x.width();
+      }
+      return sum;
+    });
+  }
+
+  {
+    /* a fan of rays from a camera into a 2D scene, neighbouring rays are
+     * cast together as packets of 16 */
+    using Ray = geo::Ray<geo::Vector2d>;
+    using Cubic = geo::Bezier<3, geo::Vector2d, std::array<geo::Vector2d, 4>>;
+    UniformRandom random;
+    geo::DynamicBvh<geo::Circle<geo::Vector2d>> bvh;
+    for (std::size_t i = 0; i < 4096; ++i) {
+      bvh.insert(geo::Circle<geo::Vector2d>(geo::Vector2d(random() * 100.0, random() * 100.0), 0.2 + 0.5 * random()));
+    }
+    std::vector<Cubic> cubics;
+    for (std::size_t i = 0; i < 16; ++i) {
+      geo::Vector2d const corner(random() * 90.0, random() * 90.0);
+      cubics.emplace_back(std::array{corner, corner + geo::Vector2d(10.0 * random(), 10.0 * random()),
+                                     corner + geo::Vector2d(10.0 * random(), 10.0 * random()), corner + geo::Vector2d(10.0, 10.0)});
+    }
+    std::size_t const rays_count = count - count % 16;
+    std::vector<Ray> rays;
+    for (std::size_t i = 0; i < rays_count; ++i) {
+      double const angle = (static_cast<double>(i) / static_cast<double>(rays_count) - 0.5) * 1.2;
+      rays.emplace_back(geo::Vector2d(-10.0, 50.0), geo::Vector2d(std::cos(angle), std::sin(angle)));
+    }
+    std::vector<geo::RayPacket<geo::Vector2d, 16>> packets(rays_count / 16);
+    for (std::size_t i = 0; i < rays_count; ++i) {
+      packets[i / 16].push_back(rays[i]);
+    }
+    geo::BezierPacket<Cubic, 16> cubic_packet;
+    for (auto const & cubic : cubics) {
+      cubic_packet.push_back(cubic);
+    }
+
+    measure("raycast DynamicBvh circles scalar", rays_count, [&] {
+      double sum = 0.0;
+      for (auto const & ray : rays) {
+        sum += std::min(geo::raycast(bvh, ray).t, 1000.0);
+      }
+      return sum;
+    });
+    measure("raycast DynamicBvh circles packets of 16", rays_count, [&] {
+      double sum = 0.0;
+      for (auto const & packet : packets) {
+        for (auto const & hit : geo::raycast(bvh, packet)) {
+          sum += std::min(hit.t, 1000.0);
+        }
+      }
+      return sum;
+    });
+
+    measure("raycast cubic scalar", rays_count, [&] {
+      double sum = 0.0;
+      for (auto const & ray : rays) {
+        sum += geo::raycast(ray, cubics[3]).value_or(0.0);
+      }
+      return sum;
+    });
+    measure("raycast cubic packets of 16 rays", rays_count, [&] {
+      double sum = 0.0;
+      for (auto const & packet : packets) {
+        for (double const t : geo::raycast(packet, cubics[3])) {
+          sum += std::isinf(t) ? 0.0 : t;
+        }
+      }
+      return sum;
+    });
+
+    measure("raycast 16 cubics scalar", rays_count, [&] {
+      double sum = 0.0;
+      for (auto const & ray : rays) {
+        for (auto const & cubic : cubics) {
+          sum += geo::raycast(ray, cubic).value_or(0.0);
+        }
+      }
+      return sum;
+    });
+    measure("raycast 16 cubics packet", rays_count, [&] {
+      double sum = 0.0;
+      for (auto const & ray : rays) {
+        for (double const t : geo::raycast(ray, cubic_packet)) {
+          sum += std::isinf(t) ? 0.0 : t;
+        }
+      }
+      return sum;
+    });
+  }
+
+  {
+    /* packed 3 lane against padded 4 lane points */
+    std::vector<geo::Vector3d> packed(count);
+    std::vector<geo::PaddedVector3d> padded(count);
+    UniformRandom random;
+    for (std::size_t i = 0; i < count; ++i) {
+      packed[i] = geo::Vector3d(random(), random(), random());
+      padded[i] = geo::PaddedVector3d(packed[i].x, packed[i].y, packed[i].z);
+    }
+    auto const squared_distances = [](auto const & points) {
+      double sum = 0.0;
+      for (std::size_t i = 1; i < points.size(); ++i) {
+        auto const d = points[i] - points[i - 1] * 0.5;
+        sum += geo::dot_product(d, d);
+      }
+      return sum;
+    };
+    measure("Vector3d sub/scale/dot", count, [&] { return squared_distances(packed); });
+    measure("PaddedVector3d sub/scale/dot", count, [&] { return squared_distances(padded); });
+  }
+
+  {
+    /* sparse short random segments, a few thousand crossings in total */
+    std::vector<geo::Line<geo::Vector2d>> lines;
+    lines.reserve(count);
+    UniformRandom random;
+    for (std::size_t i = 0; i < count; ++i) {
+      geo::Vector2d const start(random() * 10000.0, random() * 10000.0);
+      lines.emplace_back(start, start + geo::Vector2d(random() - 0.5, random() - 0.5));
+    }
+
+    measure("intersections sweep", count, [&] {
+      std::size_t pairs = 0;
+      geo::intersections(lines, [&](std::size_t, std::size_t) { ++pairs; });
+      return static_cast<double>(pairs);
+    });
+    measure("intersections grid (parallel)", count, [&] {
+      std::atomic<std::size_t> pairs = 0;
+      geo::intersections(geo::execution::par, lines, [&](std::size_t, std::size_t) {
+        pairs.fetch_add(1, std::memory_order_relaxed);
+      });
+      return static_cast<double>(pairs.load());
+    });
+  }
+
+  convex_hulls<geo::Vector2d>("convex_hull 2D", max_hull_points);
+  convex_hulls<geo::Vector3d>("convex_hull 3D", max_hull_points);
+
+  {
+    std::vector<geo::Vector2d> points(count);
+    UniformRandom random;
+    for (auto & point : points) {
+      point = geo::Vector2d(random(), random());
+    }
+    measure("Delaunay", count, [&] {
+      geo::Delaunay const mesh(points);
+      return static_cast<double>(mesh.triangle_count());
+    });
+    geo::Delaunay const mesh(points);
+    measure("Delaunay voronoi", count, [&] {
+      auto const voronoi = mesh.voronoi();
+      return static_cast<double>(voronoi.cell(0).size());
+    });
+
+    measure("spatial_order hilbert", count, [&] {
+      return static_cast<double>(geo::spatial_order(points)[0]);
+    });
+    measure("spatial_order morton", count, [&] {
+      return static_cast<double>(geo::spatial_order(points, geo::space_filling_curve::morton)[0]);
+    });
+    measure("spatial_order hilbert (parallel)", count, [&] {
+      return static_cast<double>(geo::spatial_order(geo::execution::par, points)[0]);
+    });
+  }
+
+  {
+    /* a frame of a moving scene: small jitter, then drift out of the fat boxes */
+    std::size_t const circles = count / 10;
+    UniformRandom random;
+    std::vector<geo::Circle<geo::Vector2d>> scene;
+    for (std::size_t i = 0; i < circles; ++i) {
+      scene.emplace_back(geo::Vector2d(random(), random()), 0.001 * random());
+    }
+    geo::DynamicBvh<geo::Circle<geo::Vector2d>> bvh(0.001);
+    measure("DynamicBvh insert", circles, [&] {
+      for (auto const & circle : scene) {
+        static_cast<void>(bvh.insert(circle));
+      }
+      return static_cast<double>(bvh.height());
+    });
+    auto const move_all = [&](double step) {
+      for (std::size_t h = 0; h < circles; ++h) {
+        bvh[h].center = bvh[h].center + geo::Vector2d(step * (random() - 0.5), step * (random() - 0.5));
+      }
+    };
+    move_all(0.001);
+    measure("DynamicBvh refit (within margin)", circles, [&] { return static_cast<double>(bvh.refit()); });
+    move_all(0.003);
+    measure("DynamicBvh refit", circles, [&] { return static_cast<double>(bvh.refit()); });
+    move_all(0.003);
+    measure("DynamicBvh refit (parallel)", circles, [&] { return static_cast<double>(bvh.refit(geo::execution::par)); });
+    geo::DynamicBvh<geo::Circle<geo::Vector2d>> rebuilt(0.001);
+    measure("DynamicBvh rebuild", circles, [&] {
+      for (std::size_t h = 0; h < circles; ++h) {
+        static_cast<void>(rebuilt.insert(bvh[h]));
+      }
+      return static_cast<double>(rebuilt.height());
+    });
+    auto const queries = [&](auto const & tree) {
+      std::size_t hits = 0;
+      for (std::size_t h = 0; h < circles; ++h) {
+        tree.query(tree.fat_box(h), [&](std::size_t) { ++hits; });
+      }
+      return static_cast<double>(hits);
+    };
+    measure("DynamicBvh query (refit)", circles, [&] { return queries(bvh); });
+    measure("DynamicBvh query (rebuilt)", circles, [&] { return queries(rebuilt); });
+  }
+
+  {
+    /* a scan: a wavy surface sampled at random */
+    UniformRandom random;
+    std::vector<geo::Vector3d> scan;
+    scan.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      double const x = random(), y = random();
+      scan.emplace_back(x, y, 0.1 * std::sin(6.0 * x) * std::cos(4.0 * y) + 1e-4 * random());
+    }
+    std::vector<geo::Vector3d> out;
+    out.reserve(count);
+    auto const written = [&] {
+      auto const size = static_cast<double>(out.size());
+      out.clear();
+      return size;
+    };
+    measure("voxel_downsample", count, [&] {
+      geo::voxel_downsample(scan, 0.0025, std::back_inserter(out));
+      return written();
+    });
+    measure("voxel_downsample (parallel)", count, [&] {
+      geo::voxel_downsample(geo::execution::par, scan, 0.0025, std::back_inserter(out));
+      return written();
+    });
+    measure("weld", count, [&] {
+      auto const remap = geo::weld(scan, 1e-4, std::back_inserter(out));
+      return written() + static_cast<double>(remap.back());
+    });
+    measure("estimate_normals (k = 12)", count, [&] {
+      geo::estimate_normals(scan, 12, std::back_inserter(out));
+      return written();
+    });
+    measure("estimate_normals (k = 12, parallel)", count, [&] {
+      geo::estimate_normals(geo::execution::par, scan, 12, std::back_inserter(out));
+      return written();
+    });
+  }
+
+  {
+    /* many small clusters: scan segments of 16 points along arcs */
+    UniformRandom random;
+    std::vector<geo::Vector2d> points;
+    std::vector<std::size_t> offsets{0};
+    while (points.size() < count) {
+      double const x = random(), y = random(), radius = 0.01 + 0.01 * random(), start = 6.0 * random();
+      for (std::size_t i = 0; i < 16; ++i) {
+        double const angle = start + 0.1 * static_cast<double>(i);
+        points.emplace_back(x + radius * std::cos(angle) + 1e-4 * random(), y + radius * std::sin(angle) + 1e-4 * random());
+      }
+      offsets.push_back(points.size());
+    }
+    std::vector<geo::Circle<geo::Vector2d>> circles;
+    circles.reserve(offsets.size());
+    auto const total_radius = [&] {
+      double sum = 0.0;
+      for (auto const & circle : circles) {
+        sum += circle.radius;
+      }
+      circles.clear();
+      return sum;
+    };
+    measure("min_enclosing_circle (clusters of 16)", points.size(), [&] {
+      geo::min_enclosing_circle(points, offsets, std::back_inserter(circles));
+      return total_radius();
+    });
+    measure("min_enclosing_circle (clusters, parallel)", points.size(), [&] {
+      geo::min_enclosing_circle(geo::execution::par, points, offsets, std::back_inserter(circles));
+      return total_radius();
+    });
+    measure("fit_circle pratt (clusters of 16)", points.size(), [&] {
+      geo::fit_circle(points, offsets, std::back_inserter(circles));
+      return total_radius();
+    });
+    measure("fit_circle kasa (clusters of 16)", points.size(), [&] {
+      geo::fit_circle(points, offsets, std::back_inserter(circles), geo::circle_fit_method::kasa);
+      return total_radius();
+    });
+    measure("fit_circle pratt (clusters, parallel)", points.size(), [&] {
+      geo::fit_circle(geo::execution::par, points, offsets, std::back_inserter(circles));
+      return total_radius();
+    });
+  }
+
+  {
+    /* a GPS-like track: a slowly wandering heading, unit steps, small noise;
+     * the compression ratio is the number of points per fitted curve */
+    UniformRandom random;
+    std::vector<geo::Vector2d> track;
+    double heading = 0.0, turn = 0.0;
+    geo::Vector2d position(0.0, 0.0);
+    for (std::size_t i = 0; i < count; ++i) {
+      turn = 0.95 * turn + 0.02 * (random() - 0.5);
+      heading += turn;
+      position = position + geo::Vector2d(std::cos(heading), std::sin(heading));
+      track.push_back(position + geo::Vector2d(0.05 * (random() - 0.5), 0.05 * (random() - 0.5)));
+    }
+    std::vector<std::size_t> offsets;
+    for (std::size_t first = 0; first < count; first += 1000) {
+      offsets.push_back(first);
+    }
+    offsets.push_back(count);
+
+    std::vector<geo::Bezier<3, geo::Vector2d>> cubics;
+    std::vector<geo::Bezier<5, geo::Vector2d>> quintics;
+    measure("fit_beziers cubic", count, [&] {
+      geo::fit_beziers(track, 0.2, std::back_inserter(cubics));
+      return static_cast<double>(cubics.size());
+    });
+    std::printf("%-48s %12.2f points/curve\n", "fit_beziers cubic", static_cast<double>(count) / static_cast<double>(cubics.size()));
+    measure("fit_beziers quintic", count, [&] {
+      geo::fit_beziers<5>(track, 0.2, std::back_inserter(quintics));
+      return static_cast<double>(quintics.size());
+    });
+    std::printf("%-48s %12.2f points/curve\n", "fit_beziers quintic", static_cast<double>(count) / static_cast<double>(quintics.size()));
+    cubics.clear();
+    measure("fit_beziers cubic (tracks of 1000)", count, [&] {
+      geo::fit_beziers(track, offsets, 0.2, std::back_inserter(cubics));
+      return static_cast<double>(cubics.size());
+    });
+    cubics.clear();
+    measure("fit_beziers cubic (tracks, parallel)", count, [&] {
+      geo::fit_beziers(geo::execution::par, track, offsets, 0.2, std::back_inserter(cubics));
+      return static_cast<double>(cubics.size());
+    });
+  }
+
+  {
+    /* coherent motion: the first update sorts from scratch, the frames after
+     * it only repair the order */
+    std::size_t const circles = count / 10;
+    UniformRandom random;
+    std::vector<geo::Circle<geo::Vector2d>> scene;
+    for (std::size_t i = 0; i < circles; ++i) {
+      scene.emplace_back(geo::Vector2d(random(), random()), 0.001 * random());
+    }
+    auto const frames = [&](std::string const & name, auto broadphase, auto policy) {
+      std::size_t events = 0;
+      auto const on_event = [&](std::size_t, std::size_t) { ++events; };
+      for (auto const & circle : scene) {
+        static_cast<void>(broadphase.insert(circle));
+      }
+      measure(name + " first update", circles, [&] {
+        broadphase.update(policy, on_event, on_event);
+        return static_cast<double>(broadphase.pair_count());
+      });
+      measure(name + " frame", circles * 4, [&] {
+        for (std::size_t frame = 0; frame < 4; ++frame) {
+          for (std::size_t h = 0; h < circles; ++h) {
+            broadphase[h].center = broadphase[h].center + geo::Vector2d(0.0005 * (random() - 0.5), 0.0005 * (random() - 0.5));
+          }
+          broadphase.update(policy, on_event, on_event);
+        }
+        return static_cast<double>(events);
+      });
+    };
+    frames("SweepAndPrune", geo::SweepAndPrune<geo::Circle<geo::Vector2d>>(), geo::execution::seq);
+    frames("SweepAndPrune (parallel)", geo::SweepAndPrune<geo::Circle<geo::Vector2d>>(), geo::execution::par);
+    frames("MultiAxisSweepAndPrune", geo::MultiAxisSweepAndPrune<geo::Circle<geo::Vector2d>>(), geo::execution::seq);
+    frames("MultiAxisSweepAndPrune (parallel)", geo::MultiAxisSweepAndPrune<geo::Circle<geo::Vector2d>>(), geo::execution::par);
+  }
+
+  {
+    std::string svg = "M0.5,0.5";
+    std::string wkt = "MULTILINESTRING ((0.5 0.5";
+    for (std::size_t i = 0; svg.size() < (std::size_t{1} << 26); ++i) {
+      auto const x = std::to_string(static_cast<double>(i % 1000) * 0.125);
+      auto const y = std::to_string(static_cast<double>(i % 777) * 0.375);
+      svg += " C" + x + "," + y + " " + y + "," + x + " " + x + "," + x + " L" + y + "," + y;
+      wkt += ", " + x + " " + y;
+    }
+    wkt += "))";
+    parse_text<geo::io::SvgPathParser<geo::Vector2d, CountingSink &>>("parse SVG path", svg);
+    parse_text<geo::io::WktParser<geo::Vector2d, CountingSink &>>("parse WKT", wkt);
+  }
+
+  return 0;
+}
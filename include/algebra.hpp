@@ -1,7 +1,14 @@
 #ifndef GEO_ALGEBRA_HPP
 #define GEO_ALGEBRA_HPP
 
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <stdexcept>
+
 #include "detail/detail_algebra.hpp"
+#include "detail/detail_stats.hpp"
+#include "fast_math.hpp"
 #include "math.hpp"
 #include "point.hpp"
 
@@ -70,10 +77,103 @@ operator/(Point const & point, Scalar scalar) noexcept(std::floating_point<Scala
   }(std::make_index_sequence<traits::dimension_v<Point>>{});
 }
 
+/* VectorNx overloads loop over all lanes of the aligned storage, padding
+ * included, which compilers turn into full width vector instructions. The
+ * padding lanes stay zero, so they do not change any result. */
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+[[nodiscard]] constexpr VectorNx<T, N, Align>
+operator-(VectorNx<T, N, Align> const & lhs, VectorNx<T, N, Align> const & rhs) noexcept
+{
+  VectorNx<T, N, Align> retval;
+  for (std::size_t i = 0; i < retval.lanes; ++i) {
+    retval.data[i] = lhs.data[i] - rhs.data[i];
+  }
+  return retval;
+}
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+[[nodiscard]] constexpr VectorNx<T, N, Align>
+operator+(VectorNx<T, N, Align> const & lhs, VectorNx<T, N, Align> const & rhs) noexcept
+{
+  VectorNx<T, N, Align> retval;
+  for (std::size_t i = 0; i < retval.lanes; ++i) {
+    retval.data[i] = lhs.data[i] + rhs.data[i];
+  }
+  return retval;
+}
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+[[nodiscard]] constexpr VectorNx<T, N, Align>
+operator*(VectorNx<T, N, Align> const & point, T scalar) noexcept
+{
+  VectorNx<T, N, Align> retval;
+  for (std::size_t i = 0; i < retval.lanes; ++i) {
+    retval.data[i] = point.data[i] * scalar;
+  }
+  return retval;
+}
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+[[nodiscard]] constexpr VectorNx<T, N, Align>
+operator*(T scalar, VectorNx<T, N, Align> const & point) noexcept
+{
+  return point * scalar;
+}
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+[[nodiscard]] constexpr VectorNx<T, N, Align>
+operator/(VectorNx<T, N, Align> const & point, T scalar) noexcept(std::floating_point<T>)
+{
+  if constexpr (std::integral<T>) {
+    if (scalar == T{}) {
+      throw std::runtime_error("division by zero");
+    }
+  }
+  VectorNx<T, N, Align> retval;
+  for (std::size_t i = 0; i < retval.lanes; ++i) {
+    retval.data[i] = point.data[i] / scalar;
+  }
+  /* 0 / 0 */
+  for (std::size_t i = N; i < retval.lanes; ++i) {
+    retval.data[i] = T{};
+  }
+  return retval;
+}
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+[[nodiscard]] constexpr T
+dot_product(VectorNx<T, N, Align> const & lhs, VectorNx<T, N, Align> const & rhs) noexcept
+{
+  GEO_STATS_SCOPE(dot_product);
+  std::array<T, VectorNx<T, N, Align>::lanes> products{};
+  for (std::size_t i = 0; i < products.size(); ++i) {
+    products[i] = lhs.data[i] * rhs.data[i];
+  }
+  /* same order as the generic fold, padding lanes left out */
+  T retval = products[0];
+  for (std::size_t i = 1; i < N; ++i) {
+    retval += products[i];
+  }
+  return retval;
+}
+
+template <concepts::arithmetic T, std::size_t Align>
+[[nodiscard]] constexpr VectorNx<T, 3, Align>
+vector_product(VectorNx<T, 3, Align> const & lhs, VectorNx<T, 3, Align> const & rhs) noexcept
+{
+  GEO_STATS_SCOPE(vector_product);
+  VectorNx<T, 3, Align> retval;
+  retval.data[0] = lhs.data[1] * rhs.data[2] - lhs.data[2] * rhs.data[1];
+  retval.data[1] = lhs.data[2] * rhs.data[0] - lhs.data[0] * rhs.data[2];
+  retval.data[2] = lhs.data[0] * rhs.data[1] - lhs.data[1] * rhs.data[0];
+  return retval;
+}
+
 template <concepts::point Point>
 [[nodiscard]] constexpr traits::value_type_t<Point>
 dot_product(Point const & lhs, Point const & rhs) noexcept
 {
+  GEO_STATS_SCOPE(dot_product);
   return [&]<std::size_t... Is>(std::index_sequence<Is...>)
   {
     return (... + (get<Is>(lhs) * get<Is>(rhs)));
@@ -83,14 +183,50 @@ dot_product(Point const & lhs, Point const & rhs) noexcept
 [[nodiscard]] constexpr auto
 norm(concepts::point auto const & point)
 {
+  GEO_STATS_SCOPE(norm);
   return sqrt(dot_product(point, point));
 }
 
+template <concepts::point Point, concepts::math_policy Policy>
+requires std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr traits::value_type_t<Point>
+norm(Point const & point, Policy policy) noexcept
+{
+  GEO_STATS_SCOPE(norm);
+  return sqrt(dot_product(point, point), policy);
+}
+
+template <concepts::point Point, concepts::math_policy Policy = policy::exact>
+requires std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr Point
+normalize(Point const & point, Policy policy = {}) noexcept
+{
+  GEO_STATS_SCOPE(normalize);
+  return point * rsqrt(dot_product(point, point), policy);
+}
+
+template <
+  std::ranges::input_range Range,
+  std::weakly_incrementable Out,
+  concepts::math_policy Policy = policy::exact
+>
+requires concepts::point<std::ranges::range_value_t<Range>>
+constexpr Out
+normalize(Range && points, Out out, Policy policy = {})
+{
+  for (auto const & point : points) {
+    *out = normalize(point, policy);
+    ++out;
+  }
+  return out;
+}
+
 template <concepts::geo_object Geo1, concepts::geo_object Geo2>
 requires concepts::same_value_type<Geo1, Geo2>
 [[nodiscard]] constexpr auto
 distance(Geo1 const & lhs, Geo2 const & rhs) noexcept
 {
+  GEO_STATS_SCOPE(distance);
   return detail::distance_impl(
     lhs, rhs,
     traits::tag_t<Geo1>{}, traits::tag_t<Geo2>{}
@@ -102,17 +238,19 @@ requires concepts::dimension_equals<Point, 3>
 [[nodiscard]] constexpr Point
 vector_product(Point const & lhs, Point const & rhs) noexcept
 {
+  GEO_STATS_SCOPE(vector_product);
   return Point{
     get<1>(lhs) * get<2>(rhs) - get<2>(lhs) * get<1>(rhs),
     get<2>(lhs) * get<0>(rhs) - get<0>(lhs) * get<2>(rhs),
-    get<0>(lhs) * get<1>(rhs) - get<1>(rhs) * get<0>(rhs)
+    get<0>(lhs) * get<1>(rhs) - get<1>(lhs) * get<0>(rhs)
   };
 }
 
 template <concepts::point Point>
-[[nodiscard]] auto
+[[nodiscard]] constexpr auto
 angle(Point const & lhs, Point const & rhs) noexcept (std::floating_point<traits::value_type_t<Point>>)
 {
+  GEO_STATS_SCOPE(angle);
   using value_type = traits::value_type_t<Point>;
 
   auto const norm_product = norm(lhs) * norm(rhs);
@@ -123,7 +261,42 @@ angle(Point const & lhs, Point const & rhs) noexcept (std::floating_point<traits
     }
   }
 
-  return std::acos(dot_product(lhs, rhs) / norm_product);
+  return acos(dot_product(lhs, rhs) / norm_product);
+}
+
+template <concepts::point Point, concepts::math_policy Policy>
+requires std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr traits::value_type_t<Point>
+angle(Point const & lhs, Point const & rhs, Policy policy) noexcept
+{
+  GEO_STATS_SCOPE(angle);
+  using value_type = traits::value_type_t<Point>;
+
+  auto const cosine = dot_product(lhs, rhs)
+    * rsqrt(dot_product(lhs, lhs) * dot_product(rhs, rhs), policy);
+
+  /* clamp rounding noise, acos is undefined outside of [-1, 1] */
+  return acos(std::clamp(cosine, value_type{-1}, value_type{1}), policy);
+}
+
+template <
+  std::ranges::input_range Range1,
+  std::ranges::input_range Range2,
+  std::weakly_incrementable Out,
+  concepts::math_policy Policy = policy::exact
+>
+requires concepts::point<std::ranges::range_value_t<Range1>>
+      && std::same_as<std::ranges::range_value_t<Range1>, std::ranges::range_value_t<Range2>>
+constexpr Out
+angle(Range1 && lhs, Range2 && rhs, Out out, Policy policy = {})
+{
+  auto lhs_it = std::ranges::begin(lhs);
+  auto rhs_it = std::ranges::begin(rhs);
+  for (; lhs_it != std::ranges::end(lhs) && rhs_it != std::ranges::end(rhs); ++lhs_it, ++rhs_it) {
+    *out = angle(*lhs_it, *rhs_it, policy);
+    ++out;
+  }
+  return out;
 }
 
 } // namespace geo
@@ -2,6 +2,7 @@
 #define GEO_ALGORITHM_HPP
 
 #include "detail/detail_algorithm.hpp"
+#include "detail/detail_stats.hpp"
 
 namespace geo {
 
@@ -9,6 +10,7 @@ template <concepts::geo_object Geo>
 [[nodiscard]] constexpr auto
 area(Geo const & geo_object) noexcept
 {
+  GEO_STATS_SCOPE(area);
   return detail::area(geo_object, traits::tag_t<Geo>{});
 }
 
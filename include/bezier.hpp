@@ -1,9 +1,14 @@
 #ifndef GEO_BEZIER_HPP
 #define GEO_BEZIER_HPP
 
+#include <array>
+#include <memory_resource>
+#include <ranges>
 #include <vector>
 
 #include "detail/detail_bezier.hpp"
+#include "detail/detail_stats.hpp"
+#include "inline_vector.hpp"
 #include "point.hpp"
 #include "traits.hpp"
 
@@ -20,7 +25,7 @@ requires concepts::bezier_degree<Degree>
 struct Bezier
 {
   template <concepts::not_an_array U = Cont>
-  Bezier()
+  constexpr Bezier()
       : ctrls({})
   {}
 
@@ -40,7 +45,7 @@ struct Bezier
       && std::is_same_v<std::decay_t<Head>, Bezier>
     >
   >
-  Bezier(Head && head, Tail && ... tail)
+  constexpr Bezier(Head && head, Tail && ... tail)
       : ctrls(std::forward<Head>(head), std::forward<Tail>(tail)...)
   {}
 
@@ -62,6 +67,42 @@ struct Bezier
   Cont ctrls{};
 };
 
+/* non-owning view of Degree + 1 contiguous control points */
+template <std::size_t Degree, concepts::point Point>
+requires concepts::bezier_degree<Degree>
+struct BezierView
+{
+  Point const * ctrls{};
+};
+
+/* allocation free and usable in constant expressions */
+template <std::size_t Degree, concepts::point Point>
+using InlineBezier = Bezier<Degree, Point, InlineVector<Point, Degree + 1>>;
+
+namespace pmr {
+
+/* control points are allocated from a std::pmr::memory_resource, e.g. an
+ * arena passed as last constructor argument */
+template <std::size_t Degree, concepts::point Point>
+using Bezier = geo::Bezier<Degree, Point, std::pmr::vector<Point>>;
+
+} // namespace pmr
+
+/* Bernstein weights of a Bezier of degree Degree on the uniform grid
+ * t_i = i / (N - 1), one row per sample */
+template <std::size_t Degree, std::size_t N, std::floating_point T = double>
+requires concepts::bezier_degree<Degree> && (N > 1)
+struct SampledBasis
+{
+  using value_type = T;
+
+  static constexpr std::size_t degree = Degree;
+  static constexpr std::size_t samples = N;
+
+  static constexpr std::array<std::array<T, Degree + 1>, N> weights
+    = detail::create_sampled_basis<Degree, N, T>();
+};
+
 /***************************** adaptors ********************************/
 
 namespace traits {
@@ -132,17 +173,92 @@ struct access_bezier<Bezier<Degree, Point, Cont>>
   }
 };
 
+template <std::size_t Degree, concepts::point Point>
+struct tag<BezierView<Degree, Point>>
+{
+  using type = bezier_tag;
+};
+
+template <std::size_t Degree, concepts::point Point>
+struct degree<BezierView<Degree, Point>>
+{
+  static constexpr std::size_t value = Degree;
+};
+
+template <std::size_t Degree, concepts::point Point>
+struct const_iter<BezierView<Degree, Point>>
+{
+  using type = Point const *;
+};
+
+template <std::size_t Degree, concepts::point Point>
+struct iter<BezierView<Degree, Point>>
+{
+  using type = Point const *;
+};
+
+template <std::size_t Degree, concepts::point Point>
+struct access_bezier<BezierView<Degree, Point>>
+{
+  [[nodiscard]] static constexpr Point const *
+  cbegin(BezierView<Degree, Point> const & bezier) noexcept
+  {
+    return bezier.ctrls;
+  }
+
+  [[nodiscard]] static constexpr Point const *
+  cecbegin(BezierView<Degree, Point> const & bezier) noexcept
+  {
+    return bezier.ctrls;
+  }
+
+  [[nodiscard]] static constexpr Point const *
+  begin(BezierView<Degree, Point> & bezier) noexcept
+  {
+    return bezier.ctrls;
+  }
+};
+
 } // namespace traits
 
 /***************************** algorithms ********************************/
 
 template <concepts::bezier Bezier>
 [[nodiscard]] constexpr typename std::iterator_traits<traits::const_iter_t<Bezier>>::value_type
-evaluate_at(Bezier const & bezier, std::floating_point auto t) noexcept
+evaluate_at(Bezier const & bezier, concepts::real auto t) noexcept
 {
+  GEO_STATS_SCOPE(evaluate_at);
   return detail::bernstein<Bezier>::evaluate_at(bezier, t);
 }
 
+template <concepts::bezier Bezier, typename Basis, std::weakly_incrementable Out>
+requires (Basis::degree == traits::degree_v<Bezier>)
+      && concepts::value_type_equals<
+           typename std::iterator_traits<traits::const_iter_t<Bezier>>::value_type,
+           typename Basis::value_type>
+constexpr Out
+sample(Bezier const & bezier, Basis, Out out)
+{
+  GEO_STATS_SCOPE(sample);
+  auto const ctrls = detail::copy_ctrls(bezier);
+  for (std::size_t i = 0; i < Basis::samples; ++i) {
+    *out = detail::apply_basis_row<Basis>(ctrls, i);
+    ++out;
+  }
+  return out;
+}
+
+template <std::ranges::input_range Range, typename Basis, std::weakly_incrementable Out>
+requires concepts::bezier<std::ranges::range_value_t<Range>>
+constexpr Out
+sample(Range && beziers, Basis basis, Out out)
+{
+  for (auto const & bezier : beziers) {
+    out = sample(bezier, basis, out);
+  }
+  return out;
+}
+
 } // namespace geo
 
 #endif
@@ -0,0 +1,219 @@
+#ifndef GEO_BEZIER_BATCH_HPP
+#define GEO_BEZIER_BATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "bezier.hpp"
+#include "detail/detail_bezier.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Structure of arrays storage for many Beziers of the same degree. Lane
+ * (i * Dim + k) holds component k of control point i for every curve, so
+ * kernels stream contiguously over curves and vectorize across them. */
+template <std::size_t Degree, std::floating_point T, std::size_t Dim>
+requires concepts::bezier_degree<Degree> && (Dim > 0)
+class BezierBatch
+{
+public:
+  using value_type = T;
+
+  static constexpr std::size_t degree = Degree;
+  static constexpr std::size_t dimension = Dim;
+
+  BezierBatch() = default;
+
+  template <std::ranges::input_range Range>
+  requires concepts::bezier<std::ranges::range_value_t<Range>>
+  explicit BezierBatch(Range && beziers)
+  {
+    if constexpr (std::ranges::sized_range<Range>) {
+      reserve(std::ranges::size(beziers));
+    }
+    for (auto const & bezier : beziers) {
+      push_back(bezier);
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return lanes_[0].size();
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return lanes_[0].empty();
+  }
+
+  void
+  reserve(std::size_t count)
+  {
+    for (auto & lane : lanes_) {
+      lane.reserve(count);
+    }
+  }
+
+  void
+  clear() noexcept
+  {
+    for (auto & lane : lanes_) {
+      lane.clear();
+    }
+  }
+
+  /* Grows every lane before appending to any, so if an allocation throws
+   * the batch is left unchanged and its lanes keep the same size. */
+  template <concepts::bezier Bezier>
+  requires (traits::degree_v<Bezier> == Degree)
+        && concepts::dimension_equals<detail::ctrl_point_t<Bezier>, Dim>
+        && concepts::value_type_equals<detail::ctrl_point_t<Bezier>, T>
+  void
+  push_back(Bezier const & bezier)
+  {
+    auto const ctrls = detail::copy_ctrls(bezier);
+    std::size_t const count = size();
+    for (auto & lane : lanes_) {
+      if (lane.capacity() == count) {
+        lane.reserve(std::max(2 * count, std::size_t{1}));
+      }
+    }
+    for (std::size_t i = 0; i <= Degree; ++i) {
+      [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+        (..., lanes_[i * Dim + Ks].push_back(get<Ks>(ctrls[i])));
+      }(std::make_index_sequence<Dim>{});
+    }
+  }
+
+  [[nodiscard]] std::span<T const>
+  lane(std::size_t index, std::size_t component) const noexcept
+  {
+    return lanes_[index * Dim + component];
+  }
+
+  [[nodiscard]] std::span<T>
+  lane(std::size_t index, std::size_t component) noexcept
+  {
+    return lanes_[index * Dim + component];
+  }
+
+  template <concepts::point Point>
+  requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] Point
+  ctrl(std::size_t curve, std::size_t index) const noexcept
+  {
+    return [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+      Point retval;
+      (..., set<Ks>(retval, lanes_[index * Dim + Ks][curve]));
+      return retval;
+    }(std::make_index_sequence<Dim>{});
+  }
+
+  template <concepts::point Point, concepts::container Cont = std::vector<Point>>
+  requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] Bezier<Degree, Point, Cont>
+  bezier(std::size_t curve) const
+  {
+    std::array<Point, Degree + 1> ctrls;
+    for (std::size_t i = 0; i <= Degree; ++i) {
+      ctrls[i] = ctrl<Point>(curve, i);
+    }
+    if constexpr (concepts::array<Cont>) {
+      return Bezier<Degree, Point, Cont>(ctrls);
+    } else {
+      return Bezier<Degree, Point, Cont>(ctrls.cbegin(), ctrls.cend());
+    }
+  }
+
+private:
+  /* all lanes always hold size() elements, only push_back, reserve and
+   * clear change them */
+  std::array<std::vector<T>, (Degree + 1) * Dim> lanes_{};
+};
+
+/***************************** algorithms ********************************/
+
+/* Evaluates every curve of the batch at t, out[k][j] receives component k of
+ * curve j. Each span must hold at least batch.size() elements. */
+template <std::size_t Degree, std::floating_point T, std::size_t Dim>
+void
+evaluate_at(
+    BezierBatch<Degree, T, Dim> const & batch, T t,
+    std::array<std::span<T>, Dim> const & out) noexcept
+{
+  auto const weights = detail::bernstein_weights<Degree>(t);
+  std::size_t const size = batch.size();
+
+  for (std::size_t k = 0; k < Dim; ++k) {
+    detail::evaluate_lanes<Degree>(
+      weights, [&](std::size_t i) { return batch.lane(i, k).data(); }, size, out[k].data());
+  }
+}
+
+template <
+  concepts::point Point,
+  std::size_t Degree,
+  std::floating_point T,
+  std::size_t Dim,
+  std::weakly_incrementable Out
+>
+requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+Out
+evaluate_at(BezierBatch<Degree, T, Dim> const & batch, T t, Out out)
+{
+  /* the SoA kernel runs over a local tile of curves at a time, so nothing
+   * is allocated */
+  constexpr std::size_t tile = 256;
+  auto const weights = detail::bernstein_weights<Degree>(t);
+  std::size_t const size = batch.size();
+  std::array<std::array<T, tile>, Dim> components;
+
+  for (std::size_t first = 0; first < size; first += tile) {
+    std::size_t const count = std::min(tile, size - first);
+    for (std::size_t k = 0; k < Dim; ++k) {
+      detail::evaluate_lanes<Degree>(
+        weights, [&](std::size_t i) { return batch.lane(i, k).data() + first; }, count,
+        components[k].data());
+    }
+    for (std::size_t j = 0; j < count; ++j) {
+      *out = [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+        Point retval;
+        (..., set<Ks>(retval, components[Ks][j]));
+        return retval;
+      }(std::make_index_sequence<Dim>{});
+      ++out;
+    }
+  }
+  return out;
+}
+
+template <
+  concepts::point Point,
+  concepts::container Cont = std::vector<Point>,
+  std::size_t Degree,
+  std::floating_point T,
+  std::size_t Dim,
+  std::weakly_incrementable Out
+>
+Out
+unpack(BezierBatch<Degree, T, Dim> const & batch, Out out)
+{
+  for (std::size_t j = 0; j < batch.size(); ++j) {
+    *out = batch.template bezier<Point, Cont>(j);
+    ++out;
+  }
+  return out;
+}
+
+} // namespace geo
+
+#endif
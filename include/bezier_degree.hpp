@@ -0,0 +1,99 @@
+#ifndef GEO_BEZIER_DEGREE_HPP
+#define GEO_BEZIER_DEGREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <variant>
+
+#include "bezier.hpp"
+#include "bezier_batch.hpp"
+#include "detail/detail_bezier.hpp"
+#include "detail/detail_bezier_degree.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+/* what normalize_degree accepts: a Bezier, a line, which is a Bezier of
+ * degree 1, or a std::variant of those, as for the segments of a path */
+template <typename Curve>
+concept curve_segment =
+  bezier<Curve>
+  || line<Curve>
+  || detail::is_variant<Curve>::value;
+
+} // namespace concepts
+
+/***************************** model ********************************/
+
+/* a curve reduced in degree and a bound on its distance from the original
+ * at the same parameter, which also bounds the Hausdorff distance */
+template <concepts::bezier Bezier>
+struct Reduction
+{
+  Bezier bezier;
+  traits::value_type_t<detail::ctrl_point_t<Bezier>> error{};
+};
+
+/***************************** algorithms ********************************/
+
+/* The same curve as a Bezier of the higher degree NewDegree, exactly up to
+ * rounding. The matrix taking the control points over is generated at
+ * compile time. The result is stored like the argument; curves adapted
+ * through the traits become InlineBeziers. */
+template <std::size_t NewDegree, concepts::bezier Bezier>
+requires concepts::bezier_degree<NewDegree> && (NewDegree >= traits::degree_v<Bezier>)
+[[nodiscard]] constexpr detail::rebind_degree_t<Bezier, NewDegree>
+elevate(Bezier const & bezier)
+{
+  using T = traits::value_type_t<detail::ctrl_point_t<Bezier>>;
+  return detail::make_bezier<detail::rebind_degree_t<Bezier, NewDegree>>(detail::transform_ctrls(
+    detail::elevation_matrix<traits::degree_v<Bezier>, NewDegree, T>, detail::copy_ctrls(bezier)));
+}
+
+/* The Bezier of the lower degree NewDegree closest to the curve in the L2
+ * norm, with the same end points, and a bound on how far it strays from the
+ * curve: the longest control point of the difference over eight parts of
+ * the curve, which overestimates the largest distance only slightly. All
+ * matrices are generated at compile time, applying
+ * them is a handful of multiply-adds per control point. */
+template <std::size_t NewDegree, concepts::bezier Bezier>
+requires concepts::bezier_degree<NewDegree> && (NewDegree < traits::degree_v<Bezier>)
+[[nodiscard]] Reduction<detail::rebind_degree_t<Bezier, NewDegree>>
+reduce(Bezier const & bezier)
+{
+  using T = traits::value_type_t<detail::ctrl_point_t<Bezier>>;
+  constexpr std::size_t degree = traits::degree_v<Bezier>;
+  auto const ctrls = detail::copy_ctrls(bezier);
+  return {detail::make_bezier<detail::rebind_degree_t<Bezier, NewDegree>>(
+            detail::transform_ctrls(detail::reduction_matrix<degree, NewDegree, T>, ctrls)),
+          detail::reduction_error<degree, NewDegree>(ctrls)};
+}
+
+/* Appends curves of mixed degree to a batch of one degree, elevating lower
+ * degrees and reducing higher ones, so that quadratic and cubic path
+ * segments, say, share the SoA kernels of the batch. The order of the curves
+ * is kept. Returns the largest reduction error bound, zero if every curve
+ * was elevated. */
+template <std::ranges::input_range Range, std::size_t Degree, std::floating_point T, std::size_t Dim>
+requires concepts::curve_segment<std::ranges::range_value_t<Range>>
+T
+normalize_degree(Range && curves, BezierBatch<Degree, T, Dim> & batch)
+{
+  if constexpr (std::ranges::sized_range<Range>) {
+    batch.reserve(batch.size() + std::ranges::size(curves));
+  }
+  T error{};
+  for (auto const & curve : curves) {
+    error = std::max(error, detail::push_normalized(batch, curve));
+  }
+  return error;
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef GEO_BEZIER_FIT_HPP
+#define GEO_BEZIER_FIT_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "bezier.hpp"
+#include "circle_fit.hpp"
+#include "detail/detail_bezier_fit.hpp"
+#include "detail/detail_circle_fit.hpp"
+#include "detail/detail_execution.hpp"
+#include "detail/detail_spatial_sort.hpp"
+#include "execution.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+template <typename Range>
+concept polyline =
+  std::ranges::random_access_range<Range>
+  && std::ranges::sized_range<Range>
+  && point<std::ranges::range_value_t<Range>>
+  && std::floating_point<traits::value_type_t<std::ranges::range_value_t<Range>>>;
+
+} // namespace concepts
+
+namespace detail {
+
+template <std::size_t Degree, typename Range>
+using fitted_bezier_t = Bezier<Degree, std::ranges::range_value_t<Range>>;
+
+template <std::size_t Degree, typename Range>
+using bezier_fitter_t = bezier_fitter<
+  Degree,
+  traits::value_type_t<std::ranges::range_value_t<Range>>,
+  traits::dimension_v<std::ranges::range_value_t<Range>>>;
+
+/* fits points[first, last) and appends the control points of the pieces */
+template <std::size_t Degree, typename Range, typename Coordinates, typename Ctrls>
+void
+fit_polyline(Range const & points, std::size_t first, std::size_t last,
+             traits::value_type_t<std::ranges::range_value_t<Range>> tolerance,
+             bezier_fitter_t<Degree, Range> & fitter, std::vector<Coordinates> & scratch, std::vector<Ctrls> & pieces)
+{
+  scratch.resize(last - first);
+  for (std::size_t i = first; i < last; ++i) {
+    scratch[i - first] = sort_position(std::ranges::begin(points)[static_cast<std::ranges::range_difference_t<Range>>(i)]);
+  }
+  fitter.fit(std::span<Coordinates const>(scratch), tolerance, [&](auto const & ctrls) { pieces.push_back(ctrls); });
+}
+
+template <std::size_t Degree, typename Range, typename Ctrls, typename Out>
+Out
+emit_beziers(std::vector<Ctrls> const & pieces, Out out)
+{
+  using Point = std::ranges::range_value_t<Range>;
+  for (auto const & ctrls : pieces) {
+    std::array<Point, Degree + 1> points{};
+    std::ranges::transform(ctrls, points.begin(), [](auto const & c) { return to_point<Point>(c); });
+    *out = fitted_bezier_t<Degree, Range>(points.cbegin(), points.cend());
+    ++out;
+  }
+  return out;
+}
+
+template <bool Parallel, std::size_t Degree, typename Range, typename Offsets, typename Out>
+std::vector<std::size_t>
+fit_beziers(Range const & points, Offsets const & offsets,
+            traits::value_type_t<std::ranges::range_value_t<Range>> tolerance, Out out)
+{
+  using Fitter = bezier_fitter_t<Degree, Range>;
+  using Coordinates = typename Fitter::coordinates;
+  using Ctrls = typename Fitter::ctrls_type;
+
+  if (tolerance < 0) {
+    throw std::invalid_argument("negative tolerance");
+  }
+  auto const pieces = for_each_cluster<Parallel>(points, offsets, [&](auto begin, auto end, auto &) {
+    Fitter fitter;
+    std::vector<Coordinates> scratch;
+    std::vector<Ctrls> retval;
+    auto const base = std::ranges::begin(points);
+    fit_polyline<Degree>(points, static_cast<std::size_t>(begin - base), static_cast<std::size_t>(end - base),
+                         tolerance, fitter, scratch, retval);
+    return retval;
+  });
+
+  std::vector<std::size_t> curve_offsets{0};
+  curve_offsets.reserve(pieces.size() + 1);
+  for (auto const & polyline : pieces) {
+    out = emit_beziers<Degree, Range>(polyline, out);
+    curve_offsets.push_back(curve_offsets.back() + polyline.size());
+  }
+  return curve_offsets;
+}
+
+} // namespace detail
+
+/***************************** algorithms ********************************/
+
+/* Compresses a dense polyline into G1 continuous Bezier curves of Degree,
+ * cubics by default, that pass within tolerance of every point. Each curve
+ * runs from one polyline point to another; the ends of the polyline are
+ * kept. Follows Schneider's algorithm: least squares fits with Newton
+ * reparameterization, split at the worst point while out of tolerance.
+ * Writes the curves to out in order, none for fewer than two points.
+ * Throws std::invalid_argument for a negative tolerance. */
+template <std::size_t Degree = 3, concepts::polyline Range, std::weakly_incrementable Out>
+requires (Degree >= 3) && concepts::bezier_degree<Degree>
+Out
+fit_beziers(Range const & points, traits::value_type_t<std::ranges::range_value_t<Range>> tolerance, Out out)
+{
+  using Fitter = detail::bezier_fitter_t<Degree, Range>;
+
+  if (tolerance < 0) {
+    throw std::invalid_argument("negative tolerance");
+  }
+  Fitter fitter;
+  std::vector<typename Fitter::coordinates> scratch;
+  std::vector<typename Fitter::ctrls_type> pieces;
+  detail::fit_polyline<Degree>(points, 0, std::ranges::size(points), tolerance, fitter, scratch, pieces);
+  return detail::emit_beziers<Degree, Range>(pieces, out);
+}
+
+/* Fits many polylines stored one after another, delimited by offsets as the
+ * clusters of min_enclosing_circle. Writes the curves of all polylines to
+ * out in order and returns where those of each polyline start in it: the
+ * curves of polyline p are [retval[p], retval[p + 1]). */
+template <std::size_t Degree = 3, concepts::polyline Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+requires (Degree >= 3) && concepts::bezier_degree<Degree>
+std::vector<std::size_t>
+fit_beziers(execution::sequenced_policy, Range const & points, Offsets const & offsets,
+            traits::value_type_t<std::ranges::range_value_t<Range>> tolerance, Out out)
+{
+  return detail::fit_beziers<false, Degree>(points, offsets, tolerance, out);
+}
+
+/* fits the polylines concurrently */
+template <std::size_t Degree = 3, concepts::polyline Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+requires (Degree >= 3) && concepts::bezier_degree<Degree>
+std::vector<std::size_t>
+fit_beziers(execution::parallel_policy, Range const & points, Offsets const & offsets,
+            traits::value_type_t<std::ranges::range_value_t<Range>> tolerance, Out out)
+{
+  return detail::fit_beziers<true, Degree>(points, offsets, tolerance, out);
+}
+
+template <std::size_t Degree = 3, concepts::polyline Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+requires (Degree >= 3) && concepts::bezier_degree<Degree>
+std::vector<std::size_t>
+fit_beziers(Range const & points, Offsets const & offsets,
+            traits::value_type_t<std::ranges::range_value_t<Range>> tolerance, Out out)
+{
+  return fit_beziers<Degree>(execution::seq, points, offsets, tolerance, out);
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef GEO_BOX_HPP
+#define GEO_BOX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "bezier.hpp"
+#include "circle.hpp"
+#include "detail/detail_bezier.hpp"
+#include "line.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Axis-aligned box, closed, lower <= upper in every coordinate. */
+template <concepts::point Point>
+struct Box
+{
+  constexpr Box() = default;
+  constexpr Box(Point const & lower, Point const & upper)
+      : lower(lower), upper(upper)
+  {}
+
+  Point lower{};
+  Point upper{};
+};
+
+/***************************** adaptors ********************************/
+
+namespace traits {
+
+template <concepts::point Point>
+struct tag<Box<Point>>
+{
+  using type = box_tag;
+};
+
+template <concepts::point Point>
+struct point_type<Box<Point>>
+{
+  using type = Point;
+};
+
+template <concepts::point Point>
+struct value_type<Box<Point>>
+{
+  using type = value_type_t<Point>;
+};
+
+} // namespace traits
+
+/***************************** algorithms ********************************/
+
+namespace detail {
+
+/* point whose coordinates are op of those of lhs and rhs */
+template <concepts::point Point, typename Op>
+[[nodiscard]] constexpr Point
+coordinatewise(Point const & lhs, Point const & rhs, Op op) noexcept
+{
+  Point retval = lhs;
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    (set<Is>(retval, op(get<Is>(lhs), get<Is>(rhs))), ...);
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+  return retval;
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr Point
+coordinatewise_min(Point const & lhs, Point const & rhs) noexcept
+{
+  return coordinatewise(lhs, rhs, [](auto a, auto b) { return std::min(a, b); });
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr Point
+coordinatewise_max(Point const & lhs, Point const & rhs) noexcept
+{
+  return coordinatewise(lhs, rhs, [](auto a, auto b) { return std::max(a, b); });
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr Box<Point>
+bounding_box(Point const & point, traits::point_tag) noexcept
+{
+  return {point, point};
+}
+
+template <concepts::line Line>
+[[nodiscard]] constexpr auto
+bounding_box(Line const & line, traits::line_tag) noexcept
+{
+  using Point = std::remove_cvref_t<decltype(line.start)>;
+  return Box<Point>(coordinatewise_min(line.start, line.end), coordinatewise_max(line.start, line.end));
+}
+
+template <concepts::circle Circle>
+[[nodiscard]] constexpr auto
+bounding_box(Circle const & circle, traits::circle_tag) noexcept
+{
+  using Point = traits::point_type_t<Circle>;
+  auto const & center = traits::access_center<Circle>::get(circle);
+  auto const radius = traits::access_radius<Circle>::get(circle);
+  return Box<Point>(coordinatewise(center, center, [radius](auto a, auto) { return a - radius; }),
+                    coordinatewise(center, center, [radius](auto a, auto) { return a + radius; }));
+}
+
+/* the curve lies in the convex hull of its control points */
+template <concepts::bezier Bezier>
+[[nodiscard]] constexpr auto
+bounding_box(Bezier const & bezier, traits::bezier_tag) noexcept
+{
+  auto const ctrls = copy_ctrls(bezier);
+  Box<ctrl_point_t<Bezier>> retval(ctrls[0], ctrls[0]);
+  for (auto const & ctrl : ctrls) {
+    retval.lower = coordinatewise_min(retval.lower, ctrl);
+    retval.upper = coordinatewise_max(retval.upper, ctrl);
+  }
+  return retval;
+}
+
+} // namespace detail
+
+/* smallest box containing the object; for Beziers the box of the control
+ * points, which contains the curve */
+template <concepts::geo_object Geo>
+[[nodiscard]] constexpr auto
+bounding_box(Geo const & geo_object) noexcept
+{
+  return detail::bounding_box(geo_object, traits::tag_t<Geo>{});
+}
+
+/* smallest box containing both */
+template <concepts::point Point>
+[[nodiscard]] constexpr Box<Point>
+merge(Box<Point> const & lhs, Box<Point> const & rhs) noexcept
+{
+  return {detail::coordinatewise_min(lhs.lower, rhs.lower), detail::coordinatewise_max(lhs.upper, rhs.upper)};
+}
+
+/* true if inner lies within outer, boundaries included */
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+contains(Box<Point> const & outer, Box<Point> const & inner) noexcept
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (... && (get<Is>(outer.lower) <= get<Is>(inner.lower) && get<Is>(inner.upper) <= get<Is>(outer.upper)));
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+}
+
+/* true if the closed boxes share at least one point */
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+intersects(Box<Point> const & lhs, Box<Point> const & rhs) noexcept
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (... && (get<Is>(lhs.lower) <= get<Is>(rhs.upper) && get<Is>(rhs.lower) <= get<Is>(lhs.upper)));
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,559 @@
+#ifndef GEO_BVH_HPP
+#define GEO_BVH_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "box.hpp"
+#include "detail/detail_bvh.hpp"
+#include "detail/detail_execution.hpp"
+#include "execution.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** DynamicBvh ********************************/
+
+/* Dynamic bounding volume hierarchy over objects that move.
+ *
+ * Every object is kept in a leaf under a fat box, its bounding box grown by
+ * a margin. As long as an object stays within its fat box the tree does not
+ * change, so small motions cost only the containment check. Insertion picks
+ * the sibling of least added surface (Box2D's descent) and the nodes on the
+ * way back up are refit and rotated: a child swaps places with a grandchild,
+ * or two grandchildren swap, whenever that shrinks the nodes in between
+ * (Kopta et al., "Fast, effective BVH updates for animated scenes", 2012).
+ * That keeps the tree good under insertions, removals and motion without
+ * ever rebuilding it.
+ *
+ * Objects are addressed by handles that stay valid until removed; removed
+ * handles are reused by later insertions. Objects can be replaced by
+ * update() or changed in place through operator[] and brought up to date in
+ * bulk by refit(). */
+template <concepts::geo_object Object>
+requires std::floating_point<traits::value_type_t<detail::bounding_box_t<Object>>>
+      && (traits::dimension_v<traits::point_type_t<detail::bounding_box_t<Object>>> == 2
+          || traits::dimension_v<traits::point_type_t<detail::bounding_box_t<Object>>> == 3)
+class DynamicBvh
+{
+public:
+  using object_type = Object;
+  using box_type = detail::bounding_box_t<Object>;
+  using value_type = traits::value_type_t<box_type>;
+  using handle = std::size_t;
+
+  static constexpr handle none = std::numeric_limits<std::size_t>::max();
+
+  DynamicBvh() = default;
+
+  explicit DynamicBvh(value_type margin)
+    : margin_(margin)
+  {
+    if (margin < value_type{}) {
+      throw std::invalid_argument("negative margin");
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] bool
+  contains(handle h) const noexcept
+  {
+    return h < leaves_.size() && leaves_[h] != none;
+  }
+
+  [[nodiscard]] Object const &
+  operator[](handle h) const noexcept
+  {
+    return objects_[h];
+  }
+
+  /* for changes in place, seen by the tree after the next refit() */
+  [[nodiscard]] Object &
+  operator[](handle h) noexcept
+  {
+    return objects_[h];
+  }
+
+  [[nodiscard]] box_type const &
+  fat_box(handle h) const noexcept
+  {
+    return nodes_[leaves_[h]].box;
+  }
+
+  /* longest path from the root to a leaf, 0 for a single object */
+  [[nodiscard]] std::size_t
+  height() const noexcept
+  {
+    return root_ == none ? 0 : nodes_[root_].height;
+  }
+
+  /* sum of the measures of the inner nodes, what traversals pay */
+  [[nodiscard]] value_type
+  cost() const noexcept
+  {
+    value_type retval{};
+    for (std::size_t n = 0; n < nodes_.size(); ++n) {
+      if (nodes_[n].children[0] != none && nodes_[n].height != free_height) {
+        retval += detail::box_measure(nodes_[n].box);
+      }
+    }
+    return retval;
+  }
+
+  handle
+  insert(Object object)
+  {
+    handle h = 0;
+    if (free_handles_.empty()) {
+      h = objects_.size();
+      objects_.push_back(std::move(object));
+      leaves_.push_back(none);
+    } else {
+      h = free_handles_.back();
+      free_handles_.pop_back();
+      objects_[h] = std::move(object);
+    }
+
+    std::size_t const leaf = allocate_node();
+    nodes_[leaf].box = detail::inflate(bounding_box(objects_[h]), margin_);
+    nodes_[leaf].item = h;
+    leaves_[h] = leaf;
+    insert_leaf(leaf);
+    ++size_;
+    return h;
+  }
+
+  void
+  remove(handle h)
+  {
+    if (!contains(h)) {
+      throw std::invalid_argument("invalid handle");
+    }
+    std::size_t const leaf = leaves_[h];
+    remove_leaf(leaf);
+    free_node(leaf);
+    leaves_[h] = none;
+    free_handles_.push_back(h);
+    --size_;
+  }
+
+  /* Replaces the object. Returns true if it left its fat box and was
+   * reinserted, false if the tree stayed as it was. */
+  bool
+  update(handle h, Object object)
+  {
+    if (!contains(h)) {
+      throw std::invalid_argument("invalid handle");
+    }
+    objects_[h] = std::move(object);
+    return move_leaf(h);
+  }
+
+  /* Brings the tree up to date after objects changed through operator[].
+   * Objects that left their fat box get a new one, their ancestors are refit
+   * bottom-up and rotated. Returns the number of objects that left their
+   * box.
+   *
+   * The parallel version checks the objects concurrently and refits the
+   * affected inner nodes level by level, all nodes of a height at once; the
+   * rotations, constant work per affected node, run sequentially after. */
+  std::size_t
+  refit(execution::sequenced_policy)
+  {
+    return refit_impl<false>();
+  }
+
+  std::size_t
+  refit(execution::parallel_policy)
+  {
+    return refit_impl<true>();
+  }
+
+  std::size_t
+  refit()
+  {
+    return refit_impl<false>();
+  }
+
+  /* Calls f(handle) for every object whose fat box intersects box. If f
+   * returns bool, false stops the query. Traverses along parent links, so it
+   * needs no stack and queries may run concurrently. */
+  template <typename F>
+  requires std::invocable<F &, handle>
+  void
+  query(box_type const & box, F && f) const
+  {
+    traverse([&](box_type const & node_box) { return intersects(node_box, box); }, std::forward<F>(f));
+  }
+
+  /* The traversal behind query: descends into the nodes, leaves included,
+   * whose fat box enter(box) accepts and calls f(handle) for the objects
+   * reached. enter may depend on state that f changes, as the nearest hit
+   * so far of a ray cast. If f returns bool, false stops the traversal. */
+  template <typename Enter, typename F>
+  requires std::predicate<Enter &, box_type const &> && std::invocable<F &, handle>
+  void
+  traverse(Enter && enter, F && f) const
+  {
+    std::size_t previous = none;
+    std::size_t n = root_;
+    while (n != none) {
+      node const & current = nodes_[n];
+      std::size_t next = current.parent;
+      if (previous == current.parent) {
+        if (std::invoke(enter, current.box)) {
+          if (current.children[0] == none) {
+            if constexpr (std::same_as<std::invoke_result_t<F &, handle>, bool>) {
+              if (!std::invoke(f, current.item)) {
+                return;
+              }
+            } else {
+              std::invoke(f, current.item);
+            }
+          } else {
+            next = current.children[0];
+          }
+        }
+      } else if (previous == current.children[0]) {
+        next = current.children[1];
+      }
+      previous = n;
+      n = next;
+    }
+  }
+
+private:
+  static constexpr std::size_t free_height = std::numeric_limits<std::size_t>::max();
+
+  /* leaves have no children and hold an item, inner nodes have two children */
+  struct node
+  {
+    box_type box{};
+    std::size_t parent = none;
+    std::array<std::size_t, 2> children{none, none};
+    std::size_t height = 0;
+    handle item = none;
+  };
+
+  std::size_t
+  allocate_node()
+  {
+    std::size_t n = 0;
+    if (free_nodes_.empty()) {
+      n = nodes_.size();
+      nodes_.emplace_back();
+    } else {
+      n = free_nodes_.back();
+      free_nodes_.pop_back();
+      nodes_[n] = node{};
+    }
+    return n;
+  }
+
+  void
+  free_node(std::size_t n)
+  {
+    nodes_[n].height = free_height;
+    free_nodes_.push_back(n);
+  }
+
+  [[nodiscard]] bool
+  leaf(std::size_t n) const noexcept
+  {
+    return nodes_[n].children[0] == none;
+  }
+
+  void
+  replace_child(std::size_t parent, std::size_t old_child, std::size_t new_child) noexcept
+  {
+    auto & children = nodes_[parent].children;
+    children[children[0] == old_child ? 0 : 1] = new_child;
+    nodes_[new_child].parent = parent;
+  }
+
+  /* box and height from the children */
+  void
+  refresh(std::size_t n) noexcept
+  {
+    auto & current = nodes_[n];
+    auto const & [first, second] = current.children;
+    current.box = merge(nodes_[first].box, nodes_[second].box);
+    current.height = 1 + std::max(nodes_[first].height, nodes_[second].height);
+  }
+
+  void
+  refresh_height(std::size_t n) noexcept
+  {
+    auto const & [first, second] = nodes_[n].children;
+    nodes_[n].height = 1 + std::max(nodes_[first].height, nodes_[second].height);
+  }
+
+  /* Swaps two nodes under n, a child with a grandchild under the other
+   * child or two grandchildren under different children, if that shrinks
+   * the children of n; the best such swap is taken. The box of n stays the
+   * same. */
+  void
+  rotate(std::size_t n) noexcept
+  {
+    if (leaf(n)) {
+      return;
+    }
+
+    auto const measure = [&](std::size_t m) { return detail::box_measure(nodes_[m].box); };
+    auto const merged = [&](std::size_t lhs, std::size_t rhs) {
+      return detail::box_measure(merge(nodes_[lhs].box, nodes_[rhs].box));
+    };
+
+    value_type best{};
+    std::array<std::size_t, 2> swap{none, none};
+    for (std::size_t side = 0; side < 2; ++side) {
+      std::size_t const child = nodes_[n].children[side];
+      std::size_t const other = nodes_[n].children[1 - side];
+      if (leaf(other)) {
+        continue;
+      }
+      for (std::size_t k = 0; k < 2; ++k) {
+        value_type const gain = measure(other) - merged(child, nodes_[other].children[1 - k]);
+        if (gain > best) {
+          best = gain;
+          swap = {child, nodes_[other].children[k]};
+        }
+      }
+    }
+
+    std::size_t const first = nodes_[n].children[0];
+    std::size_t const second = nodes_[n].children[1];
+    if (!leaf(first) && !leaf(second)) {
+      for (std::size_t k = 0; k < 2; ++k) {
+        for (std::size_t l = 0; l < 2; ++l) {
+          std::size_t const d = nodes_[first].children[k];
+          std::size_t const e = nodes_[first].children[1 - k];
+          std::size_t const f = nodes_[second].children[l];
+          std::size_t const g = nodes_[second].children[1 - l];
+          value_type const gain = measure(first) + measure(second) - merged(f, e) - merged(d, g);
+          if (gain > best) {
+            best = gain;
+            swap = {d, f};
+          }
+        }
+      }
+    }
+    if (swap[0] == none) {
+      return;
+    }
+
+    std::size_t const lhs = nodes_[swap[0]].parent;
+    std::size_t const rhs = nodes_[swap[1]].parent;
+    replace_child(lhs, swap[0], swap[1]);
+    replace_child(rhs, swap[1], swap[0]);
+    for (std::size_t const parent : {lhs, rhs}) {
+      if (parent != n) {
+        refresh(parent);
+      }
+    }
+    refresh_height(n);
+  }
+
+  /* refits and rotates from n up to the root */
+  void
+  repair_upwards(std::size_t n) noexcept
+  {
+    for (; n != none; n = nodes_[n].parent) {
+      refresh(n);
+      rotate(n);
+    }
+  }
+
+  void
+  insert_leaf(std::size_t leaf_node)
+  {
+    if (root_ == none) {
+      root_ = leaf_node;
+      nodes_[leaf_node].parent = none;
+      return;
+    }
+
+    /* descend towards the sibling that adds the least surface, counting what
+     * the enlargement costs every ancestor on the way */
+    box_type const box = nodes_[leaf_node].box;
+    std::size_t sibling = root_;
+    while (!leaf(sibling)) {
+      node const & current = nodes_[sibling];
+      value_type const measure = detail::box_measure(current.box);
+      value_type const combined = detail::box_measure(merge(current.box, box));
+      value_type const here = 2 * combined;
+      value_type const inherited = 2 * (combined - measure);
+
+      std::array<value_type, 2> descend{};
+      for (std::size_t k = 0; k < 2; ++k) {
+        node const & child = nodes_[current.children[k]];
+        descend[k] = detail::box_measure(merge(child.box, box)) + inherited;
+        if (child.children[0] != none) {
+          descend[k] -= detail::box_measure(child.box);
+        }
+      }
+      if (here < descend[0] && here < descend[1]) {
+        break;
+      }
+      sibling = current.children[descend[0] < descend[1] ? 0 : 1];
+    }
+
+    std::size_t const old_parent = nodes_[sibling].parent;
+    std::size_t const parent = allocate_node();
+    nodes_[parent].children = {sibling, leaf_node};
+    nodes_[sibling].parent = parent;
+    nodes_[leaf_node].parent = parent;
+    if (old_parent == none) {
+      root_ = parent;
+      nodes_[parent].parent = none;
+    } else {
+      replace_child(old_parent, sibling, parent);
+    }
+    repair_upwards(parent);
+  }
+
+  /* unlinks the leaf, its sibling takes the place of their parent */
+  void
+  remove_leaf(std::size_t leaf_node)
+  {
+    if (leaf_node == root_) {
+      root_ = none;
+      return;
+    }
+
+    std::size_t const parent = nodes_[leaf_node].parent;
+    std::size_t const grandparent = nodes_[parent].parent;
+    auto const & children = nodes_[parent].children;
+    std::size_t const sibling = children[0] == leaf_node ? children[1] : children[0];
+    free_node(parent);
+    if (grandparent == none) {
+      root_ = sibling;
+      nodes_[sibling].parent = none;
+    } else {
+      replace_child(grandparent, parent, sibling);
+      repair_upwards(grandparent);
+    }
+  }
+
+  /* reinserts the leaf of h if its object left the fat box */
+  bool
+  move_leaf(handle h)
+  {
+    std::size_t const leaf_node = leaves_[h];
+    auto const box = bounding_box(objects_[h]);
+    if (geo::contains(nodes_[leaf_node].box, box)) {
+      return false;
+    }
+    remove_leaf(leaf_node);
+    nodes_[leaf_node].box = detail::inflate(box, margin_);
+    insert_leaf(leaf_node);
+    return true;
+  }
+
+  template <bool Parallel>
+  std::size_t
+  refit_impl()
+  {
+    /* levels below this size are not worth starting threads for */
+    constexpr std::size_t parallel_level = 4096;
+
+    moved_.assign(objects_.size(), 0);
+    auto const check = [&](std::size_t first, std::size_t last) {
+      for (handle h = first; h < last; ++h) {
+        if (leaves_[h] == none) {
+          continue;
+        }
+        auto & fat = nodes_[leaves_[h]].box;
+        auto const box = bounding_box(objects_[h]);
+        if (!geo::contains(fat, box)) {
+          fat = detail::inflate(box, margin_);
+          moved_[h] = 1;
+        }
+      }
+    };
+    if constexpr (Parallel) {
+      detail::parallel_for(objects_.size(), check);
+    } else {
+      check(0, objects_.size());
+    }
+
+    /* the ancestors of moved leaves, by height; every ancestor is listed
+     * once and above all of its affected descendants */
+    levels_.assign(height() + 1, {});
+    visited_.resize(nodes_.size(), 0);
+    ++stamp_;
+    std::size_t moved = 0;
+    for (handle h = 0; h < moved_.size(); ++h) {
+      if (moved_[h] == 0) {
+        continue;
+      }
+      ++moved;
+      for (std::size_t n = nodes_[leaves_[h]].parent; n != none && visited_[n] != stamp_; n = nodes_[n].parent) {
+        visited_[n] = stamp_;
+        levels_[nodes_[n].height].push_back(n);
+      }
+    }
+
+    for (auto const & level : levels_) {
+      auto const merge_level = [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          auto & current = nodes_[level[i]];
+          current.box = merge(nodes_[current.children[0]].box, nodes_[current.children[1]].box);
+        }
+      };
+      if (Parallel && level.size() >= parallel_level) {
+        detail::parallel_for(level.size(), merge_level);
+      } else {
+        merge_level(0, level.size());
+      }
+    }
+
+    for (auto const & level : levels_) {
+      for (std::size_t const n : level) {
+        refresh_height(n);
+        rotate(n);
+      }
+    }
+    return moved;
+  }
+
+  value_type margin_{};
+  std::vector<node> nodes_{};
+  std::vector<std::size_t> free_nodes_{};
+  std::size_t root_ = none;
+
+  std::vector<Object> objects_{};
+  std::vector<std::size_t> leaves_{};
+  std::vector<handle> free_handles_{};
+  std::size_t size_ = 0;
+
+  /* scratch of refit(), kept to reuse the memory */
+  std::vector<unsigned char> moved_{};
+  std::vector<std::vector<std::size_t>> levels_{};
+  std::vector<std::size_t> visited_{};
+  std::size_t stamp_ = 0;
+};
+
+} // namespace geo
+
+#endif
@@ -54,10 +54,16 @@ template <concepts::point Point>
 struct access_center<Circle<Point>>
 {
   [[nodiscard]] static constexpr Point const &
-  get(Circle<Point> const &);
+  get(Circle<Point> const & circle)
+  {
+    return circle.center;
+  }
   
   static constexpr void
-  set(Circle<Point> &, Point const &);
+  set(Circle<Point> & circle, Point const & center)
+  {
+    circle.center = center;
+  }
 };
 
 template <concepts::point Point>
@@ -0,0 +1,129 @@
+#ifndef GEO_CIRCLE_FIT_HPP
+#define GEO_CIRCLE_FIT_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include "circle.hpp"
+#include "convex_hull.hpp"
+#include "detail/detail_circle_fit.hpp"
+#include "execution.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+/* offsets[c] .. offsets[c + 1] delimit cluster c of a point range */
+template <typename Range>
+concept offset_range =
+  std::ranges::random_access_range<Range>
+  && std::ranges::sized_range<Range>
+  && std::integral<std::ranges::range_value_t<Range>>;
+
+} // namespace concepts
+
+enum class circle_fit_method { pratt, kasa };
+
+/***************************** minimum enclosing circle ********************************/
+
+/* Smallest circle containing all points, by Welzl's algorithm in expected
+ * linear time. Throws std::invalid_argument on an empty range. */
+template <concepts::point_range<2> Range>
+[[nodiscard]] Circle<std::ranges::range_value_t<Range>>
+min_enclosing_circle(Range const & points)
+{
+  std::vector<std::ranges::range_value_t<Range>> scratch(std::ranges::begin(points), std::ranges::end(points));
+  return detail::min_enclosing_circle(scratch);
+}
+
+/* Smallest enclosing circle of each cluster of points, the clusters stored
+ * one after another and delimited by offsets: cluster c is points[offsets[c]]
+ * up to points[offsets[c + 1]], so there is one offset more than clusters.
+ * Writes one circle per cluster to out. */
+template <concepts::point_range<2> Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+Out
+min_enclosing_circle(execution::sequenced_policy, Range const & points, Offsets const & offsets, Out out)
+{
+  auto const circles = detail::for_each_cluster<false>(points, offsets, [](auto first, auto last, auto & scratch) {
+    scratch.assign(first, last);
+    return detail::min_enclosing_circle(scratch);
+  });
+  return std::ranges::copy(circles, out).out;
+}
+
+/* fits the clusters concurrently */
+template <concepts::point_range<2> Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+Out
+min_enclosing_circle(execution::parallel_policy, Range const & points, Offsets const & offsets, Out out)
+{
+  auto const circles = detail::for_each_cluster<true>(points, offsets, [](auto first, auto last, auto & scratch) {
+    scratch.assign(first, last);
+    return detail::min_enclosing_circle(scratch);
+  });
+  return std::ranges::copy(circles, out).out;
+}
+
+template <concepts::point_range<2> Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+Out
+min_enclosing_circle(Range const & points, Offsets const & offsets, Out out)
+{
+  return min_enclosing_circle(execution::seq, points, offsets, out);
+}
+
+/***************************** circle fit ********************************/
+
+/* Least squares circle through noisy points by an algebraic fit, Pratt's by
+ * default. Kasa's is a little faster but biased towards small circles on
+ * short arcs. Throws std::invalid_argument for fewer than three points or
+ * collinear ones. */
+template <concepts::point_range<2> Range>
+[[nodiscard]] Circle<std::ranges::range_value_t<Range>>
+fit_circle(Range const & points, circle_fit_method method = circle_fit_method::pratt)
+{
+  using Point = std::ranges::range_value_t<Range>;
+  return detail::fit_circle<Point>(std::ranges::begin(points), std::ranges::end(points), method == circle_fit_method::pratt);
+}
+
+/* Fitted circle of each cluster of points, delimited by offsets as for
+ * min_enclosing_circle. */
+template <concepts::point_range<2> Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+Out
+fit_circle(execution::sequenced_policy, Range const & points, Offsets const & offsets, Out out,
+           circle_fit_method method = circle_fit_method::pratt)
+{
+  using Point = std::ranges::range_value_t<Range>;
+  auto const circles = detail::for_each_cluster<false>(points, offsets, [method](auto first, auto last, auto &) {
+    return detail::fit_circle<Point>(first, last, method == circle_fit_method::pratt);
+  });
+  return std::ranges::copy(circles, out).out;
+}
+
+/* fits the clusters concurrently */
+template <concepts::point_range<2> Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+Out
+fit_circle(execution::parallel_policy, Range const & points, Offsets const & offsets, Out out,
+           circle_fit_method method = circle_fit_method::pratt)
+{
+  using Point = std::ranges::range_value_t<Range>;
+  auto const circles = detail::for_each_cluster<true>(points, offsets, [method](auto first, auto last, auto &) {
+    return detail::fit_circle<Point>(first, last, method == circle_fit_method::pratt);
+  });
+  return std::ranges::copy(circles, out).out;
+}
+
+template <concepts::point_range<2> Range, concepts::offset_range Offsets, std::weakly_incrementable Out>
+Out
+fit_circle(Range const & points, Offsets const & offsets, Out out, circle_fit_method method = circle_fit_method::pratt)
+{
+  return fit_circle(execution::seq, points, offsets, out, method);
+}
+
+} // namespace geo
+
+#endif
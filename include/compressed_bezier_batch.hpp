@@ -0,0 +1,310 @@
+#ifndef GEO_COMPRESSED_BEZIER_BATCH_HPP
+#define GEO_COMPRESSED_BEZIER_BATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "bezier.hpp"
+#include "detail/detail_bezier.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Lossy, immutable storage for large sets of Beziers of the same degree.
+ *
+ * Curves are grouped into blocks of BlockSize. Within a block the first
+ * control point of every curve is quantized to an unsigned Code on a grid
+ * spanning the bounding box of those points; every further control point is
+ * stored as the signed Code difference to the previous, already reconstructed
+ * one, on a grid spanning the largest difference in the block. Curves are far
+ * smaller than a block, so the difference grid is much finer than the box
+ * grid and errors do not accumulate along the curve.
+ *
+ * Codes are kept in SoA lanes like BezierBatch, a block decodes with plain
+ * loops over its curves. A cubic 3D curve of doubles shrinks from 96 bytes of
+ * control points (plus container overhead) to about 25 bytes with 16 bit
+ * codes and 49 bytes with 32 bit codes. Control points have to be finite,
+ * construction throws std::invalid_argument otherwise. */
+template <
+  std::size_t Degree,
+  std::floating_point T,
+  std::size_t Dim,
+  typename Code = std::uint16_t,
+  std::size_t BlockSize = 64
+>
+requires concepts::bezier_degree<Degree>
+      && (Dim > 0)
+      && (std::same_as<Code, std::uint16_t> || std::same_as<Code, std::uint32_t>)
+      && (BlockSize > 0)
+class CompressedBezierBatch
+{
+public:
+  using value_type = T;
+  using code_type = Code;
+  using delta_type = std::make_signed_t<Code>;
+
+  static constexpr std::size_t degree = Degree;
+  static constexpr std::size_t dimension = Dim;
+  static constexpr std::size_t block_size = BlockSize;
+
+  /* decoded control points of one block, lane (i * Dim + k) holds component
+   * k of control point i of every curve in the block */
+  using block_lanes = std::array<std::array<T, BlockSize>, (Degree + 1) * Dim>;
+
+  CompressedBezierBatch() = default;
+
+  template <std::ranges::input_range Range>
+  requires concepts::bezier<std::ranges::range_value_t<Range>>
+        && (traits::degree_v<std::ranges::range_value_t<Range>> == Degree)
+        && concepts::dimension_equals<detail::ctrl_point_t<std::ranges::range_value_t<Range>>, Dim>
+        && concepts::value_type_equals<detail::ctrl_point_t<std::ranges::range_value_t<Range>>, T>
+  explicit CompressedBezierBatch(Range && beziers)
+  {
+    std::vector<std::array<std::array<T, Dim>, Degree + 1>> block;
+    block.reserve(BlockSize);
+    for (auto const & bezier : beziers) {
+      auto const ctrls = detail::copy_ctrls(bezier);
+      auto & curve = block.emplace_back();
+      for (std::size_t i = 0; i <= Degree; ++i) {
+        [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+          (..., (curve[i][Ks] = get<Ks>(ctrls[i])));
+        }(std::make_index_sequence<Dim>{});
+      }
+      if (block.size() == BlockSize) {
+        encode(block);
+        block.clear();
+      }
+    }
+    if (!block.empty()) {
+      encode(block);
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return anchors_[0].size();
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return anchors_[0].empty();
+  }
+
+  [[nodiscard]] std::size_t
+  block_count() const noexcept
+  {
+    return grids_.size();
+  }
+
+  /* number of curves in a block, BlockSize for all but the last one */
+  [[nodiscard]] std::size_t
+  block_curves(std::size_t block) const noexcept
+  {
+    return std::min(BlockSize, size() - block * BlockSize);
+  }
+
+  /* largest absolute error of a control point component seen while encoding */
+  [[nodiscard]] T
+  max_error() const noexcept
+  {
+    return max_error_;
+  }
+
+  /* heap memory held by codes and block grids */
+  [[nodiscard]] std::size_t
+  bytes() const noexcept
+  {
+    return size() * (Degree + 1) * Dim * sizeof(Code) + block_count() * sizeof(grid);
+  }
+
+  /* Decodes a block into out, out[i * Dim + k][j] receives component k of
+   * control point i of curve j of the block. */
+  void
+  decode(std::size_t block, block_lanes & out) const noexcept
+  {
+    auto const & g = grids_[block];
+    std::size_t const first = block * BlockSize;
+    std::size_t const count = block_curves(block);
+
+    for (std::size_t k = 0; k < Dim; ++k) {
+      Code const * const anchors = anchors_[k].data() + first;
+      T * const result = out[k].data();
+      for (std::size_t j = 0; j < count; ++j) {
+        result[j] = g.origin[k] + g.step[k] * static_cast<T>(anchors[j]);
+      }
+      for (std::size_t i = 1; i <= Degree; ++i) {
+        delta_type const * const deltas = deltas_[(i - 1) * Dim + k].data() + first;
+        T const * const previous = out[(i - 1) * Dim + k].data();
+        T * const current = out[i * Dim + k].data();
+        for (std::size_t j = 0; j < count; ++j) {
+          current[j] = previous[j] + g.delta_step[k] * static_cast<T>(deltas[j]);
+        }
+      }
+    }
+  }
+
+  template <concepts::point Point, concepts::container Cont = std::array<Point, Degree + 1>>
+  requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] Bezier<Degree, Point, Cont>
+  bezier(std::size_t curve) const
+  {
+    auto const & g = grids_[curve / BlockSize];
+
+    std::array<Point, Degree + 1> ctrls;
+    for (std::size_t k = 0; k < Dim; ++k) {
+      T value = g.origin[k] + g.step[k] * static_cast<T>(anchors_[k][curve]);
+      set_component(ctrls[0], k, value);
+      for (std::size_t i = 1; i <= Degree; ++i) {
+        value = value + g.delta_step[k] * static_cast<T>(deltas_[(i - 1) * Dim + k][curve]);
+        set_component(ctrls[i], k, value);
+      }
+    }
+    if constexpr (concepts::array<Cont>) {
+      return Bezier<Degree, Point, Cont>(ctrls);
+    } else {
+      return Bezier<Degree, Point, Cont>(ctrls.cbegin(), ctrls.cend());
+    }
+  }
+
+  /* random access range of decoded Bezier<Degree, Point, Cont> */
+  template <concepts::point Point, concepts::container Cont = std::array<Point, Degree + 1>>
+  requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] auto
+  curves() const
+  {
+    return std::views::iota(std::size_t{0}, size())
+      | std::views::transform([this](std::size_t i) { return bezier<Point, Cont>(i); });
+  }
+
+private:
+  struct grid
+  {
+    std::array<T, Dim> origin;
+    std::array<T, Dim> step;
+    std::array<T, Dim> delta_step;
+  };
+
+  template <concepts::point Point>
+  static void
+  set_component(Point & point, std::size_t k, T value) noexcept
+  {
+    [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+      (..., (k == Ks ? set<Ks>(point, value) : void()));
+    }(std::make_index_sequence<Dim>{});
+  }
+
+  /* Rounds and clamps in double, which holds the range of 32 bit codes
+   * exactly; in float their largest value rounds up past the range and the
+   * cast would overflow. */
+  template <std::integral Int>
+  [[nodiscard]] static Int
+  quantize(T value, T step) noexcept
+  {
+    if (step == T{}) {
+      return Int{};
+    }
+    double const code = std::round(static_cast<double>(value) / static_cast<double>(step));
+    return static_cast<Int>(std::clamp(code,
+      static_cast<double>(std::numeric_limits<Int>::min()), static_cast<double>(std::numeric_limits<Int>::max())));
+  }
+
+  void
+  encode(std::vector<std::array<std::array<T, Dim>, Degree + 1>> const & block)
+  {
+    constexpr auto anchor_levels = static_cast<double>(std::numeric_limits<Code>::max());
+    constexpr auto delta_levels = static_cast<double>(std::numeric_limits<delta_type>::max());
+
+    for (auto const & curve : block) {
+      for (auto const & ctrl : curve) {
+        if (!std::ranges::all_of(ctrl, [](T x) { return std::isfinite(x); })) {
+          throw std::invalid_argument("non-finite control point");
+        }
+      }
+    }
+
+    grid g{};
+    for (std::size_t k = 0; k < Dim; ++k) {
+      auto const [lo, hi] = std::ranges::minmax(
+        block | std::views::transform([k](auto const & curve) { return curve[0][k]; }));
+      T spread{};
+      for (auto const & curve : block) {
+        for (std::size_t i = 1; i <= Degree; ++i) {
+          spread = std::max(spread, std::abs(curve[i][k] - curve[i - 1][k]));
+        }
+      }
+      g.origin[k] = lo;
+      g.step[k] = static_cast<T>((static_cast<double>(hi) - static_cast<double>(lo)) / anchor_levels);
+      /* differences are taken to reconstructed points, which are off by at
+       * most half a step of the coarser grid */
+      g.delta_step[k] = static_cast<T>((static_cast<double>(spread) + 2 * static_cast<double>(g.step[k])) / delta_levels);
+      if (!std::isfinite(hi - lo) || !std::isfinite(spread)) {
+        throw std::invalid_argument("control points too far apart to quantize");
+      }
+    }
+
+    for (std::size_t k = 0; k < Dim; ++k) {
+      for (auto const & curve : block) {
+        auto const anchor = quantize<Code>(curve[0][k] - g.origin[k], g.step[k]);
+        anchors_[k].push_back(anchor);
+
+        T value = g.origin[k] + g.step[k] * static_cast<T>(anchor);
+        max_error_ = std::max(max_error_, std::abs(value - curve[0][k]));
+        for (std::size_t i = 1; i <= Degree; ++i) {
+          auto const delta = quantize<delta_type>(curve[i][k] - value, g.delta_step[k]);
+          deltas_[(i - 1) * Dim + k].push_back(delta);
+
+          value = value + g.delta_step[k] * static_cast<T>(delta);
+          max_error_ = std::max(max_error_, std::abs(value - curve[i][k]));
+        }
+      }
+    }
+    grids_.push_back(g);
+  }
+
+  std::array<std::vector<Code>, Dim> anchors_{};
+  std::array<std::vector<delta_type>, Degree * Dim> deltas_{};
+  std::vector<grid> grids_;
+  T max_error_{};
+};
+
+/***************************** algorithms ********************************/
+
+/* Evaluates every curve at t, out[k][j] receives component k of curve j.
+ * Blocks are decoded into a stack buffer right before evaluation, the full
+ * set of control points is never materialized. */
+template <std::size_t Degree, std::floating_point T, std::size_t Dim, typename Code, std::size_t BlockSize>
+void
+evaluate_at(
+    CompressedBezierBatch<Degree, T, Dim, Code, BlockSize> const & batch, T t,
+    std::array<std::span<T>, Dim> const & out) noexcept
+{
+  auto const weights = detail::bernstein_weights<Degree>(t);
+
+  typename CompressedBezierBatch<Degree, T, Dim, Code, BlockSize>::block_lanes lanes;
+  for (std::size_t block = 0; block < batch.block_count(); ++block) {
+    batch.decode(block, lanes);
+    std::size_t const first = block * BlockSize;
+    for (std::size_t k = 0; k < Dim; ++k) {
+      detail::evaluate_lanes<Degree>(
+        weights, [&](std::size_t i) { return lanes[i * Dim + k].data(); },
+        batch.block_curves(block), out[k].data() + first);
+    }
+  }
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef GEO_CONVEX_HULL_HPP
+#define GEO_CONVEX_HULL_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include "detail/detail_convex_hull.hpp"
+#include "detail/detail_execution.hpp"
+#include "execution.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+template <typename Range, std::size_t Dim>
+concept point_range =
+  std::ranges::random_access_range<Range>
+  && std::ranges::sized_range<Range>
+  && point<std::ranges::range_value_t<Range>>
+  && dimension_equals<std::ranges::range_value_t<Range>, Dim>
+  && std::floating_point<traits::value_type_t<std::ranges::range_value_t<Range>>>;
+
+} // namespace concepts
+
+/***************************** algorithms ********************************/
+
+/* Convex hull of a 2D point set. Writes the hull vertices to out in
+ * counter-clockwise order, starting with the lexicographically smallest one;
+ * collinear boundary points and duplicates are dropped.
+ *
+ * Points strictly inside the polygon of the eight axis and diagonal extremes
+ * are discarded first (Akl-Toussaint), the remaining candidates go through
+ * Andrew's monotone chain. The parallel version filters concurrently, then
+ * sorts and chains one slice of the candidates per thread and merges the
+ * partial hulls with a final chain over their vertices. */
+template <concepts::point_range<2> Range, std::weakly_incrementable Out>
+Out
+convex_hull(execution::sequenced_policy, Range const & points, Out out)
+{
+  using Point = std::ranges::range_value_t<Range>;
+
+  auto candidates = detail::hull_candidates_2d<false>(points);
+  std::ranges::sort(candidates, detail::lexicographic_less<Point>);
+
+  std::vector<Point> hull;
+  detail::monotone_chain(candidates, hull);
+  return std::ranges::copy(hull, out).out;
+}
+
+template <concepts::point_range<2> Range, std::weakly_incrementable Out>
+Out
+convex_hull(execution::parallel_policy, Range const & points, Out out)
+{
+  using Point = std::ranges::range_value_t<Range>;
+
+  auto candidates = detail::hull_candidates_2d<true>(points);
+
+  /* slices small enough for a thread each, but not too small to be worth it */
+  std::size_t const slices = std::clamp<std::size_t>(candidates.size() / 4096, 1, detail::worker_count());
+  std::vector<std::vector<Point>> partial(slices);
+  detail::parallel_for(slices, [&](std::size_t first, std::size_t last) {
+    for (std::size_t s = first; s < last; ++s) {
+      auto const begin = candidates.begin() + static_cast<std::ptrdiff_t>(candidates.size() * s / slices);
+      auto const end = candidates.begin() + static_cast<std::ptrdiff_t>(candidates.size() * (s + 1) / slices);
+      std::vector<Point> slice(begin, end);
+      std::ranges::sort(slice, detail::lexicographic_less<Point>);
+      detail::monotone_chain(slice, partial[s]);
+    }
+  });
+
+  std::vector<Point> merged;
+  for (auto const & hull : partial) {
+    merged.insert(merged.end(), hull.begin(), hull.end());
+  }
+  std::ranges::sort(merged, detail::lexicographic_less<Point>);
+
+  std::vector<Point> hull;
+  detail::monotone_chain(merged, hull);
+  return std::ranges::copy(hull, out).out;
+}
+
+/* Convex hull of a 3D point set. Writes the boundary as triangles,
+ * std::array<Point, 3> with counter-clockwise vertices seen from outside.
+ * Coplanar boundary regions are triangulated, input without volume yields
+ * no triangles.
+ *
+ * Points strictly inside the octahedron of the six axis extremes are
+ * discarded first (Akl-Toussaint), the rest goes through Quickhull. The
+ * parallel version runs the filter concurrently. */
+template <concepts::point_range<3> Range, std::weakly_incrementable Out>
+Out
+convex_hull(execution::sequenced_policy, Range const & points, Out out)
+{
+  using Point = std::ranges::range_value_t<Range>;
+
+  auto const candidates = detail::hull_candidates_3d<false>(points);
+  for (auto const & t : detail::quickhull(candidates)) {
+    *out = std::array<Point, 3>{candidates[t[0]], candidates[t[1]], candidates[t[2]]};
+    ++out;
+  }
+  return out;
+}
+
+template <concepts::point_range<3> Range, std::weakly_incrementable Out>
+Out
+convex_hull(execution::parallel_policy, Range const & points, Out out)
+{
+  using Point = std::ranges::range_value_t<Range>;
+
+  auto const candidates = detail::hull_candidates_3d<true>(points);
+  for (auto const & t : detail::quickhull(candidates)) {
+    *out = std::array<Point, 3>{candidates[t[0]], candidates[t[1]], candidates[t[2]]};
+    ++out;
+  }
+  return out;
+}
+
+template <typename Range, std::weakly_incrementable Out>
+requires concepts::point_range<Range, 2> || concepts::point_range<Range, 3>
+Out
+convex_hull(Range const & points, Out out)
+{
+  return convex_hull(execution::seq, points, out);
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef GEO_DELAUNAY_HPP
+#define GEO_DELAUNAY_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "detail/detail_delaunay.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** Voronoi ********************************/
+
+/* Voronoi diagram dual to a Delaunay triangulation. Vertex t is the
+ * circumcenter of triangle t, the cell of a site lists its vertices in
+ * counter-clockwise order. Cells of sites on the convex hull are unbounded:
+ * their chain is open and continues to infinity at both ends, perpendicular
+ * to the hull edges. Duplicate sites have empty cells. */
+template <concepts::point Point>
+class Voronoi
+{
+public:
+  Voronoi(std::vector<Point> vertices, std::vector<std::size_t> offsets,
+          std::vector<std::size_t> cells, std::vector<bool> bounded)
+    : vertices_(std::move(vertices)), offsets_(std::move(offsets)),
+      cells_(std::move(cells)), bounded_(std::move(bounded))
+  {}
+
+  [[nodiscard]] std::span<Point const>
+  vertices() const noexcept
+  {
+    return vertices_;
+  }
+
+  /* number of sites */
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return bounded_.size();
+  }
+
+  [[nodiscard]] std::span<std::size_t const>
+  cell(std::size_t site) const noexcept
+  {
+    return std::span{cells_}.subspan(offsets_[site], offsets_[site + 1] - offsets_[site]);
+  }
+
+  [[nodiscard]] bool
+  bounded(std::size_t site) const noexcept
+  {
+    return bounded_[site];
+  }
+
+private:
+  std::vector<Point> vertices_;
+  std::vector<std::size_t> offsets_;
+  std::vector<std::size_t> cells_;
+  std::vector<bool> bounded_;
+};
+
+/***************************** Delaunay ********************************/
+
+/* Delaunay triangulation of a 2D point set.
+ *
+ * Points are inserted along a Hilbert curve by Bowyer-Watson, so the walk
+ * locating the next point starts next to it. All decisions go through the
+ * exact orientation and incircle predicates; cocircular points are
+ * triangulated arbitrarily, duplicates are inserted once and input without
+ * area yields no triangles.
+ *
+ * The result is an index based half-edge structure in flat arrays. Triangle
+ * t is triangles()[3t .. 3t + 3), counter-clockwise; half-edge e runs from
+ * vertex triangles()[e] to the next vertex of its triangle and halfedges()[e]
+ * is the half-edge running the other way, none on the convex hull. */
+template <concepts::point Point>
+requires concepts::dimension_equals<Point, 2> && std::floating_point<traits::value_type_t<Point>>
+class Delaunay
+{
+public:
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  template <std::ranges::input_range Range>
+  requires std::same_as<std::ranges::range_value_t<Range>, Point>
+  explicit Delaunay(Range && points)
+    : points_(std::ranges::begin(points), std::ranges::end(points))
+  {
+    detail::delaunay_mesh<Point> mesh(points_);
+    mesh.build();
+    mesh.compact(triangles_, halfedges_);
+  }
+
+  [[nodiscard]] std::span<Point const>
+  points() const noexcept
+  {
+    return points_;
+  }
+
+  [[nodiscard]] std::size_t
+  triangle_count() const noexcept
+  {
+    return triangles_.size() / 3;
+  }
+
+  [[nodiscard]] std::span<std::size_t const>
+  triangles() const noexcept
+  {
+    return triangles_;
+  }
+
+  [[nodiscard]] std::span<std::size_t const>
+  halfedges() const noexcept
+  {
+    return halfedges_;
+  }
+
+  [[nodiscard]] std::array<Point, 3>
+  triangle(std::size_t t) const noexcept
+  {
+    return {points_[triangles_[3 * t]], points_[triangles_[3 * t + 1]], points_[triangles_[3 * t + 2]]};
+  }
+
+  [[nodiscard]] Voronoi<Point>
+  voronoi() const
+  {
+    using T = traits::value_type_t<Point>;
+
+    std::vector<Point> centers(triangle_count());
+    for (std::size_t t = 0; t < centers.size(); ++t) {
+      auto const [a, b, c] = triangle(t);
+      T const bx = get<0>(b) - get<0>(a), by = get<1>(b) - get<1>(a);
+      T const cx = get<0>(c) - get<0>(a), cy = get<1>(c) - get<1>(a);
+      T const bl = bx * bx + by * by;
+      T const cl = cx * cx + cy * cy;
+      T const d = 2 * (bx * cy - by * cx);
+      set<0>(centers[t], get<0>(a) + (cy * bl - by * cl) / d);
+      set<1>(centers[t], get<1>(a) + (bx * cl - cx * bl) / d);
+    }
+
+    /* an outgoing half-edge per site, for hull sites the clockwise-most one,
+     * which lies on the hull */
+    std::vector<std::size_t> outgoing(points_.size(), none);
+    for (std::size_t e = 0; e < triangles_.size(); ++e) {
+      if (outgoing[triangles_[e]] == none || halfedges_[e] == none) {
+        outgoing[triangles_[e]] = e;
+      }
+    }
+
+    std::vector<std::size_t> offsets(points_.size() + 1);
+    std::vector<std::size_t> cells;
+    std::vector<bool> bounded(points_.size());
+    cells.reserve(triangles_.size());
+    for (std::size_t site = 0; site < points_.size(); ++site) {
+      std::size_t const first = outgoing[site];
+      bounded[site] = first != none && halfedges_[first] != none;
+      for (std::size_t e = first; e != none;) {
+        cells.push_back(e / 3);
+        std::size_t const previous = e % 3 == 0 ? e + 2 : e - 1;
+        e = halfedges_[previous];
+        if (e == first) {
+          break;
+        }
+      }
+      offsets[site + 1] = cells.size();
+    }
+    return {std::move(centers), std::move(offsets), std::move(cells), std::move(bounded)};
+  }
+
+private:
+  std::vector<Point> points_;
+  std::vector<std::size_t> triangles_;
+  std::vector<std::size_t> halfedges_;
+};
+
+template <std::ranges::input_range Range>
+Delaunay(Range &&) -> Delaunay<std::ranges::range_value_t<Range>>;
+
+} // namespace geo
+
+#endif
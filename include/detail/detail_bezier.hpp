@@ -1,11 +1,14 @@
 #ifndef GEO_DETAIL_BEZIER_HPP
 #define GEO_DETAIL_BEZIER_HPP
 
+#include <algorithm>
 #include <array>
 #include <iterator>
 #include <cmath>
 #include <utility>
 
+#include "../traits.hpp"
+
 namespace geo::detail {
 
 template <std::size_t N>
@@ -43,7 +46,7 @@ create_binom_coeffs() noexcept
   return create_binom_coeffs_impl<N>(std::make_index_sequence<N>{});
 }
 
-template <std::floating_point T, std::size_t N>
+template <concepts::real T, std::size_t N>
 [[nodiscard]] constexpr T
 pow(T base) noexcept
 {
@@ -59,6 +62,108 @@ pow(T base) noexcept
   }
 }
 
+template <concepts::bezier Bezier>
+using ctrl_point_t = typename std::iterator_traits<traits::const_iter_t<Bezier>>::value_type;
+
+template <std::size_t Degree, std::size_t N, std::floating_point T>
+[[nodiscard]] consteval std::array<std::array<T, Degree + 1>, N>
+create_sampled_basis() noexcept
+{
+  constexpr auto binom_coeffs = create_binom_coeffs<Degree + 1>();
+
+  std::array<std::array<T, Degree + 1>, N> retval{};
+  for (std::size_t i = 0; i < N; ++i) {
+    T const t = static_cast<T>(i) / static_cast<T>(N - 1);
+    for (std::size_t j = 0; j <= Degree; ++j) {
+      T weight = static_cast<T>(binom_coeffs[j]);
+      for (std::size_t k = 0; k < j; ++k) {
+        weight *= t;
+      }
+      for (std::size_t k = 0; k < Degree - j; ++k) {
+        weight *= T{1} - t;
+      }
+      retval[i][j] = weight;
+    }
+  }
+  return retval;
+}
+
+template <concepts::bezier Bezier>
+[[nodiscard]] constexpr auto
+copy_ctrls(Bezier const & bezier) noexcept
+{
+  std::array<ctrl_point_t<Bezier>, traits::degree_v<Bezier> + 1> retval{};
+  if (std::is_constant_evaluated()) {
+    std::copy_n(cecbegin(bezier), retval.size(), retval.begin());
+  } else {
+    std::copy_n(cbegin(bezier), retval.size(), retval.begin());
+  }
+  return retval;
+}
+
+template <typename Basis, concepts::point Point>
+[[nodiscard]] constexpr Point
+apply_basis_row(
+    std::array<Point, Basis::degree + 1> const & ctrls,
+    std::size_t row) noexcept
+{
+  auto const & weights = Basis::weights[row];
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+  {
+    Point retval;
+    auto helper = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+      traits::value_type_t<Point> sum{};
+      for (std::size_t j = 0; j <= Basis::degree; ++j) {
+        sum += weights[j] * get<I>(ctrls[j]);
+      }
+      set<I>(retval, sum);
+    };
+    (..., helper(std::integral_constant<std::size_t, Is>{}));
+    return retval;
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+}
+
+template <std::size_t Degree, concepts::real T>
+[[nodiscard]] constexpr std::array<T, Degree + 1>
+bernstein_weights(T t) noexcept
+{
+  constexpr auto binom_coeffs = create_binom_coeffs<Degree + 1>();
+
+  std::array<T, Degree + 1> t_powers{};
+  std::array<T, Degree + 1> one_minus_t_powers{};
+  t_powers[0] = one_minus_t_powers[0] = T{1};
+  for (std::size_t i = 1; i <= Degree; ++i) {
+    t_powers[i] = t_powers[i - 1] * t;
+    one_minus_t_powers[i] = one_minus_t_powers[i - 1] * (T{1} - t);
+  }
+
+  std::array<T, Degree + 1> retval{};
+  for (std::size_t i = 0; i <= Degree; ++i) {
+    retval[i] = static_cast<T>(binom_coeffs[i]) * t_powers[i] * one_minus_t_powers[Degree - i];
+  }
+  return retval;
+}
+
+/* SoA Bernstein sum over size curves, lane(i) points to one component of
+ * control point i of every curve */
+template <std::size_t Degree, std::floating_point T, typename Lane>
+void
+evaluate_lanes(
+    std::array<T, Degree + 1> const & weights, Lane lane, std::size_t size, T * result) noexcept
+{
+  T const * const first = lane(0);
+  for (std::size_t j = 0; j < size; ++j) {
+    result[j] = weights[0] * first[j];
+  }
+  for (std::size_t i = 1; i <= Degree; ++i) {
+    T const weight = weights[i];
+    T const * const ctrls = lane(i);
+    for (std::size_t j = 0; j < size; ++j) {
+      result[j] += weight * ctrls[j];
+    }
+  }
+}
+
 template <concepts::bezier Bezier>
 struct bernstein
 {
@@ -66,7 +171,7 @@ struct bernstein
 
   // TODO this impl-dispatch could be simplified in C++23 with if consteval (not sure though)
   [[nodiscard]] static constexpr value_type
-  evaluate_at(Bezier const & bezier, std::floating_point auto t) noexcept
+  evaluate_at(Bezier const & bezier, concepts::real auto t) noexcept
   {
     if (std::is_constant_evaluated()) {
       return ce_evaluate_at_impl(
@@ -77,7 +182,7 @@ struct bernstein
     }
   }
 
-  template <std::floating_point T, std::size_t... I>
+  template <concepts::real T, std::size_t... I>
   [[nodiscard]] static constexpr value_type
   ce_evaluate_at_impl(Bezier const & bezier, T t, std::index_sequence<I...> seq) noexcept
   {
@@ -87,7 +192,7 @@ struct bernstein
                     * *std::next(cecbegin(bezier), I)));
   }
 
-  template <std::floating_point T, std::size_t... I>
+  template <concepts::real T, std::size_t... I>
   [[nodiscard]] static value_type
   evaluate_at_impl(Bezier const & bezier, T t, std::index_sequence<I...> seq) noexcept
   {
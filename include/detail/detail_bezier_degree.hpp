@@ -0,0 +1,331 @@
+#ifndef GEO_DETAIL_BEZIER_DEGREE_HPP
+#define GEO_DETAIL_BEZIER_DEGREE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <variant>
+
+#include "../bezier.hpp"
+#include "../bezier_batch.hpp"
+#include "../inline_vector.hpp"
+#include "../traits.hpp"
+#include "detail_bezier.hpp"
+
+namespace geo::detail {
+
+/***************************** matrices ********************************/
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+using degree_matrix = std::array<std::array<T, Cols>, Rows>;
+
+/* exact in double for the degrees of concepts::bezier_degree: every partial
+ * product is itself a binomial coefficient */
+[[nodiscard]] constexpr double
+binomial(std::size_t n, std::size_t k) noexcept
+{
+  double retval = 1.0;
+  for (std::size_t i = 1; i <= k; ++i) {
+    retval = retval * static_cast<double>(n - k + i) / static_cast<double>(i);
+  }
+  return retval;
+}
+
+/* control points of a curve of degree From as one of degree To >= From,
+ * Q_i = sum_j C(From, j) C(To - From, i - j) / C(To, i) P_j */
+template <std::size_t From, std::size_t To, std::floating_point T>
+requires (From <= To)
+[[nodiscard]] consteval degree_matrix<T, To + 1, From + 1>
+create_elevation_matrix() noexcept
+{
+  degree_matrix<T, To + 1, From + 1> retval{};
+  for (std::size_t i = 0; i <= To; ++i) {
+    for (std::size_t j = 0; j <= From && j <= i; ++j) {
+      if (i - j <= To - From) {
+        retval[i][j] = static_cast<T>(binomial(From, j) * binomial(To - From, i - j) / binomial(To, i));
+      }
+    }
+  }
+  return retval;
+}
+
+/* Control points of the curve of degree To < From closest to one of degree
+ * From in the L2 norm over [0, 1], the ends kept so that reduced chains stay
+ * connected. The normal equations of the inner control points involve the
+ * integrals of products of Bernstein polynomials,
+ *
+ *   int B_k^m B_l^n = C(m, k) C(n, l) / ((m + n + 1) C(m + n, k + l)),
+ *
+ * and are solved once, in double, at compile time. */
+template <std::size_t From, std::size_t To, std::floating_point T>
+requires (To >= 1 && To < From)
+[[nodiscard]] consteval degree_matrix<T, To + 1, From + 1>
+create_reduction_matrix() noexcept
+{
+  auto const integral = [](std::size_t m, std::size_t k, std::size_t n, std::size_t l) {
+    return binomial(m, k) * binomial(n, l) / (static_cast<double>(m + n + 1) * binomial(m + n, k + l));
+  };
+
+  degree_matrix<double, To + 1, To + 1> gram{};
+  degree_matrix<double, To + 1, From + 1> rhs{};
+  for (std::size_t k = 1; k < To; ++k) {
+    for (std::size_t l = 0; l <= To; ++l) {
+      gram[k][l] = integral(To, k, To, l);
+    }
+    for (std::size_t l = 0; l <= From; ++l) {
+      rhs[k][l] = integral(To, k, From, l);
+    }
+    rhs[k][0] -= gram[k][0];
+    rhs[k][From] -= gram[k][To];
+  }
+
+  /* Gauss-Jordan on the inner block, which is positive definite */
+  for (std::size_t col = 1; col < To; ++col) {
+    for (std::size_t row = 1; row < To; ++row) {
+      if (row == col) {
+        continue;
+      }
+      double const factor = gram[row][col] / gram[col][col];
+      for (std::size_t l = 1; l < To; ++l) {
+        gram[row][l] -= factor * gram[col][l];
+      }
+      for (std::size_t l = 0; l <= From; ++l) {
+        rhs[row][l] -= factor * rhs[col][l];
+      }
+    }
+  }
+
+  degree_matrix<T, To + 1, From + 1> retval{};
+  retval[0][0] = T{1};
+  retval[To][From] = T{1};
+  for (std::size_t k = 1; k < To; ++k) {
+    for (std::size_t l = 0; l <= From; ++l) {
+      retval[k][l] = static_cast<T>(rhs[k][l] / gram[k][k]);
+    }
+  }
+  return retval;
+}
+
+/* Control points of the part over [first, last] of a curve of degree
+ * Degree, by de Casteljau's algorithm on each basis polynomial: split at
+ * last and keep the left part, split that at first / last and keep the
+ * right. */
+template <std::size_t Degree>
+[[nodiscard]] consteval degree_matrix<double, Degree + 1, Degree + 1>
+create_restriction_matrix(double first, double last) noexcept
+{
+  degree_matrix<double, Degree + 1, Degree + 1> retval{};
+  for (std::size_t j = 0; j <= Degree; ++j) {
+    std::array<double, Degree + 1> ctrls{};
+    ctrls[j] = 1.0;
+
+    std::array<double, Degree + 1> left{};
+    for (std::size_t level = 0; level <= Degree; ++level) {
+      left[level] = ctrls[0];
+      for (std::size_t i = 0; i + level < Degree; ++i) {
+        ctrls[i] += last * (ctrls[i + 1] - ctrls[i]);
+      }
+    }
+    double const t = last > 0.0 ? first / last : 0.0;
+    for (std::size_t level = 0; level <= Degree; ++level) {
+      for (std::size_t i = 0; i + level < Degree; ++i) {
+        left[i] += t * (left[i + 1] - left[i]);
+      }
+    }
+    for (std::size_t i = 0; i <= Degree; ++i) {
+      retval[i][j] = left[i];
+    }
+  }
+  return retval;
+}
+
+/* Elevating the reduced control points back to From and subtracting the
+ * original ones gives the control points of the difference curve. Its
+ * distance from zero is bounded by the longest of them, as it lies in their
+ * hull; they overestimate it by much, so the rows give those of the
+ * difference curve over Pieces equal parts of [0, 1], whose hulls hug it
+ * closer. Stored transposed, one column per control point of the curve. */
+template <std::size_t From, std::size_t To, std::size_t Pieces, std::floating_point T>
+requires (To >= 1 && To < From)
+[[nodiscard]] consteval degree_matrix<T, From + 1, Pieces * (From + 1)>
+create_reduction_residual_matrix() noexcept
+{
+  constexpr auto elevation = create_elevation_matrix<To, From, double>();
+  constexpr auto reduction = create_reduction_matrix<From, To, double>();
+
+  degree_matrix<double, From + 1, From + 1> residual{};
+  for (std::size_t i = 0; i <= From; ++i) {
+    for (std::size_t j = 0; j <= From; ++j) {
+      residual[i][j] = i == j ? -1.0 : 0.0;
+      for (std::size_t k = 0; k <= To; ++k) {
+        residual[i][j] += elevation[i][k] * reduction[k][j];
+      }
+    }
+  }
+
+  degree_matrix<T, From + 1, Pieces * (From + 1)> retval{};
+  for (std::size_t piece = 0; piece < Pieces; ++piece) {
+    auto const restriction = create_restriction_matrix<From>(
+      static_cast<double>(piece) / Pieces, static_cast<double>(piece + 1) / Pieces);
+    for (std::size_t i = 0; i <= From; ++i) {
+      for (std::size_t j = 0; j <= From; ++j) {
+        double sum = 0.0;
+        for (std::size_t k = 0; k <= From; ++k) {
+          sum += restriction[i][k] * residual[k][j];
+        }
+        retval[j][piece * (From + 1) + i] = static_cast<T>(sum);
+      }
+    }
+  }
+  return retval;
+}
+
+template <std::size_t From, std::size_t To, std::floating_point T>
+inline constexpr auto elevation_matrix = create_elevation_matrix<From, To, T>();
+
+template <std::size_t From, std::size_t To, std::floating_point T>
+inline constexpr auto reduction_matrix = create_reduction_matrix<From, To, T>();
+
+template <std::size_t From, std::size_t To, std::floating_point T>
+inline constexpr auto reduction_residual_matrix = create_reduction_residual_matrix<From, To, 8, T>();
+
+/* ctrls times the matrix, coordinate by coordinate; the rows accumulate
+ * side by side rather than one after another, so the sums do not wait on
+ * each other and vectorize */
+template <concepts::point Point, typename T, std::size_t Rows, std::size_t Cols>
+[[nodiscard]] constexpr std::array<Point, Rows>
+transform_ctrls(degree_matrix<T, Rows, Cols> const & m, std::array<Point, Cols> const & ctrls) noexcept
+{
+  std::array<Point, Rows> retval{};
+  [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+    auto helper = [&]<std::size_t K>(std::integral_constant<std::size_t, K>) {
+      std::array<T, Rows> sums{};
+      for (std::size_t j = 0; j < Cols; ++j) {
+        T const component = get<K>(ctrls[j]);
+        for (std::size_t i = 0; i < Rows; ++i) {
+          sums[i] += m[i][j] * component;
+        }
+      }
+      for (std::size_t i = 0; i < Rows; ++i) {
+        set<K>(retval[i], sums[i]);
+      }
+    };
+    (..., helper(std::integral_constant<std::size_t, Ks>{}));
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+  return retval;
+}
+
+/* the longest residual, a control point of the difference curve, bounds the
+ * distance between the curves at every parameter */
+template <std::size_t From, std::size_t To, concepts::point Point, typename T = traits::value_type_t<Point>>
+[[nodiscard]] T
+reduction_error(std::array<Point, From + 1> const & ctrls) noexcept
+{
+  constexpr auto const & residual = reduction_residual_matrix<From, To, T>;
+  constexpr std::size_t rows = residual[0].size();
+
+  std::array<T, rows> squared_lengths{};
+  [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+    auto helper = [&]<std::size_t K>(std::integral_constant<std::size_t, K>) {
+      std::array<T, rows> components{};
+      for (std::size_t j = 0; j <= From; ++j) {
+        T const component = get<K>(ctrls[j]);
+        for (std::size_t i = 0; i < rows; ++i) {
+          components[i] += residual[j][i] * component;
+        }
+      }
+      for (std::size_t i = 0; i < rows; ++i) {
+        squared_lengths[i] += components[i] * components[i];
+      }
+    };
+    (..., helper(std::integral_constant<std::size_t, Ks>{}));
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+  return std::sqrt(*std::max_element(squared_lengths.begin(), squared_lengths.end()));
+}
+
+/***************************** result types ********************************/
+
+/* the Bezier of degree NewDegree stored like Bezier; curves adapted through
+ * the traits become InlineBeziers, which do not allocate */
+template <typename Bezier, std::size_t NewDegree>
+struct rebind_degree
+{
+  using type = InlineBezier<NewDegree, ctrl_point_t<Bezier>>;
+};
+
+template <std::size_t Degree, typename Point, typename Cont, std::size_t NewDegree>
+struct rebind_degree<Bezier<Degree, Point, Cont>, NewDegree>
+{
+  using type = Bezier<NewDegree, Point, Cont>;
+};
+
+template <std::size_t Degree, typename Point, std::size_t NewDegree>
+struct rebind_degree<Bezier<Degree, Point, InlineVector<Point, Degree + 1>>, NewDegree>
+{
+  using type = InlineBezier<NewDegree, Point>;
+};
+
+template <std::size_t Degree, typename Point, std::size_t NewDegree>
+struct rebind_degree<Bezier<Degree, Point, std::array<Point, Degree + 1>>, NewDegree>
+{
+  using type = Bezier<NewDegree, Point, std::array<Point, NewDegree + 1>>;
+};
+
+template <typename Bezier, std::size_t NewDegree>
+using rebind_degree_t = typename rebind_degree<Bezier, NewDegree>::type;
+
+template <typename Result, concepts::point Point, std::size_t N>
+[[nodiscard]] constexpr Result
+make_bezier(std::array<Point, N> const & ctrls)
+{
+  if constexpr (concepts::array<decltype(Result::ctrls)>) {
+    return Result(ctrls);
+  } else {
+    return Result(ctrls.cbegin(), ctrls.cend());
+  }
+}
+
+/***************************** batches ********************************/
+
+template <typename T>
+struct is_variant : std::false_type
+{};
+
+template <typename... Ts>
+struct is_variant<std::variant<Ts...>> : std::true_type
+{};
+
+/* appends the curve as one of the degree of the batch, returns the bound of
+ * the reduction error, zero if it was elevated */
+template <std::size_t Degree, std::floating_point T, std::size_t Dim, typename Curve>
+T
+push_normalized(BezierBatch<Degree, T, Dim> & batch, Curve const & curve)
+{
+  if constexpr (is_variant<Curve>::value) {
+    return std::visit([&](auto const & alternative) { return push_normalized(batch, alternative); }, curve);
+  } else if constexpr (concepts::line<Curve>) {
+    std::array const ctrls{curve.start, curve.end};
+    auto const elevated = transform_ctrls(elevation_matrix<1, Degree, T>, ctrls);
+    batch.push_back(BezierView<Degree, typename decltype(ctrls)::value_type>{elevated.data()});
+    return T{};
+  } else {
+    constexpr std::size_t from = traits::degree_v<Curve>;
+    auto const ctrls = copy_ctrls(curve);
+    using Point = typename decltype(ctrls)::value_type;
+    if constexpr (from <= Degree) {
+      auto const elevated = transform_ctrls(elevation_matrix<from, Degree, T>, ctrls);
+      batch.push_back(BezierView<Degree, Point>{elevated.data()});
+      return T{};
+    } else {
+      auto const reduced = transform_ctrls(reduction_matrix<from, Degree, T>, ctrls);
+      batch.push_back(BezierView<Degree, Point>{reduced.data()});
+      return reduction_error<from, Degree>(ctrls);
+    }
+  }
+}
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,332 @@
+#ifndef GEO_DETAIL_BEZIER_FIT_HPP
+#define GEO_DETAIL_BEZIER_FIT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../point.hpp"
+#include "../traits.hpp"
+#include "detail_bezier.hpp"
+#include "detail_spatial_sort.hpp"
+
+namespace geo::detail {
+
+/* Solves the symmetric positive semi-definite system m x = rhs in place by
+ * Gaussian elimination with partial pivoting. The size is known at compile
+ * time, so the loops unroll and nothing is allocated. False if m is
+ * singular. */
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr bool
+solve_normal_equations(std::array<std::array<T, N>, N> & m, std::array<T, N> & rhs) noexcept
+{
+  T scale{};
+  for (std::size_t i = 0; i < N; ++i) {
+    scale = std::max(scale, std::abs(m[i][i]));
+  }
+  T const tiny = scale * std::numeric_limits<T>::epsilon() * static_cast<T>(16 * N);
+
+  for (std::size_t col = 0; col < N; ++col) {
+    std::size_t pivot = col;
+    for (std::size_t row = col + 1; row < N; ++row) {
+      if (std::abs(m[row][col]) > std::abs(m[pivot][col])) {
+        pivot = row;
+      }
+    }
+    if (!(std::abs(m[pivot][col]) > tiny)) {
+      return false;
+    }
+    std::swap(m[col], m[pivot]);
+    std::swap(rhs[col], rhs[pivot]);
+    for (std::size_t row = col + 1; row < N; ++row) {
+      T const factor = m[row][col] / m[col][col];
+      for (std::size_t k = col; k < N; ++k) {
+        m[row][k] -= factor * m[col][k];
+      }
+      rhs[row] -= factor * rhs[col];
+    }
+  }
+  for (std::size_t col = N; col-- > 0;) {
+    for (std::size_t k = col + 1; k < N; ++k) {
+      rhs[col] -= m[col][k] * rhs[k];
+    }
+    rhs[col] /= m[col][col];
+  }
+  return true;
+}
+
+/* Fits piecewise Bezier curves of Degree to a polyline after Schneider, "An
+ * Algorithm for Automatically Fitting Digitized Curves" (Graphics Gems,
+ * 1990), generalized from cubics. Per piece the ends are fixed and the
+ * tangents at them given, which keeps the pieces G1 continuous: control
+ * point 1 and Degree - 1 lie on the tangents, at distances a1 and a2, the
+ * ones between are free. Least squares over the points at their parameters
+ * gives normal equations in a1, a2 and the free coordinates, a system of
+ * fixed size. A fit within tolerance is kept; a near miss gets its
+ * parameters improved by Newton steps towards the closest curve points and
+ * is fitted again; otherwise the piece is split at the worst point. */
+template <std::size_t Degree, typename T, std::size_t Dim>
+requires (Degree >= 3)
+class bezier_fitter
+{
+public:
+  using coordinates = std::array<T, Dim>;
+  using ctrls_type = std::array<coordinates, Degree + 1>;
+
+  static constexpr std::size_t unknowns = 2 + Dim * (Degree - 3);
+
+  /* calls emit(ctrls) for the pieces of the polyline in order */
+  template <typename Emit>
+  void
+  fit(std::span<coordinates const> points, T tolerance, Emit && emit)
+  {
+    if (points.size() < 2) {
+      return;
+    }
+    points_ = points;
+    T const squared_tolerance = tolerance * tolerance;
+
+    std::size_t const last = points.size() - 1;
+    pending_.clear();
+    pending_.push_back({0, last, tangent(0, 1), tangent(last, last - 1)});
+    while (!pending_.empty()) {
+      auto const piece = pending_.back();
+      pending_.pop_back();
+
+      chord_parameters(piece.first, piece.last);
+      ctrls_type ctrls = generate(piece);
+      auto [error, split] = max_error(ctrls, piece);
+      if (error > squared_tolerance && error <= 16 * squared_tolerance) {
+        for (int iteration = 0; iteration < 4 && error > squared_tolerance; ++iteration) {
+          reparameterize(ctrls, piece);
+          ctrls = generate(piece);
+          std::tie(error, split) = max_error(ctrls, piece);
+        }
+      }
+      if (error <= squared_tolerance) {
+        emit(ctrls);
+        continue;
+      }
+
+      coordinates center = difference(points_[split - 1], points_[split + 1]);
+      if (!normalize(center)) {
+        center = tangent(split, split - 1);
+      }
+      coordinates const opposite = scaled(center, T{-1});
+      pending_.push_back({split, piece.last, opposite, piece.end_tangent});
+      pending_.push_back({piece.first, split, piece.start_tangent, center});
+    }
+  }
+
+private:
+  struct piece_type
+  {
+    std::size_t first;
+    std::size_t last;
+    coordinates start_tangent;
+    coordinates end_tangent;
+  };
+
+  [[nodiscard]] static constexpr coordinates
+  difference(coordinates const & lhs, coordinates const & rhs) noexcept
+  {
+    coordinates retval{};
+    for (std::size_t d = 0; d < Dim; ++d) {
+      retval[d] = lhs[d] - rhs[d];
+    }
+    return retval;
+  }
+
+  [[nodiscard]] static constexpr coordinates
+  scaled(coordinates const & v, T factor) noexcept
+  {
+    coordinates retval{};
+    for (std::size_t d = 0; d < Dim; ++d) {
+      retval[d] = v[d] * factor;
+    }
+    return retval;
+  }
+
+  [[nodiscard]] static constexpr T
+  dot(coordinates const & lhs, coordinates const & rhs) noexcept
+  {
+    T retval{};
+    for (std::size_t d = 0; d < Dim; ++d) {
+      retval += lhs[d] * rhs[d];
+    }
+    return retval;
+  }
+
+  static bool
+  normalize(coordinates & v) noexcept
+  {
+    T const length = std::sqrt(dot(v, v));
+    if (!(length > 0)) {
+      return false;
+    }
+    v = scaled(v, 1 / length);
+    return true;
+  }
+
+  /* unit direction from point from towards the first distinct point in the
+   * direction of towards, zero if there is none */
+  [[nodiscard]] coordinates
+  tangent(std::size_t from, std::size_t towards) const noexcept
+  {
+    std::ptrdiff_t const step = towards > from ? 1 : -1;
+    auto const end = static_cast<std::ptrdiff_t>(towards > from ? points_.size() : 0) - (towards > from ? 0 : 1);
+    for (auto i = static_cast<std::ptrdiff_t>(towards); i != end; i += step) {
+      coordinates v = difference(points_[static_cast<std::size_t>(i)], points_[from]);
+      if (normalize(v)) {
+        return v;
+      }
+    }
+    return {};
+  }
+
+  /* parameters proportional to the arc length along the polyline */
+  void
+  chord_parameters(std::size_t first, std::size_t last)
+  {
+    parameters_.resize(last - first + 1);
+    parameters_[0] = T{};
+    for (std::size_t i = first + 1; i <= last; ++i) {
+      coordinates const step = difference(points_[i], points_[i - 1]);
+      parameters_[i - first] = parameters_[i - first - 1] + std::sqrt(dot(step, step));
+    }
+    T const length = parameters_.back();
+    for (std::size_t i = 1; i < parameters_.size(); ++i) {
+      parameters_[i] = length > 0 ? parameters_[i] / length : static_cast<T>(i) / static_cast<T>(parameters_.size() - 1);
+    }
+    parameters_.back() = T{1};
+  }
+
+  [[nodiscard]] ctrls_type
+  generate(piece_type const & piece) const noexcept
+  {
+    coordinates const & start = points_[piece.first];
+    coordinates const & end = points_[piece.last];
+
+    std::array<std::array<T, unknowns>, unknowns> m{};
+    std::array<T, unknowns> rhs{};
+    for (std::size_t i = piece.first + 1; i < piece.last; ++i) {
+      auto const w = bernstein_weights<Degree>(parameters_[i - piece.first]);
+      for (std::size_t d = 0; d < Dim; ++d) {
+        /* the row of the design matrix for coordinate d of point i */
+        std::array<T, unknowns> row{};
+        row[0] = w[1] * piece.start_tangent[d];
+        row[1] = w[Degree - 1] * piece.end_tangent[d];
+        for (std::size_t j = 2; j + 1 < Degree; ++j) {
+          row[2 + (j - 2) * Dim + d] = w[j];
+        }
+        T const residual = points_[i][d] - (w[0] + w[1]) * start[d] - (w[Degree - 1] + w[Degree]) * end[d];
+        for (std::size_t a = 0; a < unknowns; ++a) {
+          for (std::size_t b = 0; b < unknowns; ++b) {
+            m[a][b] += row[a] * row[b];
+          }
+          rhs[a] += row[a] * residual;
+        }
+      }
+    }
+
+    /* too few points, or tangents turned backwards: Schneider's fallback,
+     * tangent handles a fraction of the chord */
+    coordinates const chord = difference(end, start);
+    T const chord_length = std::sqrt(dot(chord, chord));
+    T const shortest = chord_length * std::numeric_limits<T>::epsilon() * 16;
+    bool const solved = solve_normal_equations(m, rhs) && rhs[0] > shortest && rhs[1] > shortest;
+
+    ctrls_type ctrls{};
+    ctrls[0] = start;
+    ctrls[Degree] = end;
+    T const a1 = solved ? rhs[0] : chord_length / Degree;
+    T const a2 = solved ? rhs[1] : chord_length / Degree;
+    for (std::size_t d = 0; d < Dim; ++d) {
+      ctrls[1][d] = start[d] + a1 * piece.start_tangent[d];
+      ctrls[Degree - 1][d] = end[d] + a2 * piece.end_tangent[d];
+    }
+    for (std::size_t j = 2; j + 1 < Degree; ++j) {
+      for (std::size_t d = 0; d < Dim; ++d) {
+        ctrls[j][d] = solved ? rhs[2 + (j - 2) * Dim + d]
+                             : ctrls[1][d] + (ctrls[Degree - 1][d] - ctrls[1][d]) * static_cast<T>(j - 1) / static_cast<T>(Degree - 2);
+      }
+    }
+    return ctrls;
+  }
+
+  template <std::size_t N>
+  [[nodiscard]] static constexpr coordinates
+  combine(std::array<T, N + 1> const & weights, std::array<coordinates, N + 1> const & ctrls) noexcept
+  {
+    coordinates retval{};
+    for (std::size_t j = 0; j <= N; ++j) {
+      for (std::size_t d = 0; d < Dim; ++d) {
+        retval[d] += weights[j] * ctrls[j][d];
+      }
+    }
+    return retval;
+  }
+
+  /* largest squared distance of a point in [from, to) from the curve at its
+   * parameter, and that point */
+  [[nodiscard]] std::pair<T, std::size_t>
+  max_error(ctrls_type const & ctrls, piece_type const & piece, std::size_t from, std::size_t to) const noexcept
+  {
+    T error{};
+    std::size_t split = (piece.first + piece.last) / 2;
+    for (std::size_t i = from; i < to; ++i) {
+      coordinates const offset = difference(combine<Degree>(bernstein_weights<Degree>(parameters_[i - piece.first]), ctrls), points_[i]);
+      T const squared_distance = dot(offset, offset);
+      if (squared_distance > error) {
+        error = squared_distance;
+        split = i;
+      }
+    }
+    return {error, split};
+  }
+
+  [[nodiscard]] std::pair<T, std::size_t>
+  max_error(ctrls_type const & ctrls, piece_type const & piece) const noexcept
+  {
+    return max_error(ctrls, piece, piece.first + 1, piece.last);
+  }
+
+  /* one Newton step per point on (Q(u) - p) . Q'(u) = 0 */
+  void
+  reparameterize(ctrls_type const & ctrls, piece_type const & piece) noexcept
+  {
+    std::array<coordinates, Degree> first_derivative{};
+    for (std::size_t j = 0; j < Degree; ++j) {
+      first_derivative[j] = scaled(difference(ctrls[j + 1], ctrls[j]), static_cast<T>(Degree));
+    }
+    std::array<coordinates, Degree - 1> second_derivative{};
+    for (std::size_t j = 0; j + 1 < Degree; ++j) {
+      second_derivative[j] = scaled(difference(first_derivative[j + 1], first_derivative[j]), static_cast<T>(Degree - 1));
+    }
+
+    for (std::size_t i = piece.first + 1; i < piece.last; ++i) {
+      T & u = parameters_[i - piece.first];
+      coordinates const offset = difference(combine<Degree>(bernstein_weights<Degree>(u), ctrls), points_[i]);
+      coordinates const d1 = combine<Degree - 1>(bernstein_weights<Degree - 1>(u), first_derivative);
+      coordinates const d2 = combine<Degree - 2>(bernstein_weights<Degree - 2>(u), second_derivative);
+      T const denominator = dot(d1, d1) + dot(offset, d2);
+      if (denominator != 0) {
+        u = std::clamp(u - dot(offset, d1) / denominator, T{}, T{1});
+      }
+    }
+  }
+
+  std::span<coordinates const> points_{};
+  std::vector<T> parameters_{};
+  std::vector<piece_type> pending_{};
+};
+
+} // namespace geo::detail
+
+#endif
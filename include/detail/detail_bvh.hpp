@@ -0,0 +1,43 @@
+#ifndef GEO_DETAIL_BVH_HPP
+#define GEO_DETAIL_BVH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../box.hpp"
+#include "../point.hpp"
+#include "../traits.hpp"
+
+namespace geo::detail {
+
+/* Half the perimeter in 2D, half the surface area in 3D. The chance that a
+ * random ray or small box hits a node is proportional to it, so it is the
+ * cost a tree minimizes. */
+template <concepts::point Point>
+[[nodiscard]] constexpr traits::value_type_t<Point>
+box_measure(Box<Point> const & box) noexcept
+{
+  auto const dx = get<0>(box.upper) - get<0>(box.lower);
+  auto const dy = get<1>(box.upper) - get<1>(box.lower);
+  if constexpr (traits::dimension_v<Point> == 2) {
+    return dx + dy;
+  } else {
+    auto const dz = get<2>(box.upper) - get<2>(box.lower);
+    return dx * dy + dy * dz + dz * dx;
+  }
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr Box<Point>
+inflate(Box<Point> const & box, traits::value_type_t<Point> margin) noexcept
+{
+  return {coordinatewise(box.lower, box.lower, [margin](auto a, auto) { return a - margin; }),
+          coordinatewise(box.upper, box.upper, [margin](auto a, auto) { return a + margin; })};
+}
+
+template <typename Object>
+using bounding_box_t = std::remove_cvref_t<decltype(geo::bounding_box(std::declval<Object const &>()))>;
+
+} // namespace geo::detail
+
+#endif
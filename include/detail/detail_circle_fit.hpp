@@ -0,0 +1,273 @@
+#ifndef GEO_DETAIL_CIRCLE_FIT_HPP
+#define GEO_DETAIL_CIRCLE_FIT_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../circle.hpp"
+#include "../point.hpp"
+#include "../traits.hpp"
+#include "detail_execution.hpp"
+
+namespace geo::detail {
+
+/***************************** minimum enclosing circle ********************************/
+
+template <typename T>
+struct disk
+{
+  T x;
+  T y;
+  T squared_radius;
+};
+
+template <concepts::point Point, typename T = traits::value_type_t<Point>>
+[[nodiscard]] constexpr bool
+covers(disk<T> const & d, Point const & p) noexcept
+{
+  /* the circles through two or three points miss them by rounding, by an
+   * amount that grows with the coordinates of the center as well as with
+   * the radius */
+  constexpr T slack = 128 * std::numeric_limits<T>::epsilon();
+  T const dx = get<0>(p) - d.x;
+  T const dy = get<1>(p) - d.y;
+  return dx * dx + dy * dy <= d.squared_radius + slack * (d.squared_radius + d.x * d.x + d.y * d.y);
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+coincident(Point const & a, Point const & b) noexcept
+{
+  return get<0>(a) == get<0>(b) && get<1>(a) == get<1>(b);
+}
+
+template <concepts::point Point, typename T = traits::value_type_t<Point>>
+[[nodiscard]] constexpr disk<T>
+diameter_disk(Point const & a, Point const & b) noexcept
+{
+  T const dx = (get<0>(b) - get<0>(a)) / 2;
+  T const dy = (get<1>(b) - get<1>(a)) / 2;
+  return {get<0>(a) + dx, get<1>(a) + dy, dx * dx + dy * dy};
+}
+
+/* circumcircle; for three collinear points, which only rounding lets
+ * Welzl's algorithm ask for, the circle over the farthest two */
+template <concepts::point Point, typename T = traits::value_type_t<Point>>
+[[nodiscard]] constexpr disk<T>
+circum_disk(Point const & a, Point const & b, Point const & c) noexcept
+{
+  T const bx = get<0>(b) - get<0>(a), by = get<1>(b) - get<1>(a);
+  T const cx = get<0>(c) - get<0>(a), cy = get<1>(c) - get<1>(a);
+  T const d = 2 * (bx * cy - by * cx);
+  if (d == 0) {
+    auto widest = diameter_disk(a, b);
+    for (auto const & candidate : {diameter_disk(a, c), diameter_disk(b, c)}) {
+      if (candidate.squared_radius > widest.squared_radius) {
+        widest = candidate;
+      }
+    }
+    return widest;
+  }
+  T const bl = bx * bx + by * by;
+  T const cl = cx * cx + cy * cy;
+  T const ux = (cy * bl - by * cl) / d;
+  T const uy = (bx * cl - cx * bl) / d;
+  return {get<0>(a) + ux, get<1>(a) + uy, ux * ux + uy * uy};
+}
+
+/* Fisher-Yates with a splitmix64 stream: a fixed seed keeps results
+ * reproducible while still defeating adversarial input orders */
+template <typename T>
+void
+shuffle(std::vector<T> & items, std::uint64_t seed) noexcept
+{
+  for (std::size_t i = items.size(); i > 1; --i) {
+    seed += 0x9E3779B97F4A7C15u;
+    std::uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    z ^= z >> 31;
+    std::swap(items[i - 1], items[z % i]);
+  }
+}
+
+/* Welzl's algorithm in its iterative form: in random order, a point outside
+ * the circle of those before it lies on the circle of them and it, which
+ * happens with probability at most 3 / i, so the expected time is linear.
+ * Expects scratch to hold the points and reorders and translates it: far
+ * from the origin the rounding of the center would swamp the differences
+ * between the points, so they are taken relative to the first one. A point
+ * coincident with one the circle is built on is on that circle already, and
+ * is not used to build another. */
+template <concepts::point Point>
+[[nodiscard]] Circle<Point>
+min_enclosing_circle(std::vector<Point> & scratch)
+{
+  using T = traits::value_type_t<Point>;
+
+  if (scratch.empty()) {
+    throw std::invalid_argument("empty point range");
+  }
+  T const origin_x = get<0>(scratch[0]);
+  T const origin_y = get<1>(scratch[0]);
+  for (auto & point : scratch) {
+    set<0>(point, get<0>(point) - origin_x);
+    set<1>(point, get<1>(point) - origin_y);
+  }
+  shuffle(scratch, scratch.size());
+
+  auto const & p = scratch;
+  disk<T> d{get<0>(p[0]), get<1>(p[0]), T{}};
+  for (std::size_t i = 1; i < p.size(); ++i) {
+    if (covers(d, p[i])) {
+      continue;
+    }
+    d = {get<0>(p[i]), get<1>(p[i]), T{}};
+    for (std::size_t j = 0; j < i; ++j) {
+      if (covers(d, p[j])) {
+        continue;
+      }
+      d = diameter_disk(p[i], p[j]);
+      for (std::size_t k = 0; k < j; ++k) {
+        if (!covers(d, p[k]) && !coincident(p[k], p[i]) && !coincident(p[k], p[j])) {
+          d = circum_disk(p[i], p[j], p[k]);
+        }
+      }
+    }
+  }
+
+  Point center{};
+  set<0>(center, d.x + origin_x);
+  set<1>(center, d.y + origin_y);
+  return {center, std::sqrt(d.squared_radius)};
+}
+
+/***************************** algebraic circle fit ********************************/
+
+/* Algebraic fits minimize the residuals of A(x^2 + y^2) + Bx + Cy + D = 0 over
+ * the centered moments of the points. Kasa's fit fixes A = 1 and solves a linear
+ * system; it is fast but draws circles fitted to short arcs too small.
+ * Pratt's fit normalizes by the gradient, B^2 + C^2 - 4AD = 1, which removes
+ * most of that bias; the constraint adds a root of a quartic, found by
+ * Newton's method from zero (Chernov, Circular and Linear Regression, 2010),
+ * which is Kasa's solution. */
+template <concepts::point Point, std::random_access_iterator It>
+[[nodiscard]] Circle<Point>
+fit_circle(It first, It last, bool pratt)
+{
+  using T = traits::value_type_t<Point>;
+
+  auto const n = static_cast<std::size_t>(last - first);
+  if (n < 3) {
+    throw std::invalid_argument("fitting a circle needs three points");
+  }
+
+  T mean_x{}, mean_y{};
+  for (It it = first; it != last; ++it) {
+    mean_x += get<0>(*it);
+    mean_y += get<1>(*it);
+  }
+  mean_x /= static_cast<T>(n);
+  mean_y /= static_cast<T>(n);
+
+  T mxx{}, myy{}, mxy{}, mxz{}, myz{}, mzz{};
+  for (It it = first; it != last; ++it) {
+    T const x = get<0>(*it) - mean_x;
+    T const y = get<1>(*it) - mean_y;
+    T const z = x * x + y * y;
+    mxx += x * x;
+    myy += y * y;
+    mxy += x * y;
+    mxz += x * z;
+    myz += y * z;
+    mzz += z * z;
+  }
+  for (T * m : {&mxx, &myy, &mxy, &mxz, &myz, &mzz}) {
+    *m /= static_cast<T>(n);
+  }
+
+  T const mz = mxx + myy;
+  T const cov_xy = mxx * myy - mxy * mxy;
+  T root{};
+  if (pratt) {
+    T const a2 = 4 * cov_xy - 3 * mz * mz - mzz;
+    T const a1 = mzz * mz + 4 * cov_xy * mz - mxz * mxz - myz * myz - mz * mz * mz;
+    T const a0 = mxz * mxz * myy + myz * myz * mxx - mzz * cov_xy - 2 * mxz * myz * mxy + mz * mz * cov_xy;
+    T value = std::numeric_limits<T>::max();
+    for (int iteration = 0; iteration < 20; ++iteration) {
+      T const previous = value;
+      value = a0 + root * (a1 + root * (a2 + 4 * root * root));
+      if (std::abs(value) > std::abs(previous)) {
+        root = T{};
+        break;
+      }
+      T const slope = a1 + root * (2 * a2 + 16 * root * root);
+      T const step = value / slope;
+      root -= step;
+      if (!(root > T{})) {
+        root = T{};
+        break;
+      }
+      if (std::abs(step) <= root * std::numeric_limits<T>::epsilon() * 16) {
+        break;
+      }
+    }
+  }
+
+  T const det = 2 * (root * root - root * mz + cov_xy);
+  T const cx = (mxz * (myy - root) - myz * mxy) / det;
+  T const cy = (myz * (mxx - root) - mxz * mxy) / det;
+  T const squared_radius = cx * cx + cy * cy + mz + 2 * root;
+  if (!std::isfinite(cx) || !std::isfinite(cy) || !(squared_radius >= T{})) {
+    throw std::invalid_argument("points are collinear");
+  }
+
+  Point center{};
+  set<0>(center, cx + mean_x);
+  set<1>(center, cy + mean_y);
+  return {center, std::sqrt(squared_radius)};
+}
+
+/***************************** batches ********************************/
+
+/* Calls f(first, last, scratch) for each cluster [points[offsets[c]],
+ * points[offsets[c + 1]]) and collects the results. */
+template <bool Parallel, typename Range, typename Offsets, typename F>
+[[nodiscard]] auto
+for_each_cluster(Range const & points, Offsets const & offsets, F f)
+{
+  using Point = std::ranges::range_value_t<Range>;
+  using Result = decltype(f(std::ranges::begin(points), std::ranges::begin(points), std::declval<std::vector<Point> &>()));
+
+  std::size_t const clusters = std::ranges::size(offsets) == 0 ? 0 : std::ranges::size(offsets) - 1;
+  std::vector<Result> results(clusters);
+  auto const work = [&](std::size_t first, std::size_t last) {
+    std::vector<Point> scratch;
+    for (std::size_t c = first; c < last; ++c) {
+      auto const begin = static_cast<std::size_t>(std::ranges::begin(offsets)[static_cast<std::ptrdiff_t>(c)]);
+      auto const end = static_cast<std::size_t>(std::ranges::begin(offsets)[static_cast<std::ptrdiff_t>(c + 1)]);
+      if (begin > end || end > std::ranges::size(points)) {
+        throw std::invalid_argument("invalid cluster offsets");
+      }
+      auto const base = std::ranges::begin(points);
+      results[c] = f(base + static_cast<std::ptrdiff_t>(begin), base + static_cast<std::ptrdiff_t>(end), scratch);
+    }
+  };
+  if constexpr (Parallel) {
+    parallel_for(clusters, work);
+  } else {
+    work(0, clusters);
+  }
+  return results;
+}
+
+} // namespace geo::detail
+
+#endif
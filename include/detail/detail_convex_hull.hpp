@@ -0,0 +1,479 @@
+#ifndef GEO_DETAIL_CONVEX_HULL_HPP
+#define GEO_DETAIL_CONVEX_HULL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../algebra.hpp"
+#include "../point.hpp"
+#include "../predicates.hpp"
+#include "../traits.hpp"
+#include "detail_execution.hpp"
+
+namespace geo::detail {
+
+/***************************** 2D ********************************/
+
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+lexicographic_less(Point const & lhs, Point const & rhs) noexcept
+{
+  return get<0>(lhs) < get<0>(rhs) || (get<0>(lhs) == get<0>(rhs) && get<1>(lhs) < get<1>(rhs));
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+coincide(Point const & lhs, Point const & rhs) noexcept
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (... && (get<Is>(lhs) == get<Is>(rhs)));
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+}
+
+/* Andrew's monotone chain over lexicographically sorted points, appends the
+ * strictly convex hull in counter-clockwise order to hull */
+template <concepts::point Point>
+void
+monotone_chain(std::vector<Point> & points, std::vector<Point> & hull)
+{
+  auto const unique = std::ranges::unique(points, coincide<Point>);
+  points.erase(unique.begin(), unique.end());
+  if (points.size() < 3) {
+    hull.insert(hull.end(), points.begin(), points.end());
+    return;
+  }
+
+  std::size_t const base = hull.size();
+  hull.resize(base + 2 * points.size());
+  std::size_t k = base;
+  auto const add = [&](Point const & point, std::size_t floor) {
+    while (k >= floor + 2 && orientation(hull[k - 2], hull[k - 1], point) <= 0) {
+      --k;
+    }
+    hull[k++] = point;
+  };
+  for (auto const & point : points) {
+    add(point, base);
+  }
+  std::size_t const lower = k - 1;
+  for (std::size_t i = points.size() - 1; i-- > 0;) {
+    add(points[i], lower);
+  }
+  hull.resize(k - 1);
+}
+
+/* extreme points in eight directions, counter-clockwise from the leftmost */
+template <concepts::point Point>
+struct extremes_2d
+{
+  using T = traits::value_type_t<Point>;
+
+  static constexpr std::array<std::array<T, 2>, 8> directions{{
+    {-1, 0}, {-1, -1}, {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}
+  }};
+
+  void
+  update(Point const & point) noexcept
+  {
+    for (std::size_t d = 0; d < directions.size(); ++d) {
+      T const value = directions[d][0] * get<0>(point) + directions[d][1] * get<1>(point);
+      if (!found || value > support[d]) {
+        support[d] = value;
+        vertices[d] = point;
+      }
+    }
+    found = true;
+  }
+
+  void
+  merge(extremes_2d const & other) noexcept
+  {
+    for (std::size_t d = 0; other.found && d < directions.size(); ++d) {
+      if (!found || other.support[d] > support[d]) {
+        support[d] = other.support[d];
+        vertices[d] = other.vertices[d];
+      }
+    }
+    found = found || other.found;
+  }
+
+  std::array<T, 8> support{};
+  std::array<Point, 8> vertices{};
+  bool found{};
+};
+
+/* Akl-Toussaint heuristic: points strictly inside the polygon spanned by
+ * the extreme points cannot be hull vertices. The test runs edge by edge
+ * over blocks of points, so the inner loops are plain arithmetic that
+ * vectorizes. A point is only discarded if the rounded orientation clears
+ * its error bound. Extreme points themselves are always kept. */
+template <typename Range, typename Sink>
+void
+filter_interior_2d(Range const & points, std::size_t first, std::size_t last,
+                   std::array<traits::value_type_t<std::ranges::range_value_t<Range>>, 32> const & edges,
+                   std::size_t edge_count, Sink sink)
+{
+  using T = traits::value_type_t<std::ranges::range_value_t<Range>>;
+
+  constexpr T half_epsilon = std::numeric_limits<T>::epsilon() / 2;
+  constexpr T error_bound = (T{3} + T{16} * half_epsilon) * half_epsilon;
+  constexpr std::size_t block = 256;
+
+  std::array<T, block> xs;
+  std::array<T, block> ys;
+  /* smallest margin by which a point clears an edge, positive if inside */
+  std::array<T, block> slack;
+  for (std::size_t begin = first; begin < last; begin += block) {
+    std::size_t const size = std::min(block, last - begin);
+    for (std::size_t j = 0; j < size; ++j) {
+      xs[j] = get<0>(points[begin + j]);
+      ys[j] = get<1>(points[begin + j]);
+      slack[j] = std::numeric_limits<T>::max();
+    }
+    for (std::size_t e = 0; e < edge_count; ++e) {
+      T const ax = edges[4 * e];
+      T const ay = edges[4 * e + 1];
+      T const dx = edges[4 * e + 2];
+      T const dy = edges[4 * e + 3];
+      for (std::size_t j = 0; j < size; ++j) {
+        T const left = dx * (ys[j] - ay);
+        T const right = dy * (xs[j] - ax);
+        T const margin = (left - right) - error_bound * (std::abs(left) + std::abs(right));
+        slack[j] = std::min(slack[j], margin);
+      }
+    }
+    for (std::size_t j = 0; j < size; ++j) {
+      if (!(slack[j] > T{})) {
+        sink(points[begin + j]);
+      }
+    }
+  }
+}
+
+template <bool Parallel, typename Range>
+[[nodiscard]] auto
+hull_candidates_2d(Range const & points)
+{
+  using Point = std::ranges::range_value_t<Range>;
+  using T = traits::value_type_t<Point>;
+
+  std::size_t const size = std::ranges::size(points);
+  std::mutex mutex;
+
+  extremes_2d<Point> extremes;
+  auto const find_extremes = [&](std::size_t first, std::size_t last) {
+    extremes_2d<Point> local;
+    for (std::size_t i = first; i < last; ++i) {
+      local.update(points[i]);
+    }
+    std::lock_guard const lock(mutex);
+    extremes.merge(local);
+  };
+  if constexpr (Parallel) {
+    parallel_for(size, find_extremes);
+  } else {
+    find_extremes(0, size);
+  }
+
+  /* edges of the extreme polygon as (start x, start y, dx, dy) */
+  std::array<T, 32> edges{};
+  std::size_t edge_count = 0;
+  for (std::size_t d = 0; d < 8; ++d) {
+    auto const & a = extremes.vertices[d];
+    auto const & b = extremes.vertices[(d + 1) % 8];
+    if (!coincide(a, b)) {
+      edges[4 * edge_count] = get<0>(a);
+      edges[4 * edge_count + 1] = get<1>(a);
+      edges[4 * edge_count + 2] = get<0>(b) - get<0>(a);
+      edges[4 * edge_count + 3] = get<1>(b) - get<1>(a);
+      ++edge_count;
+    }
+  }
+
+  std::vector<Point> candidates;
+  if (edge_count < 3) {
+    candidates.assign(std::ranges::begin(points), std::ranges::end(points));
+    return candidates;
+  }
+  auto const filter = [&](std::size_t first, std::size_t last) {
+    std::vector<Point> local;
+    filter_interior_2d(points, first, last, edges, edge_count,
+                       [&](Point const & point) { local.push_back(point); });
+    std::lock_guard const lock(mutex);
+    candidates.insert(candidates.end(), local.begin(), local.end());
+  };
+  if constexpr (Parallel) {
+    parallel_for(size, filter);
+  } else {
+    filter(0, size);
+  }
+  return candidates;
+}
+
+/***************************** 3D ********************************/
+
+/* Quickhull over the points, returns outward oriented triangles as index
+ * triples. Visibility is decided with the exact orientation predicate, so
+ * the hull stays convex and the horizon is always a simple cycle. Degenerate
+ * input without volume produces no triangles. */
+template <concepts::point Point>
+[[nodiscard]] std::vector<std::array<std::size_t, 3>>
+quickhull(std::vector<Point> const & points)
+{
+  using T = traits::value_type_t<Point>;
+  using triangle = std::array<std::size_t, 3>;
+
+  struct face
+  {
+    triangle vertices;
+    std::vector<std::size_t> outside;
+    std::size_t farthest;
+    T distance;
+    bool alive;
+  };
+
+  std::size_t const size = points.size();
+  if (size < 4) {
+    return {};
+  }
+
+  auto const above = [&](triangle const & t, std::size_t p) {
+    return orientation(points[t[0]], points[t[1]], points[t[2]], points[p]) > 0;
+  };
+  auto const height = [&](triangle const & t, std::size_t p) {
+    auto const n = vector_product(points[t[1]] - points[t[0]], points[t[2]] - points[t[0]]);
+    return dot_product(n, points[p] - points[t[0]]);
+  };
+
+  /* initial tetrahedron from extreme points */
+  std::size_t i0 = 0;
+  std::size_t i1 = 0;
+  T extent{-1};
+  auto const axis = [&]<std::size_t K>() {
+    auto const [lo, hi] = std::ranges::minmax_element(points, {}, [](Point const & p) { return get<K>(p); });
+    if (get<K>(*hi) - get<K>(*lo) > extent) {
+      extent = get<K>(*hi) - get<K>(*lo);
+      i0 = static_cast<std::size_t>(lo - points.begin());
+      i1 = static_cast<std::size_t>(hi - points.begin());
+    }
+  };
+  axis.template operator()<0>();
+  axis.template operator()<1>();
+  axis.template operator()<2>();
+  if (extent <= T{}) {
+    return {};
+  }
+
+  std::size_t i2 = i0;
+  T best{};
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const n = vector_product(points[i1] - points[i0], points[i] - points[i0]);
+    if (T const d = dot_product(n, n); d > best) {
+      best = d;
+      i2 = i;
+    }
+  }
+  std::size_t i3 = i0;
+  best = T{};
+  for (std::size_t i = 0; i < size; ++i) {
+    T const h = height({i0, i1, i2}, i);
+    T const d = h < T{} ? -h : h;
+    if (d > best && orientation(points[i0], points[i1], points[i2], points[i]) != 0) {
+      best = d;
+      i3 = i;
+    }
+  }
+  if (i2 == i0 || i3 == i0) {
+    return {};
+  }
+
+  std::vector<face> faces;
+  std::unordered_map<std::size_t, std::size_t> edges;
+  auto const edge_key = [size](std::size_t u, std::size_t v) {
+    return u * size + v;
+  };
+  auto const add_face = [&](std::size_t a, std::size_t b, std::size_t c) {
+    faces.push_back({{a, b, c}, {}, 0, T{}, true});
+    std::size_t const index = faces.size() - 1;
+    edges[edge_key(a, b)] = index;
+    edges[edge_key(b, c)] = index;
+    edges[edge_key(c, a)] = index;
+    return index;
+  };
+  auto const assign = [&](std::size_t p, std::size_t first_face) {
+    for (std::size_t f = first_face; f < faces.size(); ++f) {
+      if (faces[f].alive && above(faces[f].vertices, p)) {
+        T const d = height(faces[f].vertices, p);
+        if (faces[f].outside.empty() || d > faces[f].distance) {
+          faces[f].farthest = p;
+          faces[f].distance = d;
+        }
+        faces[f].outside.push_back(p);
+        return;
+      }
+    }
+  };
+
+  std::array const simplex{i0, i1, i2, i3};
+  for (std::size_t skip = 0; skip < 4; ++skip) {
+    std::array<std::size_t, 3> t{};
+    for (std::size_t i = 0, j = 0; i < 4; ++i) {
+      if (i != skip) {
+        t[j++] = simplex[i];
+      }
+    }
+    if (above(t, simplex[skip])) {
+      std::swap(t[1], t[2]);
+    }
+    add_face(t[0], t[1], t[2]);
+  }
+  for (std::size_t p = 0; p < size; ++p) {
+    if (p != i0 && p != i1 && p != i2 && p != i3) {
+      assign(p, 0);
+    }
+  }
+
+  std::vector<std::size_t> pending{0, 1, 2, 3};
+  std::vector<std::size_t> visible;
+  std::vector<std::pair<std::size_t, std::size_t>> horizon;
+  std::vector<std::size_t> orphans;
+  while (!pending.empty()) {
+    std::size_t const start = pending.back();
+    pending.pop_back();
+    if (!faces[start].alive || faces[start].outside.empty()) {
+      continue;
+    }
+    std::size_t const eye = faces[start].farthest;
+
+    /* visible faces form a connected patch around start */
+    visible.assign({start});
+    faces[start].alive = false;
+    horizon.clear();
+    for (std::size_t v = 0; v < visible.size(); ++v) {
+      auto const t = faces[visible[v]].vertices;
+      for (std::size_t e = 0; e < 3; ++e) {
+        std::size_t const u = t[e];
+        std::size_t const w = t[(e + 1) % 3];
+        std::size_t const neighbor = edges.at(edge_key(w, u));
+        if (!faces[neighbor].alive) {
+          continue;
+        }
+        if (above(faces[neighbor].vertices, eye)) {
+          faces[neighbor].alive = false;
+          visible.push_back(neighbor);
+        } else {
+          horizon.emplace_back(u, w);
+        }
+      }
+    }
+
+    orphans.clear();
+    for (std::size_t const f : visible) {
+      auto const & t = faces[f].vertices;
+      for (std::size_t e = 0; e < 3; ++e) {
+        edges.erase(edge_key(t[e], t[(e + 1) % 3]));
+      }
+      for (std::size_t const p : faces[f].outside) {
+        if (p != eye) {
+          orphans.push_back(p);
+        }
+      }
+      std::vector<std::size_t>().swap(faces[f].outside);
+    }
+
+    std::size_t const first_new = faces.size();
+    for (auto const & [u, w] : horizon) {
+      pending.push_back(add_face(u, w, eye));
+    }
+    for (std::size_t const p : orphans) {
+      assign(p, first_new);
+    }
+  }
+
+  std::vector<triangle> retval;
+  for (auto const & f : faces) {
+    if (f.alive) {
+      retval.push_back(f.vertices);
+    }
+  }
+  return retval;
+}
+
+/* Akl-Toussaint in 3D: discards points strictly inside the octahedron
+ * spanned by the six axis extremes, provided the octahedron is convex */
+template <bool Parallel, typename Range>
+[[nodiscard]] auto
+hull_candidates_3d(Range const & points)
+{
+  using Point = std::ranges::range_value_t<Range>;
+
+  std::size_t const size = std::ranges::size(points);
+  std::vector<Point> candidates;
+  if (size == 0) {
+    return candidates;
+  }
+
+  /* min x, max x, min y, max y, min z, max z */
+  std::array<Point, 6> extremes;
+  auto const axis = [&]<std::size_t K>() {
+    auto const [lo, hi] = std::ranges::minmax_element(points, {}, [](Point const & p) { return get<K>(p); });
+    extremes[2 * K] = *lo;
+    extremes[2 * K + 1] = *hi;
+  };
+  axis.template operator()<0>();
+  axis.template operator()<1>();
+  axis.template operator()<2>();
+
+  /* face (x_i, y_j, z_k) of the octahedron, outward oriented */
+  std::array<std::array<Point, 3>, 8> octahedron;
+  for (std::size_t s = 0; s < 8; ++s) {
+    std::size_t const sx = s & 1u;
+    std::size_t const sy = (s >> 1) & 1u;
+    std::size_t const sz = (s >> 2) & 1u;
+    octahedron[s] = {extremes[sx], extremes[2 + sy], extremes[4 + sz]};
+    if ((sx + sy + sz) % 2 == 0) {
+      std::swap(octahedron[s][1], octahedron[s][2]);
+    }
+  }
+  bool convex = true;
+  for (auto const & f : octahedron) {
+    for (auto const & p : extremes) {
+      convex = convex && (orientation(f[0], f[1], f[2], p) < 0
+                          || coincide(p, f[0]) || coincide(p, f[1]) || coincide(p, f[2]));
+    }
+  }
+
+  std::mutex mutex;
+  auto const filter = [&](std::size_t first, std::size_t last) {
+    std::vector<Point> local;
+    for (std::size_t i = first; i < last; ++i) {
+      bool inside = convex;
+      for (std::size_t f = 0; inside && f < octahedron.size(); ++f) {
+        inside = orientation(octahedron[f][0], octahedron[f][1], octahedron[f][2], points[i]) < 0;
+      }
+      if (!inside) {
+        local.push_back(points[i]);
+      }
+    }
+    std::lock_guard const lock(mutex);
+    candidates.insert(candidates.end(), local.begin(), local.end());
+  };
+  if constexpr (Parallel) {
+    parallel_for(size, filter);
+  } else {
+    filter(0, size);
+  }
+  return candidates;
+}
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef GEO_DETAIL_DELAUNAY_HPP
+#define GEO_DETAIL_DELAUNAY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../point.hpp"
+#include "../predicates.hpp"
+#include "../traits.hpp"
+#include "detail_spatial_sort.hpp"
+
+namespace geo::detail {
+
+/* Incremental Bowyer-Watson triangulation over flat index arrays.
+ *
+ * Triangle t owns half-edges 3t, 3t + 1, 3t + 2; half-edge e runs from
+ * vertices[e] to the vertex of the next half-edge of its triangle and
+ * twins[e] is the half-edge running the other way. The hull is closed by
+ * ghost triangles sharing a vertex at infinity, so every half-edge has a twin
+ * and points outside the hull need no special case: the circumcircle of a
+ * ghost triangle is the open half-plane beyond its hull edge plus the open
+ * edge itself. Triangles removed by an insertion leave slots that the next
+ * ones reuse. */
+template <concepts::point Point>
+class delaunay_mesh
+{
+public:
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  /* points are copied in Hilbert order, so the vertices a walk or cavity
+   * touches are close in memory as well */
+  explicit delaunay_mesh(std::vector<Point> const & points)
+    : order_(spatial_order<false, true>(points)), infinite_(points.size()), starting_(points.size() + 1, none)
+  {
+    points_.reserve(points.size());
+    for (std::size_t const i : order_) {
+      points_.push_back(points[i]);
+    }
+  }
+
+  void
+  build()
+  {
+    if (points_.empty()) {
+      return;
+    }
+
+    /* first triangle from the first three points in general position */
+    std::size_t b = 1;
+    while (b < points_.size() && coincide(points_[0], points_[b])) {
+      ++b;
+    }
+    std::size_t c = b + 1;
+    while (c < points_.size() && orientation(points_[0], points_[b], points_[c]) == 0) {
+      ++c;
+    }
+    if (c >= points_.size()) {
+      return;
+    }
+    start(0, b, c);
+
+    for (std::size_t i = 1; i < points_.size(); ++i) {
+      if (i != b && i != c) {
+        insert(i);
+      }
+    }
+  }
+
+  /* finite triangles renumbered densely with vertices indexing the input
+   * points, twins across the hull set to none */
+  void
+  compact(std::vector<std::size_t> & triangles, std::vector<std::size_t> & halfedges) const
+  {
+    std::vector<std::size_t> renumbered(vertices_.size() / 3, none);
+    std::size_t count = 0;
+    for (std::size_t t = 0; t < renumbered.size(); ++t) {
+      if (vertices_[3 * t] != none && !ghost(t)) {
+        renumbered[t] = count++;
+      }
+    }
+
+    triangles.resize(3 * count);
+    halfedges.resize(3 * count);
+    for (std::size_t t = 0; t < renumbered.size(); ++t) {
+      if (renumbered[t] == none) {
+        continue;
+      }
+      for (std::size_t j = 0; j < 3; ++j) {
+        std::size_t const twin = twins_[3 * t + j];
+        triangles[3 * renumbered[t] + j] = order_[vertices_[3 * t + j]];
+        halfedges[3 * renumbered[t] + j] = renumbered[twin / 3] == none ? none : 3 * renumbered[twin / 3] + twin % 3;
+      }
+    }
+  }
+
+private:
+  struct boundary_edge
+  {
+    std::size_t from;
+    std::size_t to;
+    std::size_t outside;
+  };
+
+  [[nodiscard]] static constexpr std::size_t
+  next(std::size_t e) noexcept
+  {
+    return e % 3 == 2 ? e - 2 : e + 1;
+  }
+
+  [[nodiscard]] static bool
+  coincide(Point const & lhs, Point const & rhs) noexcept
+  {
+    return get<0>(lhs) == get<0>(rhs) && get<1>(lhs) == get<1>(rhs);
+  }
+
+  /* position of the vertex at infinity in triangle t, 3 for finite ones */
+  [[nodiscard]] std::size_t
+  infinite_corner(std::size_t t) const noexcept
+  {
+    std::size_t k = 0;
+    while (k < 3 && vertices_[3 * t + k] != infinite_) {
+      ++k;
+    }
+    return k;
+  }
+
+  [[nodiscard]] bool
+  ghost(std::size_t t) const noexcept
+  {
+    return infinite_corner(t) < 3;
+  }
+
+  [[nodiscard]] bool
+  in_conflict(std::size_t t, Point const & p) const noexcept
+  {
+    std::size_t const k = infinite_corner(t);
+    if (k == 3) {
+      return incircle(points_[vertices_[3 * t]], points_[vertices_[3 * t + 1]], points_[vertices_[3 * t + 2]], p) > 0;
+    }
+
+    Point const & a = points_[vertices_[3 * t + (k + 1) % 3]];
+    Point const & b = points_[vertices_[3 * t + (k + 2) % 3]];
+    int const side = orientation(a, b, p);
+    if (side != 0) {
+      return side > 0;
+    }
+    return std::min(get<0>(a), get<0>(b)) <= get<0>(p) && get<0>(p) <= std::max(get<0>(a), get<0>(b))
+        && std::min(get<1>(a), get<1>(b)) <= get<1>(p) && get<1>(p) <= std::max(get<1>(a), get<1>(b))
+        && !coincide(a, p) && !coincide(b, p);
+  }
+
+  std::size_t
+  add_triangle(std::size_t a, std::size_t b, std::size_t c)
+  {
+    std::size_t t = 0;
+    if (free_.empty()) {
+      t = vertices_.size() / 3;
+      vertices_.resize(vertices_.size() + 3);
+      twins_.resize(twins_.size() + 3);
+      visited_.push_back(0);
+      conflict_.push_back(0);
+    } else {
+      t = free_.back();
+      free_.pop_back();
+    }
+    vertices_[3 * t] = a;
+    vertices_[3 * t + 1] = b;
+    vertices_[3 * t + 2] = c;
+    return t;
+  }
+
+  void
+  link(std::size_t e, std::size_t f) noexcept
+  {
+    twins_[e] = f;
+    twins_[f] = e;
+  }
+
+  /* counter-clockwise a, b, c and a ghost triangle behind each edge */
+  void
+  start(std::size_t a, std::size_t b, std::size_t c)
+  {
+    if (orientation(points_[a], points_[b], points_[c]) < 0) {
+      std::swap(b, c);
+    }
+    std::size_t const t = add_triangle(a, b, c);
+    std::size_t const gab = add_triangle(b, a, infinite_);
+    std::size_t const gbc = add_triangle(c, b, infinite_);
+    std::size_t const gca = add_triangle(a, c, infinite_);
+    link(3 * t, 3 * gab);
+    link(3 * t + 1, 3 * gbc);
+    link(3 * t + 2, 3 * gca);
+    link(3 * gab + 1, 3 * gca + 2);
+    link(3 * gab + 2, 3 * gbc + 1);
+    link(3 * gbc + 2, 3 * gca + 1);
+    last_ = t;
+  }
+
+  /* walks from the last new triangle towards p, ends in a finite triangle
+   * containing p or in a ghost triangle whose hull edge p lies beyond */
+  [[nodiscard]] std::size_t
+  locate(Point const & p) const noexcept
+  {
+    std::size_t t = last_;
+    for (;;) {
+      if (std::size_t const k = infinite_corner(t); k < 3) {
+        if (in_conflict(t, p)) {
+          return t;
+        }
+        t = twins_[3 * t + (k + 1) % 3] / 3;
+        continue;
+      }
+
+      bool moved = false;
+      for (std::size_t e = 3 * t; e < 3 * t + 3; ++e) {
+        if (orientation(points_[vertices_[e]], points_[vertices_[next(e)]], p) < 0) {
+          t = twins_[e] / 3;
+          moved = true;
+          break;
+        }
+      }
+      if (!moved) {
+        return t;
+      }
+    }
+  }
+
+  void
+  insert(std::size_t i)
+  {
+    Point const & p = points_[i];
+    std::size_t const seed = locate(p);
+    for (std::size_t e = 3 * seed; e < 3 * seed + 3; ++e) {
+      if (vertices_[e] != infinite_ && coincide(points_[vertices_[e]], p)) {
+        return;
+      }
+    }
+
+    /* cavity of all triangles whose circumcircle holds p, grown from the
+     * seed; it is star-shaped around p */
+    ++stamp_;
+    stack_.assign(1, seed);
+    visited_[seed] = stamp_;
+    conflict_[seed] = 1;
+    cavity_.clear();
+    boundary_.clear();
+    while (!stack_.empty()) {
+      std::size_t const t = stack_.back();
+      stack_.pop_back();
+      cavity_.push_back(t);
+      for (std::size_t e = 3 * t; e < 3 * t + 3; ++e) {
+        std::size_t const n = twins_[e] / 3;
+        if (visited_[n] != stamp_) {
+          visited_[n] = stamp_;
+          conflict_[n] = in_conflict(n, p) ? 1 : 0;
+          if (conflict_[n] != 0) {
+            stack_.push_back(n);
+          }
+        }
+        if (conflict_[n] == 0) {
+          boundary_.push_back({vertices_[e], vertices_[next(e)], twins_[e]});
+        }
+      }
+    }
+
+    for (std::size_t const t : cavity_) {
+      vertices_[3 * t] = none;
+      free_.push_back(t);
+    }
+
+    /* fan from p over the cavity boundary, consecutive fan triangles meet at
+     * the boundary vertex one ends and the other starts with */
+    for (auto const & edge : boundary_) {
+      std::size_t const t = add_triangle(edge.from, edge.to, i);
+      link(3 * t, edge.outside);
+      starting_[edge.from] = t;
+    }
+    for (auto const & edge : boundary_) {
+      std::size_t const t = starting_[edge.from];
+      link(3 * t + 1, 3 * starting_[edge.to] + 2);
+      last_ = t;
+    }
+  }
+
+  std::vector<std::size_t> order_;
+  std::vector<Point> points_{};
+  std::size_t infinite_;
+  std::vector<std::size_t> vertices_{};
+  std::vector<std::size_t> twins_{};
+  std::vector<std::size_t> free_{};
+  std::size_t last_ = 0;
+
+  /* scratch of the current insertion, kept to reuse the memory */
+  std::vector<std::size_t> visited_{};
+  std::vector<unsigned char> conflict_{};
+  std::vector<std::size_t> starting_;
+  std::vector<std::size_t> stack_{};
+  std::vector<std::size_t> cavity_{};
+  std::vector<boundary_edge> boundary_{};
+  std::size_t stamp_ = 0;
+};
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef GEO_DETAIL_EXECUTION_HPP
+#define GEO_DETAIL_EXECUTION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace geo::detail {
+
+[[nodiscard]] inline std::size_t
+worker_count() noexcept
+{
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/* Calls f(first, last) on disjoint subranges covering [0, count) from all
+ * hardware threads. Subranges are handed out dynamically so uneven work
+ * balances out, and if the system refuses to start a thread, the others do
+ * its share. The first exception thrown by f is rethrown after all workers
+ * stopped. */
+template <typename F>
+void
+parallel_for(std::size_t count, F && f)
+{
+  std::size_t const threads = std::min(worker_count(), count);
+  if (threads <= 1) {
+    if (count != 0) {
+      f(std::size_t{0}, count);
+    }
+    return;
+  }
+
+  std::size_t const grain = std::max<std::size_t>(1, count / (threads * 16));
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto const work = [&] {
+    try {
+      for (;;) {
+        std::size_t const first = next.fetch_add(grain, std::memory_order_relaxed);
+        if (first >= count) {
+          return;
+        }
+        f(first, std::min(first + grain, count));
+      }
+    } catch (...) {
+      std::lock_guard const lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next.store(count, std::memory_order_relaxed);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  try {
+    for (std::size_t i = 1; i < threads; ++i) {
+      workers.emplace_back(work);
+    }
+  } catch (std::system_error const &) {
+    /* no more threads to be had, the workers started so far and this
+     * thread share the rest */
+  }
+  work();
+  for (auto & worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace geo::detail
+
+#endif
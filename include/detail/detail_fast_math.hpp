@@ -0,0 +1,64 @@
+#ifndef GEO_DETAIL_FAST_MATH_HPP
+#define GEO_DETAIL_FAST_MATH_HPP
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace geo {
+
+namespace detail {
+
+template <std::floating_point T>
+struct rsqrt_estimate;
+
+template <>
+struct rsqrt_estimate<float>
+{
+  using bits_type = std::uint32_t;
+  static constexpr bits_type magic = 0x5f375a86u;
+  static constexpr std::size_t steps = 3;
+};
+
+template <>
+struct rsqrt_estimate<double>
+{
+  using bits_type = std::uint64_t;
+  static constexpr bits_type magic = 0x5fe6eb50c7b537a9u;
+  static constexpr std::size_t steps = 4;
+};
+
+template <typename T>
+concept has_rsqrt_estimate = requires { rsqrt_estimate<T>::magic; };
+
+template <std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr T
+horner(T x, std::array<T, N> const & coeffs) noexcept
+{
+  T result = coeffs[N - 1];
+  for (std::size_t i = N - 1; i > 0; --i) {
+    result = result * x + coeffs[i - 1];
+  }
+  return result;
+}
+
+// Abramowitz & Stegun 4.4.46, acos(x) = sqrt(1 - x) * P(x) on [0, 1], |e| <= 2e-8
+template <std::floating_point T>
+inline constexpr std::array<T, 8> acos_coeffs{
+  T(1.5707963050), T(-0.2145988016), T(0.0889789874), T(-0.0501743046),
+  T(0.0308918810), T(-0.0170881256), T(0.0066700901), T(-0.0012624911)
+};
+
+// Abramowitz & Stegun 4.4.49, atan(x) = x * P(x^2) on [-1, 1], |e| <= 2e-8
+template <std::floating_point T>
+inline constexpr std::array<T, 8> atan_coeffs{
+  T(0.9999993329), T(-0.3332985605), T(0.1994653599), T(-0.1390853351),
+  T(0.0964200441), T(-0.0559098861), T(0.0218612288), T(-0.0040540580)
+};
+
+} // namespace detail
+
+} // namespace geo
+
+#endif
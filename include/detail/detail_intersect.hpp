@@ -0,0 +1,710 @@
+#ifndef GEO_DETAIL_INTERSECT_HPP
+#define GEO_DETAIL_INTERSECT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../line.hpp"
+#include "../point.hpp"
+#include "../predicates.hpp"
+#include "../traits.hpp"
+#include "detail_execution.hpp"
+#include "detail_predicates.hpp"
+
+namespace geo::detail {
+
+template <concepts::line Line>
+using line_point_t = std::remove_cvref_t<decltype(std::declval<Line const &>().start)>;
+
+/* c is known to be collinear with a and b, is it within their bounds? */
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+within_bounds(Point const & a, Point const & b, Point const & c) noexcept
+{
+  return std::min(get<0>(a), get<0>(b)) <= get<0>(c) && get<0>(c) <= std::max(get<0>(a), get<0>(b))
+      && std::min(get<1>(a), get<1>(b)) <= get<1>(c) && get<1>(c) <= std::max(get<1>(a), get<1>(b));
+}
+
+template <concepts::point Point>
+[[nodiscard]] constexpr bool
+segments_intersect(Point const & p1, Point const & q1, Point const & p2, Point const & q2) noexcept
+{
+  int const o1 = orientation(p1, q1, p2);
+  int const o2 = orientation(p1, q1, q2);
+  int const o3 = orientation(p2, q2, p1);
+  int const o4 = orientation(p2, q2, q1);
+
+  if (o1 != o2 && o3 != o4) {
+    return true;
+  }
+  return (o1 == 0 && within_bounds(p1, q1, p2))
+      || (o2 == 0 && within_bounds(p1, q1, q2))
+      || (o3 == 0 && within_bounds(p2, q2, p1))
+      || (o4 == 0 && within_bounds(p2, q2, q1));
+}
+
+template <std::floating_point T>
+struct segment_bounds
+{
+  T min_x;
+  T min_y;
+  T max_x;
+  T max_y;
+
+  [[nodiscard]] constexpr bool
+  overlaps(segment_bounds const & other) const noexcept
+  {
+    return min_x <= other.max_x && other.min_x <= max_x
+        && min_y <= other.max_y && other.min_y <= max_y;
+  }
+};
+
+/* both searches order coordinates, which NaN and infinity would break */
+template <std::floating_point T>
+void
+require_finite(T x0, T y0, T x1, T y1)
+{
+  if (!(std::isfinite(x0) && std::isfinite(y0) && std::isfinite(x1) && std::isfinite(y1))) {
+    throw std::invalid_argument("non-finite segment coordinate");
+  }
+}
+
+template <typename Range>
+[[nodiscard]] auto
+bounds_of(Range const & lines)
+{
+  using T = traits::value_type_t<line_point_t<std::ranges::range_value_t<Range>>>;
+
+  std::vector<segment_bounds<T>> retval;
+  retval.reserve(std::ranges::size(lines));
+  for (auto const & line : lines) {
+    T const x0 = get<0>(line.start);
+    T const x1 = get<0>(line.end);
+    T const y0 = get<1>(line.start);
+    T const y1 = get<1>(line.end);
+    require_finite(x0, y0, x1, y1);
+    retval.push_back({std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)});
+  }
+  return retval;
+}
+
+/***************************** sweep predicates ********************************/
+
+/* The sweep compares crossing points of segments, which are rational in the
+ * coordinates. Its predicates are polynomials in the raw coordinates,
+ * written once over a number type: bounded evaluates them in floating point
+ * with a running bound on the rounding error, which settles almost every
+ * sign, and expansion evaluates them exactly for the rest. Exact as long as
+ * no product overflows or underflows. */
+template <std::floating_point T>
+struct bounded
+{
+  T value;
+  T error;
+
+  [[nodiscard]] friend constexpr bounded
+  operator+(bounded const & lhs, bounded const & rhs) noexcept
+  {
+    T const value = lhs.value + rhs.value;
+    return {value, lhs.error + rhs.error + std::numeric_limits<T>::epsilon() * abs(value)};
+  }
+
+  [[nodiscard]] friend constexpr bounded
+  operator-(bounded const & lhs, bounded const & rhs) noexcept
+  {
+    T const value = lhs.value - rhs.value;
+    return {value, lhs.error + rhs.error + std::numeric_limits<T>::epsilon() * abs(value)};
+  }
+
+  [[nodiscard]] friend constexpr bounded
+  operator*(bounded const & lhs, bounded const & rhs) noexcept
+  {
+    T const value = lhs.value * rhs.value;
+    return {
+      value,
+      abs(lhs.value) * rhs.error + abs(rhs.value) * lhs.error + lhs.error * rhs.error
+        + std::numeric_limits<T>::epsilon() * abs(value)
+    };
+  }
+
+  [[nodiscard]] static constexpr T
+  abs(T x) noexcept
+  {
+    return x < T{} ? -x : x;
+  }
+};
+
+/* nonoverlapping components of increasing magnitude without zeros, so the
+ * last one carries the sign */
+template <std::floating_point T>
+struct expansion
+{
+  std::vector<T> components;
+
+  expansion() = default;
+
+  explicit expansion(T x)
+  {
+    add(x);
+  }
+
+  /* grows the expansion by one term (Shewchuk), exactly */
+  void
+  add(T term)
+  {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < components.size(); ++i) {
+      auto const [sum, error] = two_sum(term, components[i]);
+      term = sum;
+      if (error != T{}) {
+        components[kept++] = error;
+      }
+    }
+    components.resize(kept);
+    if (term != T{}) {
+      components.push_back(term);
+    }
+  }
+
+  [[nodiscard]] int
+  sign() const noexcept
+  {
+    return components.empty() ? 0 : components.back() > T{} ? 1 : -1;
+  }
+
+  [[nodiscard]] friend expansion
+  operator+(expansion lhs, expansion const & rhs)
+  {
+    for (T const component : rhs.components) {
+      lhs.add(component);
+    }
+    return lhs;
+  }
+
+  [[nodiscard]] friend expansion
+  operator-(expansion lhs, expansion const & rhs)
+  {
+    for (T const component : rhs.components) {
+      lhs.add(-component);
+    }
+    return lhs;
+  }
+
+  [[nodiscard]] friend expansion
+  operator*(expansion const & lhs, expansion const & rhs)
+  {
+    expansion retval;
+    for (T const x : lhs.components) {
+      for (T const y : rhs.components) {
+        auto const [product, error] = two_product(x, y);
+        retval.add(product);
+        retval.add(error);
+      }
+    }
+    return retval;
+  }
+};
+
+/* sign of polynomial(lift), lift turns a coordinate into the number type */
+template <std::floating_point T, typename Polynomial>
+[[nodiscard]] int
+sign_of(Polynomial const & polynomial)
+{
+  /* the error terms are rounded themselves, the factor covers that */
+  constexpr T slack = T{1} + 32 * std::numeric_limits<T>::epsilon();
+
+  auto const estimate = polynomial([](T x) { return bounded<T>{x, T{}}; });
+  if (bounded<T>::abs(estimate.value) > estimate.error * slack) {
+    return estimate.value > T{} ? 1 : -1;
+  }
+  return polynomial([](T x) { return expansion<T>(x); }).sign();
+}
+
+/* segment oriented from its lexicographically smaller end point */
+template <std::floating_point T>
+struct sweep_segment
+{
+  std::array<T, 2> left;
+  std::array<T, 2> right;
+
+  [[nodiscard]] constexpr bool
+  degenerate() const noexcept
+  {
+    return left == right;
+  }
+};
+
+/* an end point, or the crossing of segments first and second */
+template <std::floating_point T>
+struct sweep_point
+{
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  std::array<T, 2> at{};
+  std::size_t first = none;
+  std::size_t second = none;
+
+  [[nodiscard]] constexpr bool
+  crossing() const noexcept
+  {
+    return first != none;
+  }
+};
+
+/* sign of the cross product of the directions of s and t, positive if t
+ * turns counter-clockwise from s */
+template <std::floating_point T>
+[[nodiscard]] int
+direction_sign(sweep_segment<T> const & s, sweep_segment<T> const & t)
+{
+  return sign_of<T>([&](auto const & lift) {
+    return (lift(s.right[0]) - lift(s.left[0])) * (lift(t.right[1]) - lift(t.left[1]))
+         - (lift(s.right[1]) - lift(s.left[1])) * (lift(t.right[0]) - lift(t.left[0]));
+  });
+}
+
+/* The crossing of a and b is a.left + parameter / denominator * (dx, dy),
+ * the denominator having the sign direction_sign(a, b) != 0 */
+template <typename Number>
+struct crossing_terms
+{
+  Number dx;
+  Number dy;
+  Number denominator;
+  Number parameter;
+};
+
+template <typename Lift, std::floating_point T>
+[[nodiscard]] auto
+crossing_of(Lift const & lift, sweep_segment<T> const & a, sweep_segment<T> const & b)
+{
+  auto ax = lift(a.right[0]) - lift(a.left[0]);
+  auto ay = lift(a.right[1]) - lift(a.left[1]);
+  auto const bx = lift(b.right[0]) - lift(b.left[0]);
+  auto const by = lift(b.right[1]) - lift(b.left[1]);
+  auto d = ax * by - ay * bx;
+  auto n = (lift(b.left[0]) - lift(a.left[0])) * by - (lift(b.left[1]) - lift(a.left[1])) * bx;
+  return crossing_terms<decltype(d)>{std::move(ax), std::move(ay), std::move(d), std::move(n)};
+}
+
+/* coordinate k of the crossing times its denominator */
+template <typename Lift, std::floating_point T, typename Number>
+[[nodiscard]] Number
+crossing_numerator(Lift const & lift, sweep_segment<T> const & a, crossing_terms<Number> const & c, std::size_t k)
+{
+  return lift(a.left[k]) * c.denominator + c.parameter * (k == 0 ? c.dx : c.dy);
+}
+
+/* orientation(s.left, s.right, p): 1 if p lies above the line of s, -1 if
+ * below, 0 if on it */
+template <std::floating_point T>
+[[nodiscard]] int
+side(std::vector<sweep_segment<T>> const & segments, sweep_segment<T> const & s, sweep_point<T> const & p)
+{
+  if (!p.crossing()) {
+    return orientation(s.left[0], s.left[1], s.right[0], s.right[1], p.at[0], p.at[1]);
+  }
+  auto const & a = segments[p.first];
+  auto const & b = segments[p.second];
+  return direction_sign(a, b) * sign_of<T>([&](auto const & lift) {
+    auto const c = crossing_of(lift, a, b);
+    auto const sx = lift(s.right[0]) - lift(s.left[0]);
+    auto const sy = lift(s.right[1]) - lift(s.left[1]);
+    auto const lx = lift(a.left[0]) - lift(s.left[0]);
+    auto const ly = lift(a.left[1]) - lift(s.left[1]);
+    return c.denominator * (sx * ly - sy * lx) + c.parameter * (sx * c.dy - sy * c.dx);
+  });
+}
+
+/* sign of coordinate k of p minus that of q */
+template <std::floating_point T>
+[[nodiscard]] int
+compare_coordinate(
+    std::vector<sweep_segment<T>> const & segments, sweep_point<T> const & p, sweep_point<T> const & q,
+    std::size_t k)
+{
+  if (!p.crossing() && !q.crossing()) {
+    return p.at[k] < q.at[k] ? -1 : q.at[k] < p.at[k] ? 1 : 0;
+  }
+  if (!p.crossing()) {
+    return -compare_coordinate(segments, q, p, k);
+  }
+  auto const & a = segments[p.first];
+  auto const & b = segments[p.second];
+  if (!q.crossing()) {
+    return direction_sign(a, b) * sign_of<T>([&](auto const & lift) {
+      auto const c = crossing_of(lift, a, b);
+      return crossing_numerator(lift, a, c, k) - lift(q.at[k]) * c.denominator;
+    });
+  }
+  auto const & e = segments[q.first];
+  auto const & f = segments[q.second];
+  return direction_sign(a, b) * direction_sign(e, f) * sign_of<T>([&](auto const & lift) {
+    auto const c = crossing_of(lift, a, b);
+    auto const g = crossing_of(lift, e, f);
+    return crossing_numerator(lift, a, c, k) * g.denominator - crossing_numerator(lift, e, g, k) * c.denominator;
+  });
+}
+
+/* lexicographic, x first */
+template <std::floating_point T>
+[[nodiscard]] int
+compare_points(std::vector<sweep_segment<T>> const & segments, sweep_point<T> const & p, sweep_point<T> const & q)
+{
+  int const x = compare_coordinate(segments, p, q, 0);
+  return x != 0 ? x : compare_coordinate(segments, p, q, 1);
+}
+
+/* Order of the segments crossing the sweep line just after point at, from
+ * below to above. Segments through at are ordered by direction, a vertical
+ * one last, and collinear ones by index. Only segments through at are ever
+ * inserted, so one of the two compared always passes through it. Points
+ * compare against the segments they lie strictly above or below. */
+template <std::floating_point T>
+struct sweep_order
+{
+  using is_transparent = void;
+
+  std::vector<sweep_segment<T>> const * segments;
+  sweep_point<T> const * at;
+
+  [[nodiscard]] bool
+  operator()(std::size_t s, std::size_t t) const
+  {
+    int const side_s = side(*segments, (*segments)[s], *at);
+    int const side_t = side(*segments, (*segments)[t], *at);
+    if (side_s == 0 && side_t == 0) {
+      int const turn = direction_sign((*segments)[s], (*segments)[t]);
+      return turn != 0 ? turn > 0 : s < t;
+    }
+    return side_s > 0 || side_t < 0;
+  }
+
+  [[nodiscard]] bool
+  operator()(std::size_t s, sweep_point<T> const & p) const
+  {
+    return side(*segments, (*segments)[s], p) > 0;
+  }
+
+  [[nodiscard]] bool
+  operator()(sweep_point<T> const & p, std::size_t t) const
+  {
+    return side(*segments, (*segments)[t], p) < 0;
+  }
+};
+
+/* Bentley-Ottmann: sweeps a vertical line over the end points and crossings
+ * of the segments, keeping the segments it crosses ordered from below to
+ * above; only neighbours in that order are tested for a crossing ahead.
+ * Coincident event points are handled at once as in de Berg et al.: the
+ * segments through a point are reported pairwise, except collinear pairs
+ * whose overlap began earlier, so every pair is reported once, at the first
+ * common point. Every comparison is exact, also at crossings, by the sweep
+ * predicates. O((n + k) log n) for k intersecting pairs. */
+template <typename Range, typename Callback>
+void
+sweep_intersections(Range const & lines, Callback & callback)
+{
+  using T = traits::value_type_t<line_point_t<std::ranges::range_value_t<Range>>>;
+  using segment = sweep_segment<T>;
+  using point = sweep_point<T>;
+
+  std::vector<segment> segments;
+  segments.reserve(std::ranges::size(lines));
+  for (auto const & line : lines) {
+    std::array<T, 2> const start{get<0>(line.start), get<1>(line.start)};
+    std::array<T, 2> const end{get<0>(line.end), get<1>(line.end)};
+    require_finite(start[0], start[1], end[0], end[1]);
+    segments.push_back(start < end ? segment{start, end} : segment{end, start});
+  }
+
+  /* end points are known up front and sorted once, only crossings go
+   * through the queue */
+  std::vector<std::pair<std::array<T, 2>, std::size_t>> lefts;
+  std::vector<std::pair<std::array<T, 2>, std::size_t>> rights;
+  lefts.reserve(segments.size());
+  rights.reserve(segments.size());
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    lefts.emplace_back(segments[i].left, i);
+    if (!segments[i].degenerate()) {
+      rights.emplace_back(segments[i].right, i);
+    }
+  }
+  std::ranges::sort(lefts);
+  std::ranges::sort(rights);
+  auto const later = [&](point const & lhs, point const & rhs) {
+    return compare_points(segments, lhs, rhs) > 0;
+  };
+  std::priority_queue<point, std::vector<point>, decltype(later)> crossings(later);
+
+  point current;
+  std::set<std::size_t, sweep_order<T>> status(sweep_order<T>{&segments, &current});
+  std::vector<char> ended(segments.size());
+  std::vector<std::size_t> starting;
+  std::vector<std::size_t> through;
+
+  auto const report = [&](std::size_t i, std::size_t j) {
+    callback(std::min(i, j), std::max(i, j));
+  };
+
+  /* the status order of segments through the current point */
+  auto const by_direction = [&](std::size_t s, std::size_t t) {
+    int const turn = direction_sign(segments[s], segments[t]);
+    return turn != 0 ? turn > 0 : s < t;
+  };
+
+  /* queues the crossing of neighbours s and t if it lies ahead */
+  auto const schedule = [&](std::size_t s, std::size_t t) {
+    auto const & a = segments[s];
+    auto const & b = segments[t];
+    /* both span the sweep line, their y extents decide most pairs */
+    if (std::max(a.left[1], a.right[1]) < std::min(b.left[1], b.right[1])
+        || std::max(b.left[1], b.right[1]) < std::min(a.left[1], a.right[1])
+        || direction_sign(a, b) == 0
+        || !segments_intersect(lines[s].start, lines[s].end, lines[t].start, lines[t].end)) {
+      return;
+    }
+    point const crossing{{}, s, t};
+    if (compare_points(segments, crossing, current) > 0) {
+      crossings.push(crossing);
+    }
+  };
+
+  for (std::size_t next_left = 0, next_right = 0; next_left < lefts.size() || next_right < rights.size();) {
+    /* the next event point, an end point represents it if there is one */
+    if (next_left < lefts.size()) {
+      current = point{lefts[next_left].first};
+    }
+    if (next_right < rights.size() && (next_left == lefts.size() || rights[next_right].first < current.at)) {
+      current = point{rights[next_right].first};
+    }
+    if (!crossings.empty() && compare_points(segments, crossings.top(), current) < 0) {
+      current = crossings.top();
+    }
+    starting.clear();
+    for (; next_left < lefts.size() && !current.crossing() && lefts[next_left].first == current.at; ++next_left) {
+      starting.push_back(lefts[next_left].second);
+    }
+    for (; next_right < rights.size() && !current.crossing() && rights[next_right].first == current.at; ++next_right) {
+      ended[rights[next_right].second] = 1;
+    }
+    while (!crossings.empty() && compare_points(segments, crossings.top(), current) == 0) {
+      crossings.pop();
+    }
+
+    /* the segments through the point are contiguous in the status */
+    auto const first = status.lower_bound(current);
+    auto last = first;
+    while (last != status.end() && side(segments, segments[*last], current) == 0) {
+      ++last;
+    }
+    through.assign(first, last);
+    auto const above = status.erase(first, last);
+
+    for (std::size_t a = 0; a < starting.size(); ++a) {
+      for (std::size_t b = a + 1; b < starting.size(); ++b) {
+        report(starting[a], starting[b]);
+      }
+      for (std::size_t const s : through) {
+        report(starting[a], s);
+      }
+    }
+    /* collinear pairs without a starting segment overlapped before */
+    std::ranges::sort(through, by_direction);
+    for (std::size_t a = 0, group = 0; a < through.size(); ++a) {
+      group = std::max(group, a + 1);
+      while (group < through.size() && direction_sign(segments[through[a]], segments[through[group]]) == 0) {
+        ++group;
+      }
+      for (std::size_t b = group; b < through.size(); ++b) {
+        report(through[a], through[b]);
+      }
+    }
+
+    /* the segments continuing beyond the point go back in, in order right
+     * below the segment above it */
+    std::erase_if(through, [&](std::size_t s) { return ended[s] != 0; });
+    std::erase_if(starting, [&](std::size_t s) { return segments[s].degenerate(); });
+    through.insert(through.end(), starting.begin(), starting.end());
+    std::ranges::sort(through, by_direction);
+    auto lowest = above;
+    for (std::size_t i = 0; i < through.size(); ++i) {
+      auto const inserted = status.emplace_hint(above, through[i]);
+      lowest = i == 0 ? inserted : lowest;
+    }
+
+    if (lowest != status.begin() && lowest != status.end()) {
+      schedule(*std::prev(lowest), *lowest);
+    }
+    if (lowest != above && above != status.end()) {
+      schedule(*std::prev(above), *above);
+    }
+  }
+}
+
+/* Cells of a segment in a grid of side x side cells, in cell units: in
+ * every row it crosses, the columns it crosses within the band of the row.
+ * Both are widened by slack, the rounding error of the coordinates, so that
+ * segments sharing a point share a cell. O(rows + columns) cells rather than
+ * the area of the bounds. */
+template <std::floating_point T>
+struct grid_path
+{
+  std::array<T, 2> low;   /* end with the smaller row coordinate */
+  std::array<T, 2> high;
+  std::array<T, 2> slack;
+  std::size_t side;
+
+  [[nodiscard]] std::size_t
+  cell(T position) const noexcept
+  {
+    return position > T{} ? static_cast<std::size_t>(std::min(position, static_cast<T>(side - 1))) : 0;
+  }
+
+  [[nodiscard]] std::size_t
+  first_row() const noexcept
+  {
+    return cell(low[1] - slack[1]);
+  }
+
+  [[nodiscard]] std::size_t
+  last_row() const noexcept
+  {
+    return cell(high[1] + slack[1]);
+  }
+
+  /* first and last column in row */
+  [[nodiscard]] std::pair<std::size_t, std::size_t>
+  columns(std::size_t row) const noexcept
+  {
+    T from = std::min(low[0], high[0]);
+    T to = std::max(low[0], high[0]);
+    if (high[1] > low[1]) {
+      auto const at = [&](T v) {
+        T const t = (std::clamp(v, low[1], high[1]) - low[1]) / (high[1] - low[1]);
+        return low[0] + t * (high[0] - low[0]);
+      };
+      T const a = at(static_cast<T>(row) - slack[1]);
+      T const b = at(static_cast<T>(row + 1) + slack[1]);
+      from = std::min(a, b);
+      to = std::max(a, b);
+    }
+    return {cell(from - slack[0]), cell(to + slack[0])};
+  }
+};
+
+/* Buckets the segments into a uniform grid over their common bounds, each
+ * into the cells it crosses, and tests pairs cell by cell in parallel. A
+ * pair is reported only by the first cell, in row-major order, that both
+ * segments are in, so no pair is reported twice and cells need no
+ * synchronization. */
+template <typename Range, typename Callback>
+void
+grid_intersections(Range const & lines, Callback & callback)
+{
+  using T = traits::value_type_t<line_point_t<std::ranges::range_value_t<Range>>>;
+
+  auto const bounds = bounds_of(lines);
+  if (bounds.size() < 2) {
+    return;
+  }
+
+  segment_bounds<T> all = bounds[0];
+  for (auto const & b : bounds) {
+    all.min_x = std::min(all.min_x, b.min_x);
+    all.min_y = std::min(all.min_y, b.min_y);
+    all.max_x = std::max(all.max_x, b.max_x);
+    all.max_y = std::max(all.max_y, b.max_y);
+  }
+
+  /* about two segments per cell; halves keep the extent finite for any
+   * finite bounds */
+  auto const side = static_cast<std::size_t>(std::sqrt(static_cast<double>(bounds.size()) / 2.0)) + 1;
+  T const half_x = all.max_x / 2 - all.min_x / 2;
+  T const half_y = all.max_y / 2 - all.min_y / 2;
+  T const scale_x = half_x > T{} ? static_cast<T>(side) / half_x : T{};
+  T const scale_y = half_y > T{} ? static_cast<T>(side) / half_y : T{};
+  /* the transform and the interpolation in grid_path::columns are each off
+   * by a few ulp of the cell coordinates and of the shifted inputs */
+  T const epsilon = 16 * std::numeric_limits<T>::epsilon();
+  std::array<T, 2> const slack{
+    epsilon * (static_cast<T>(side) + std::max(std::abs(all.min_x), std::abs(all.max_x)) * scale_x),
+    epsilon * (static_cast<T>(side) + std::max(std::abs(all.min_y), std::abs(all.max_y)) * scale_y)
+  };
+  std::vector<grid_path<T>> paths;
+  paths.reserve(bounds.size());
+  for (auto const & line : lines) {
+    std::array<T, 2> start{(get<0>(line.start) / 2 - all.min_x / 2) * scale_x, (get<1>(line.start) / 2 - all.min_y / 2) * scale_y};
+    std::array<T, 2> end{(get<0>(line.end) / 2 - all.min_x / 2) * scale_x, (get<1>(line.end) / 2 - all.min_y / 2) * scale_y};
+    if (end[1] < start[1]) {
+      std::swap(start, end);
+    }
+    paths.push_back({start, end, slack, side});
+  }
+  auto const for_each_cell = [&](grid_path<T> const & path, auto && f) {
+    for (std::size_t y = path.first_row(); y <= path.last_row(); ++y) {
+      auto const [first, last] = path.columns(y);
+      for (std::size_t x = first; x <= last; ++x) {
+        f(y * side + x);
+      }
+    }
+  };
+  auto const first_common_cell = [&](grid_path<T> const & a, grid_path<T> const & b) {
+    std::size_t const last_row = std::min(a.last_row(), b.last_row());
+    for (std::size_t y = std::max(a.first_row(), b.first_row()); y <= last_row; ++y) {
+      auto const [a_first, a_last] = a.columns(y);
+      auto const [b_first, b_last] = b.columns(y);
+      if (std::max(a_first, b_first) <= std::min(a_last, b_last)) {
+        return y * side + std::max(a_first, b_first);
+      }
+    }
+    return side * side;
+  };
+
+  /* compressed rows: cell c holds entries[offsets[c] .. offsets[c + 1]) */
+  std::vector<std::size_t> offsets(side * side + 1);
+  for (auto const & path : paths) {
+    for_each_cell(path, [&](std::size_t c) { ++offsets[c + 1]; });
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::size_t> entries(offsets.back());
+  {
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+      for_each_cell(paths[i], [&](std::size_t c) { entries[fill[c]++] = i; });
+    }
+  }
+
+  parallel_for(side * side, [&](std::size_t first, std::size_t last) {
+    for (std::size_t c = first; c < last; ++c) {
+      for (std::size_t a = offsets[c]; a < offsets[c + 1]; ++a) {
+        std::size_t const i = entries[a];
+        for (std::size_t b = a + 1; b < offsets[c + 1]; ++b) {
+          std::size_t const j = entries[b];
+          if (bounds[i].overlaps(bounds[j])
+              && segments_intersect(lines[i].start, lines[i].end, lines[j].start, lines[j].end)
+              && first_common_cell(paths[i], paths[j]) == c) {
+            callback(std::min(i, j), std::max(i, j));
+          }
+        }
+      }
+    }
+  });
+}
+
+} // namespace geo::detail
+
+#endif
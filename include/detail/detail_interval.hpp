@@ -0,0 +1,60 @@
+#ifndef GEO_DETAIL_INTERVAL_HPP
+#define GEO_DETAIL_INTERVAL_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <utility>
+
+#include "../fast_math.hpp"
+
+namespace geo::detail {
+
+/* Bounds of a result computed to nearest, moved outwards under
+ * policy::exact and kept as they are under policy::fast. The rounding
+ * error of a basic operation or sqrt is at most half an ulp of the result;
+ * |x| * epsilon plus the least subnormal is at least a whole ulp, so adding
+ * it moves a bound past the exact result, by one ulp or two and without
+ * branches. */
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+rounding_margin(T x) noexcept
+{
+  return (x < T{} ? -x : x) * std::numeric_limits<T>::epsilon() + std::numeric_limits<T>::denorm_min();
+}
+
+template <concepts::math_policy Policy, std::floating_point T>
+[[nodiscard]] constexpr T
+round_down(T x) noexcept
+{
+  if constexpr (std::same_as<Policy, policy::exact>) {
+    return x - rounding_margin(x);
+  } else {
+    return x;
+  }
+}
+
+template <concepts::math_policy Policy, std::floating_point T>
+[[nodiscard]] constexpr T
+round_up(T x) noexcept
+{
+  if constexpr (std::same_as<Policy, policy::exact>) {
+    return x + rounding_margin(x);
+  } else {
+    return x;
+  }
+}
+
+/* smallest and largest of op over the ends of [a, b] and [c, d], the
+ * bounds of a product or quotient */
+template <std::floating_point T, typename Op>
+[[nodiscard]] constexpr std::pair<T, T>
+corner_bounds(T a, T b, T c, T d, Op op) noexcept
+{
+  T const ac = op(a, c), ad = op(a, d), bc = op(b, c), bd = op(b, d);
+  return {std::min(std::min(ac, ad), std::min(bc, bd)), std::max(std::max(ac, ad), std::max(bc, bd))};
+}
+
+} // namespace geo::detail
+
+#endif
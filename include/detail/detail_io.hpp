@@ -0,0 +1,205 @@
+#ifndef GEO_DETAIL_IO_HPP
+#define GEO_DETAIL_IO_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace geo::detail {
+
+inline constexpr std::array<char, 8> file_magic{'G', 'E', 'O', 'B', 'I', 'N', '\0', '\0'};
+inline constexpr std::uint32_t file_version = 1;
+inline constexpr std::uint32_t file_byte_order = 0x01020304u;
+inline constexpr std::size_t file_alignment = 64;
+
+/* fixed layout, both structs are written and read byte by byte */
+struct file_header
+{
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint64_t section_count;
+  std::uint64_t table_offset;
+  std::array<std::byte, 32> reserved;
+};
+
+struct section_header
+{
+  std::uint32_t kind;
+  std::uint32_t scalar;
+  std::uint32_t dimension;
+  std::uint32_t degree;
+  std::uint64_t count;
+  std::uint64_t offset;
+};
+
+static_assert(sizeof(file_header) == file_alignment);
+static_assert(sizeof(section_header) == 32);
+
+/* scalar type code: byte size, bit 8 floating point, bit 9 signed */
+template <typename T>
+[[nodiscard]] constexpr std::uint32_t
+scalar_code() noexcept
+{
+  return static_cast<std::uint32_t>(sizeof(T))
+    | (std::is_floating_point_v<T> ? 0x100u : 0u)
+    | (std::is_signed_v<T> ? 0x200u : 0u);
+}
+
+[[nodiscard]] constexpr std::uint64_t
+align_up(std::uint64_t offset) noexcept
+{
+  return (offset + file_alignment - 1) / file_alignment * file_alignment;
+}
+
+/* read-only memory mapping of a whole file, pages are shared between processes */
+class mapped_file
+{
+public:
+  explicit mapped_file(std::filesystem::path const & path)
+  {
+#if defined(_WIN32)
+    file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error("unable to open " + path.string());
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+      close();
+      throw std::runtime_error("unable to stat " + path.string());
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ != 0) {
+      mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      data_ = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+      if (data_ == nullptr) {
+        close();
+        throw std::runtime_error("unable to map " + path.string());
+      }
+    }
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      throw std::runtime_error("unable to open " + path.string());
+    }
+    struct stat info;
+    if (::fstat(fd_, &info) != 0) {
+      close();
+      throw std::runtime_error("unable to stat " + path.string());
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ != 0) {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+      if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        close();
+        throw std::runtime_error("unable to map " + path.string());
+      }
+    }
+#endif
+  }
+
+  mapped_file(mapped_file && other) noexcept
+  {
+    swap(other);
+  }
+
+  mapped_file &
+  operator=(mapped_file && other) noexcept
+  {
+    mapped_file moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  mapped_file(mapped_file const &) = delete;
+  mapped_file & operator=(mapped_file const &) = delete;
+
+  ~mapped_file()
+  {
+    close();
+  }
+
+  [[nodiscard]] std::span<std::byte const>
+  bytes() const noexcept
+  {
+    return {static_cast<std::byte const *>(data_), size_};
+  }
+
+  void
+  swap(mapped_file & other) noexcept
+  {
+#if defined(_WIN32)
+    std::swap(file_, other.file_);
+    std::swap(mapping_, other.mapping_);
+#else
+    std::swap(fd_, other.fd_);
+#endif
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+
+private:
+  void
+  close() noexcept
+  {
+#if defined(_WIN32)
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+      CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+      CloseHandle(file_);
+    }
+    file_ = INVALID_HANDLE_VALUE;
+    mapping_ = nullptr;
+#else
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+    fd_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+#if defined(_WIN32)
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+  void const * data_ = nullptr;
+#else
+  int fd_ = -1;
+  void * data_ = nullptr;
+#endif
+  std::size_t size_ = 0;
+};
+
+} // namespace geo::detail
+
+#endif
@@ -1,19 +1,344 @@
 #ifndef GEO_DETAIL_MATH_HPP
 #define GEO_DETAIL_MATH_HPP
 
+#include <bit>
 #include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
 
 namespace geo {
 
 namespace detail {
 
+// Constant-evaluation engine. Every loop below has a bound that depends on the
+// floating point type only, never on the argument, so compile-time tables never
+// run into the constexpr step limit.
+
+template <std::floating_point T>
+using wide_float_t = std::common_type_t<T, double>;
+
+// Newton-Raphson converges quadratically from an initial relative error below
+// 2^-2, the bit width of digits covers the mantissa with one polishing step
+template <std::floating_point T>
+inline constexpr std::size_t newton_steps =
+  std::bit_width(static_cast<unsigned>(std::numeric_limits<T>::digits)) + 1;
+
+template <std::floating_point T>
+inline constexpr std::size_t series_terms = std::numeric_limits<T>::digits / 4 + 2;
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+abs(T x) noexcept
+{
+  return x < T{} ? -x : x;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr bool
+is_nan(T x) noexcept
+{
+  return x != x;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr bool
+is_inf(T x) noexcept
+{
+  return abs(x) == std::numeric_limits<T>::infinity();
+}
+
+/* std::signbit, which is not constexpr before C++23; wider types go through
+ * double, which keeps the sign of every value including zeros and NaNs */
+template <std::floating_point T>
+[[nodiscard]] constexpr bool
+sign_bit(T x) noexcept
+{
+  if constexpr (std::same_as<T, float> && sizeof(float) == sizeof(std::uint32_t)) {
+    return (std::bit_cast<std::uint32_t>(x) >> 31) != 0;
+  } else if constexpr (std::same_as<T, double> && sizeof(double) == sizeof(std::uint64_t)) {
+    return (std::bit_cast<std::uint64_t>(x) >> 63) != 0;
+  } else {
+    return sign_bit(static_cast<double>(x));
+  }
+}
+
+/* exact power of two by binary exponentiation, at most log2(|exponent|) steps */
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+pow2(int exponent) noexcept
+{
+  T result{1};
+  T base = exponent < 0 ? T{0.5} : T{2};
+  for (auto n = static_cast<unsigned>(exponent < 0 ? -exponent : exponent); n != 0;) {
+    if (n & 1u) {
+      result *= base;
+    }
+    n >>= 1;
+    if (n != 0) {
+      base *= base;
+    }
+  }
+  return result;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+ldexp(T x, int exponent) noexcept
+{
+  /* split the exponent so neither factor over- or underflows on its own */
+  return x * pow2<T>(exponent / 2) * pow2<T>(exponent - exponent / 2);
+}
+
+template <std::floating_point T>
+struct decomposed
+{
+  T mantissa;
+  int exponent;
+};
+
+/* x = mantissa * 2^exponent, mantissa in [0.5, 1), x positive and finite */
+template <std::floating_point T>
+[[nodiscard]] constexpr decomposed<T>
+frexp(T x) noexcept
+{
+  int exponent = 0;
+  constexpr auto max_shift = static_cast<int>(
+    std::bit_floor(static_cast<unsigned>(std::numeric_limits<T>::max_exponent - 1)));
+  for (int shift = max_shift; shift > 0; shift /= 2) {
+    /* the inner loops run at most twice, the second time only for subnormals */
+    while (x >= pow2<T>(shift)) {
+      x *= pow2<T>(-shift);
+      exponent += shift;
+    }
+    while (x < pow2<T>(-shift)) {
+      x *= pow2<T>(shift);
+      exponent -= shift;
+    }
+  }
+  if (x >= T{1}) {
+    x *= T{0.5};
+    ++exponent;
+  }
+  return {x, exponent};
+}
+
+/* x positive and finite */
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sqrt_newton_raphson(T x) noexcept
+{
+  auto [mantissa, exponent] = frexp(x);
+  if (exponent % 2 != 0) {
+    mantissa *= T{2};
+    --exponent;
+  }
+
+  /* mantissa in [0.5, 2), the chord (1 + m) / 2 is within 2^-4 of sqrt(m) */
+  T y = T{0.5} * (T{1} + mantissa);
+  for (std::size_t i = 0; i < newton_steps<T>; ++i) {
+    y = T{0.5} * (y + mantissa / y);
+  }
+  return ldexp(y, exponent / 2);
+}
+
+/* x positive and finite */
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+cbrt_newton_raphson(T x) noexcept
+{
+  auto [mantissa, exponent] = frexp(x);
+  int const remainder = ((exponent % 3) + 3) % 3;
+  mantissa = ldexp(mantissa, remainder);
+  exponent -= remainder;
+
+  /* mantissa in [0.5, 4), the chord through both ends is within 2^-3 of cbrt(m) */
+  T y = T{0.681} + T{0.2266} * mantissa;
+  for (std::size_t i = 0; i < newton_steps<T>; ++i) {
+    y -= (y * y * y - mantissa) / (T{3} * y * y);
+  }
+  return ldexp(y, exponent / 3);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+hypot_impl(T x, T y) noexcept
+{
+  x = abs(x);
+  y = abs(y);
+  if (is_inf(x) || is_inf(y)) {
+    return std::numeric_limits<T>::infinity();
+  }
+  if (is_nan(x) || is_nan(y)) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+
+  T const max = x < y ? y : x;
+  T const min = x < y ? x : y;
+  if (max == T{}) {
+    return T{};
+  }
+  T const ratio = min / max;
+  return max * sqrt_newton_raphson(T{1} + ratio * ratio);
+}
+
+template <std::floating_point T>
+struct reduced_angle
+{
+  T remainder;        /* in [-pi/4, pi/4] */
+  unsigned quadrant;  /* multiple of pi/2 modulo 4 */
+};
+
+/* Cody-Waite reduction by pi/2 with the fdlibm three-part split, exact while
+ * the multiple fits into 20 bits (|x| < ~1.6e6) and losing accuracy beyond.
+ * From 2^digits of the wide type on (2^53 ~ 9e15 for float and double)
+ * neighbouring arguments lie more than a quadrant apart, so there the
+ * remainder is NaN; the bound also keeps the multiple within long long. */
+template <std::floating_point T>
+[[nodiscard]] constexpr reduced_angle<wide_float_t<T>>
+reduce_angle(T x) noexcept
+{
+  using W = wide_float_t<T>;
+  constexpr W pio2_1 = 1.57079632673412561417e+00;
+  constexpr W pio2_2 = 6.07710050630396597660e-11;
+  constexpr W pio2_3 = 2.02226624871116645580e-21;
+  constexpr W pio2_3t = 8.47842766036889956997e-32;
+
+  W const wx = x;
+  W const scaled = wx * W{2} / std::numbers::pi_v<W>;
+  constexpr int digits = std::numeric_limits<W>::digits;
+  if (!(abs(wx) < ldexp(W{1}, digits < 62 ? digits : 62))) {
+    return {std::numeric_limits<W>::quiet_NaN(), 0};
+  }
+  auto const k = static_cast<long long>(scaled < W{} ? scaled - W{0.5} : scaled + W{0.5});
+  auto const wk = static_cast<W>(k);
+
+  return {
+    ((wx - wk * pio2_1) - wk * pio2_2) - wk * pio2_3 - wk * pio2_3t,
+    static_cast<unsigned>(k & 3)
+  };
+}
+
+/* Taylor series on [-pi/4, pi/4] */
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sin_series(T x) noexcept
+{
+  T term = x;
+  T sum = x;
+  for (std::size_t i = 1; i < series_terms<T>; ++i) {
+    auto const n = static_cast<T>(2 * i);
+    term *= -x * x / (n * (n + T{1}));
+    sum += term;
+  }
+  return sum;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+cos_series(T x) noexcept
+{
+  T term{1};
+  T sum{1};
+  for (std::size_t i = 1; i < series_terms<T>; ++i) {
+    auto const n = static_cast<T>(2 * i);
+    term *= -x * x / ((n - T{1}) * n);
+    sum += term;
+  }
+  return sum;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sin_impl(T x) noexcept
+{
+  if (is_nan(x) || is_inf(x)) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  auto const [r, quadrant] = reduce_angle(x);
+  switch (quadrant) {
+    case 0: return static_cast<T>(sin_series(r));
+    case 1: return static_cast<T>(cos_series(r));
+    case 2: return static_cast<T>(-sin_series(r));
+    default: return static_cast<T>(-cos_series(r));
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+cos_impl(T x) noexcept
+{
+  if (is_nan(x) || is_inf(x)) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  auto const [r, quadrant] = reduce_angle(x);
+  switch (quadrant) {
+    case 0: return static_cast<T>(cos_series(r));
+    case 1: return static_cast<T>(-sin_series(r));
+    case 2: return static_cast<T>(-cos_series(r));
+    default: return static_cast<T>(sin_series(r));
+  }
+}
+
+/* |x| <= 1, halved twice by atan(x) = 2 atan(x / (1 + sqrt(1 + x^2)))
+ * so the series argument stays below tan(pi/16) */
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+atan_series(T x) noexcept
+{
+  for (int i = 0; i < 2; ++i) {
+    x /= T{1} + sqrt_newton_raphson(T{1} + x * x);
+  }
+
+  T power = x;
+  T sum = x;
+  for (std::size_t i = 1; i < series_terms<T>; ++i) {
+    power *= -x * x;
+    sum += power / static_cast<T>(2 * i + 1);
+  }
+  return T{4} * sum;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+atan2_impl(T y, T x) noexcept
+{
+  if (is_nan(x) || is_nan(y)) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+
+  /* signs come from the sign bits, so signed zeros select the quadrant
+   * like std::atan2: atan2(-0, -1) is -pi and atan2(+0, -0) is pi */
+  using W = wide_float_t<T>;
+  W const abs_x = abs(static_cast<W>(x));
+  W const abs_y = abs(static_cast<W>(y));
+  W result;
+  if (abs_x == W{} && abs_y == W{}) {
+    result = W{};
+  } else if (is_inf(abs_x) && is_inf(abs_y)) {
+    result = std::numbers::pi_v<W> / W{4};
+  } else {
+    result = abs_y > abs_x
+      ? std::numbers::pi_v<W> / W{2} - atan_series(abs_x / abs_y)
+      : atan_series(abs_y / abs_x);
+  }
+  result = sign_bit(x) ? std::numbers::pi_v<W> - result : result;
+  return static_cast<T>(sign_bit(y) ? -result : result);
+}
+
 template <std::floating_point T>
 [[nodiscard]] constexpr T
-sqrt_newton_raphson(T x, T curr, T prev) noexcept
+acos_impl(T x) noexcept
 {
-  return curr == prev
-    ? curr
-    : sqrt_newton_raphson(x, T{0.5} * (curr + x / curr), curr);
+  if (is_nan(x) || abs(x) > T{1}) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  using W = wide_float_t<T>;
+  W const wx = x;
+  W const sine_squared = (W{1} - wx) * (W{1} + wx);
+  return static_cast<T>(atan2_impl(
+    sine_squared == W{} ? W{} : sqrt_newton_raphson(sine_squared), wx));
 }
 
 } // namespace detail
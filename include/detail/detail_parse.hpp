@@ -0,0 +1,108 @@
+#ifndef GEO_DETAIL_PARSE_HPP
+#define GEO_DETAIL_PARSE_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace geo::detail {
+
+[[nodiscard]] constexpr bool
+is_space(char c) noexcept
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+[[nodiscard]] constexpr bool
+is_alpha(char c) noexcept
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+[[nodiscard]] inline std::invalid_argument
+parse_error(std::string_view what, std::size_t offset)
+{
+  return std::invalid_argument(
+    std::string(what) + " at offset " + std::to_string(offset));
+}
+
+/* Parses the number at the front of text and advances text past it. */
+template <std::floating_point T>
+[[nodiscard]] T
+consume_number(std::string_view & text, std::size_t offset)
+{
+  /* from_chars rejects an explicit plus sign */
+  if (!text.empty() && text.front() == '+') {
+    text.remove_prefix(1);
+  }
+  T value{};
+  auto const [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc{}) {
+    throw parse_error("invalid number", offset);
+  }
+  text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+  return value;
+}
+
+/* Splits a stream of chunks at token boundaries without allocating. The text
+ * after the last separator of a chunk may continue in the next one, it is
+ * kept in a fixed buffer and completed from the front of the next chunk. */
+template <std::size_t Capacity = 256>
+struct chunk_carry
+{
+  template <typename IsSeparator, typename Parse>
+  void
+  feed(std::string_view chunk, IsSeparator is_separator, Parse parse)
+  {
+    if (size != 0) {
+      auto const first = std::find_if(chunk.begin(), chunk.end(), is_separator);
+      auto const head = static_cast<std::size_t>(first - chunk.begin());
+      append(chunk.substr(0, head));
+      if (first == chunk.end()) {
+        return;
+      }
+      flush(parse);
+      chunk.remove_prefix(head);
+    }
+
+    auto const last = std::find_if(chunk.rbegin(), chunk.rend(), is_separator);
+    auto const complete = static_cast<std::size_t>(chunk.rend() - last);
+    if (complete != 0) {
+      parse(chunk.substr(0, complete), consumed);
+      consumed += complete;
+    }
+    append(chunk.substr(complete));
+  }
+
+  template <typename Parse>
+  void
+  flush(Parse parse)
+  {
+    parse(std::string_view(buffer.data(), size), consumed);
+    consumed += size;
+    size = 0;
+  }
+
+  void
+  append(std::string_view text)
+  {
+    if (text.size() > Capacity - size) {
+      throw parse_error("token too long", consumed + size);
+    }
+    std::copy(text.begin(), text.end(), buffer.begin() + static_cast<std::ptrdiff_t>(size));
+    size += text.size();
+  }
+
+  std::array<char, Capacity> buffer{};
+  std::size_t size{};
+  std::size_t consumed{};
+};
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,617 @@
+#ifndef GEO_DETAIL_POINT_CLOUD_HPP
+#define GEO_DETAIL_POINT_CLOUD_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../point.hpp"
+#include "../traits.hpp"
+#include "detail_execution.hpp"
+#include "detail_spatial_sort.hpp"
+
+namespace geo::detail {
+
+template <typename Range>
+using cloud_point_t = std::ranges::range_value_t<Range>;
+
+template <typename Range>
+using coordinates_t = std::array<traits::value_type_t<cloud_point_t<Range>>, traits::dimension_v<cloud_point_t<Range>>>;
+
+template <typename Range>
+[[nodiscard]] coordinates_t<Range>
+cloud_at(Range const & points, std::size_t i) noexcept
+{
+  return sort_position(std::ranges::begin(points)[static_cast<std::ranges::range_difference_t<Range>>(i)]);
+}
+
+/* lower and upper corner of the bounding box of a non-empty point range */
+template <bool Parallel, typename Range>
+[[nodiscard]] std::pair<coordinates_t<Range>, coordinates_t<Range>>
+cloud_bounds(Range const & points)
+{
+  using Coordinates = coordinates_t<Range>;
+
+  std::size_t const count = std::ranges::size(points);
+  std::size_t const blocks = Parallel ? std::clamp<std::size_t>(count / 65536, 1, worker_count()) : 1;
+  std::vector<std::pair<Coordinates, Coordinates>> partial(blocks);
+  for_each_block<Parallel>(blocks, [&](std::size_t b) {
+    std::size_t const first = count * b / blocks;
+    auto & [lower, upper] = partial[b];
+    lower = upper = cloud_at(points, first);
+    for (std::size_t i = first + 1, last = count * (b + 1) / blocks; i < last; ++i) {
+      auto const p = cloud_at(points, i);
+      for (std::size_t k = 0; k < p.size(); ++k) {
+        lower[k] = std::min(lower[k], p[k]);
+        upper[k] = std::max(upper[k], p[k]);
+      }
+    }
+  });
+  auto retval = partial[0];
+  for (auto const & [lower, upper] : partial) {
+    for (std::size_t k = 0; k < lower.size(); ++k) {
+      retval.first[k] = std::min(retval.first[k], lower[k]);
+      retval.second[k] = std::max(retval.second[k], upper[k]);
+    }
+  }
+  return retval;
+}
+
+/* Cells of side size over the bounding box of the points. Cell coordinates
+ * fit the bits of a 64-bit Morton key, so a cell is one integer. */
+template <typename Coordinates>
+struct cloud_grid
+{
+  static constexpr std::size_t dimension = std::tuple_size_v<Coordinates>;
+  using value_type = typename Coordinates::value_type;
+
+  Coordinates lower;
+  value_type inverse_size;
+  std::array<std::uint32_t, dimension> extent;
+
+  cloud_grid(Coordinates const & lower_corner, Coordinates const & upper_corner, value_type size)
+    : lower(lower_corner), inverse_size(1 / size), extent{}
+  {
+    if (!(size > 0)) {
+      throw std::invalid_argument("non-positive cell size");
+    }
+    constexpr double limit = static_cast<double>((std::uint64_t{1} << key_bits<dimension>) - 1);
+    for (std::size_t k = 0; k < dimension; ++k) {
+      double const cells = std::floor((static_cast<double>(upper_corner[k]) - static_cast<double>(lower[k])) * static_cast<double>(inverse_size));
+      if (!(cells <= limit)) {
+        throw std::invalid_argument("cell size too small for the extent of the points");
+      }
+      extent[k] = static_cast<std::uint32_t>(cells) + 1;
+    }
+  }
+
+  [[nodiscard]] std::array<std::uint32_t, dimension>
+  cell(Coordinates const & p) const noexcept
+  {
+    std::array<std::uint32_t, dimension> retval{};
+    for (std::size_t k = 0; k < dimension; ++k) {
+      auto const c = static_cast<std::uint32_t>(std::max(value_type{}, (p[k] - lower[k]) * inverse_size));
+      retval[k] = std::min(c, extent[k] - 1);
+    }
+    return retval;
+  }
+};
+
+/* the points sorted by Morton key of their cell */
+template <bool Parallel, typename Range, typename Grid>
+[[nodiscard]] std::vector<keyed_index>
+sorted_by_cell(Range const & points, Grid const & grid)
+{
+  std::vector<keyed_index> items(std::ranges::size(points));
+  auto const key = [&](std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      items[i] = {interleave<Grid::dimension>(grid.cell(cloud_at(points, i))), i};
+    }
+  };
+  if constexpr (Parallel) {
+    parallel_for(items.size(), key);
+  } else {
+    key(0, items.size());
+  }
+  radix_sort<Parallel>(items);
+  return items;
+}
+
+/***************************** voxel downsampling ********************************/
+
+/* centroids of the points in each voxel, in Morton order of the voxels */
+template <bool Parallel, typename Range>
+[[nodiscard]] std::vector<cloud_point_t<Range>>
+voxel_downsample(Range const & points, traits::value_type_t<cloud_point_t<Range>> voxel_size)
+{
+  using Point = cloud_point_t<Range>;
+  using T = traits::value_type_t<Point>;
+
+  if (std::ranges::empty(points)) {
+    return {};
+  }
+  auto const [lower, upper] = cloud_bounds<Parallel>(points);
+  cloud_grid<coordinates_t<Range>> const grid(lower, upper, voxel_size);
+  auto const items = sorted_by_cell<Parallel>(points, grid);
+
+  std::vector<std::size_t> runs;
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (i == 0 || items[i].key != items[i - 1].key) {
+      runs.push_back(i);
+    }
+  }
+  runs.push_back(items.size());
+
+  std::vector<Point> retval(runs.size() - 1);
+  auto const average = [&](std::size_t first, std::size_t last) {
+    for (std::size_t r = first; r < last; ++r) {
+      coordinates_t<Range> sum{};
+      for (std::size_t i = runs[r]; i < runs[r + 1]; ++i) {
+        auto const p = cloud_at(points, items[i].index);
+        for (std::size_t k = 0; k < sum.size(); ++k) {
+          sum[k] += p[k];
+        }
+      }
+      for (auto & s : sum) {
+        s /= static_cast<T>(runs[r + 1] - runs[r]);
+      }
+      retval[r] = to_point<Point>(sum);
+    }
+  };
+  if constexpr (Parallel) {
+    parallel_for(retval.size(), average);
+  } else {
+    average(0, retval.size());
+  }
+  return retval;
+}
+
+/***************************** welding ********************************/
+
+/* Open addressing from cell keys to the last representative point in the
+ * cell; the representatives of a cell are chained through next. */
+class cell_table
+{
+public:
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  explicit cell_table(std::size_t count)
+    : keys_(std::bit_ceil(2 * count + 2)), heads_(keys_.size(), none), mask_(keys_.size() - 1)
+  {
+  }
+
+  [[nodiscard]] std::size_t
+  head(std::uint64_t key) const noexcept
+  {
+    for (std::size_t slot = hash(key);; slot = (slot + 1) & mask_) {
+      if (heads_[slot] == none || keys_[slot] == key) {
+        return heads_[slot];
+      }
+    }
+  }
+
+  /* makes rep the head of its cell, returns the previous head */
+  std::size_t
+  push(std::uint64_t key, std::size_t rep) noexcept
+  {
+    for (std::size_t slot = hash(key);; slot = (slot + 1) & mask_) {
+      if (heads_[slot] == none || keys_[slot] == key) {
+        keys_[slot] = key;
+        return std::exchange(heads_[slot], rep);
+      }
+    }
+  }
+
+private:
+  [[nodiscard]] std::size_t
+  hash(std::uint64_t key) const noexcept
+  {
+    return ((key * 0x9E3779B97F4A7C15u) >> 32) & mask_;
+  }
+
+  std::vector<std::uint64_t> keys_;
+  std::vector<std::size_t> heads_;
+  std::size_t mask_;
+};
+
+/* Greedy welding in input order: a point joins the earliest representative
+ * within epsilon, else becomes one. Chains list the newest representative
+ * first, so every probed chain is searched to its end for the smallest
+ * index; representatives are more than epsilon apart, so few share a cell. In cells of side 2 epsilon, those near a
+ * point lie in its cell or the neighbours towards the half of the cell it is
+ * in, 2^dim cells rather than 3^dim. The cells are not bounded by the bits of a Morton key, so
+ * epsilon may be tiny against the extent; the table keys hash them, and a
+ * collision only costs a distance test. Returns the representatives and, per
+ * point, its one. */
+template <bool Parallel, typename Range>
+[[nodiscard]] std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+weld(Range const & points, traits::value_type_t<cloud_point_t<Range>> epsilon)
+{
+  using T = traits::value_type_t<cloud_point_t<Range>>;
+  constexpr std::size_t dim = traits::dimension_v<cloud_point_t<Range>>;
+  using Cell = std::array<std::int64_t, dim>;
+
+  if (!(epsilon > 0)) {
+    throw std::invalid_argument("non-positive weld distance");
+  }
+  std::size_t const count = std::ranges::size(points);
+  std::vector<std::size_t> reps;
+  std::vector<std::size_t> remap(count);
+  if (count == 0) {
+    return {reps, remap};
+  }
+  auto const [lower, upper] = cloud_bounds<Parallel>(points);
+  for (std::size_t d = 0; d < dim; ++d) {
+    if (!(static_cast<double>(upper[d] - lower[d]) / static_cast<double>(epsilon) < 0x1p51)) {
+      throw std::invalid_argument("weld distance too small for the extent of the points");
+    }
+  }
+
+  auto const hash_cell = [](Cell const & cell) {
+    std::uint64_t h = 0;
+    for (auto const c : cell) {
+      h = (h ^ static_cast<std::uint64_t>(c)) * 0xFF51AFD7ED558CCDu;
+    }
+    return h ^ (h >> 29);
+  };
+
+  /* the cells are the part worth doing concurrently, the greedy pass is
+   * order dependent */
+  std::vector<Cell> cells(count);
+  std::vector<std::array<std::int8_t, dim>> towards(count);
+  T const inverse_size = 1 / (2 * epsilon);
+  auto const locate = [&](std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      auto const p = cloud_at(points, i);
+      for (std::size_t d = 0; d < dim; ++d) {
+        T const position = (p[d] - lower[d]) * inverse_size;
+        T const cell = std::floor(position);
+        cells[i][d] = static_cast<std::int64_t>(cell);
+        towards[i][d] = static_cast<std::int8_t>(position - cell < T{0.5} ? -1 : 1);
+      }
+    }
+  };
+  if constexpr (Parallel) {
+    parallel_for(count, locate);
+  } else {
+    locate(0, count);
+  }
+
+  cell_table table(count);
+  std::vector<std::size_t> next;
+  T const squared_epsilon = epsilon * epsilon;
+  constexpr std::size_t neighbours = std::size_t{1} << dim;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const p = cloud_at(points, i);
+    std::size_t found = cell_table::none;
+    for (std::size_t n = 0; n < neighbours; ++n) {
+      Cell cell = cells[i];
+      for (std::size_t d = 0; d < dim; ++d) {
+        cell[d] += ((n >> d) & 1) != 0 ? towards[i][d] : 0;
+      }
+      for (std::size_t r = table.head(hash_cell(cell)); r != cell_table::none; r = next[r]) {
+        auto const q = cloud_at(points, reps[r]);
+        T squared_distance{};
+        for (std::size_t d = 0; d < dim; ++d) {
+          squared_distance += (p[d] - q[d]) * (p[d] - q[d]);
+        }
+        if (squared_distance <= squared_epsilon) {
+          found = std::min(found, r);
+        }
+      }
+    }
+    if (found == cell_table::none) {
+      found = reps.size();
+      reps.push_back(i);
+      next.push_back(table.push(hash_cell(cells[i]), found));
+    }
+    remap[i] = found;
+  }
+  return {reps, remap};
+}
+
+/***************************** normals ********************************/
+
+/* Eigenvector of the smallest eigenvalue of a symmetric matrix by cyclic
+ * Jacobi rotations, exact to rounding for the 2x2 and 3x3 covariances of
+ * normal estimation in a few sweeps. */
+template <typename T, std::size_t N>
+[[nodiscard]] std::array<T, N>
+smallest_eigenvector(std::array<std::array<T, N>, N> a) noexcept
+{
+  std::array<std::array<T, N>, N> v{};
+  for (std::size_t i = 0; i < N; ++i) {
+    v[i][i] = 1;
+  }
+  for (int sweep = 0; sweep < 16; ++sweep) {
+    T off{};
+    T diagonal{};
+    for (std::size_t p = 0; p < N; ++p) {
+      diagonal += a[p][p] * a[p][p];
+      for (std::size_t q = p + 1; q < N; ++q) {
+        off += a[p][q] * a[p][q];
+      }
+    }
+    if (!(off > diagonal * std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon())) {
+      break;
+    }
+    for (std::size_t p = 0; p < N; ++p) {
+      for (std::size_t q = p + 1; q < N; ++q) {
+        if (a[p][q] == 0) {
+          continue;
+        }
+        T const theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+        T const t = std::copysign(T{1}, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+        T const c = 1 / std::sqrt(t * t + 1);
+        T const s = t * c;
+        for (std::size_t k = 0; k < N; ++k) {
+          T const akp = a[k][p], akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          T const apk = a[p][k], aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          T const vkp = v[k][p], vkq = v[k][q];
+          v[k][p] = c * vkp - s * vkq;
+          v[k][q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  std::size_t smallest = 0;
+  for (std::size_t i = 1; i < N; ++i) {
+    if (a[i][i] < a[smallest][smallest]) {
+      smallest = i;
+    }
+  }
+  std::array<T, N> retval{};
+  for (std::size_t k = 0; k < N; ++k) {
+    retval[k] = v[k][smallest];
+  }
+  return retval;
+}
+
+/* Normal of each point: the direction of least variance of its k nearest
+ * neighbours, itself included. The neighbours are searched in a hashed grid,
+ * ring by ring of cells around the point's own, until no unvisited cell can
+ * hold a nearer one. Scans are surfaces, or curves in 2D, so the number of
+ * occupied cells grows with the cell size to the power dim - 1, not dim: a
+ * first grid from the volume measures it and the cell size is scaled so
+ * that occupied cells hold about k / 2 points, which mostly ends the search
+ * after the first ring. */
+template <bool Parallel, typename Range>
+[[nodiscard]] std::vector<cloud_point_t<Range>>
+estimate_normals(Range const & points, std::size_t k)
+{
+  using Point = cloud_point_t<Range>;
+  using T = traits::value_type_t<Point>;
+  using Coordinates = coordinates_t<Range>;
+  using Grid = cloud_grid<Coordinates>;
+  constexpr std::size_t dim = traits::dimension_v<Point>;
+
+  if (k < dim) {
+    throw std::invalid_argument("too few neighbours for a normal");
+  }
+  std::size_t const count = std::ranges::size(points);
+  if (count == 0) {
+    return {};
+  }
+  k = std::min(k, count);
+
+  auto const [lower, upper] = cloud_bounds<Parallel>(points);
+  T largest{};
+  for (std::size_t d = 0; d < dim; ++d) {
+    largest = std::max(largest, upper[d] - lower[d]);
+  }
+  if (!(largest > 0)) {
+    largest = 1;
+  }
+  auto const occupied = [](std::vector<keyed_index> const & items) {
+    std::size_t retval = 0;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+      retval += (i == 0 || items[i].key != items[i - 1].key) ? 1U : 0U;
+    }
+    return retval;
+  };
+  /* no finer than the Morton keys allow */
+  double const finest = static_cast<double>(largest) / static_cast<double>(std::uint64_t{1} << (key_bits<dim> - 1));
+
+  double volume = 1.0;
+  for (std::size_t d = 0; d < dim; ++d) {
+    volume *= std::max(static_cast<double>(upper[d] - lower[d]), static_cast<double>(largest) * 1e-3);
+  }
+  double const density = static_cast<double>(count) / static_cast<double>(k);
+  double size = std::max(finest, std::pow(volume / density, 1.0 / static_cast<double>(dim)));
+  double const per_cell = static_cast<double>(count) / static_cast<double>(occupied(sorted_by_cell<Parallel>(points, Grid(lower, upper, static_cast<T>(size)))));
+  double const target = std::max(2.0, static_cast<double>(k) / 2.0);
+  size = std::max(finest, size * std::pow(target / per_cell, 1.0 / static_cast<double>(dim - 1)));
+
+  Grid const grid(lower, upper, static_cast<T>(size));
+  auto const items = sorted_by_cell<Parallel>(points, grid);
+  std::vector<std::size_t> runs;
+  cell_table table(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i == 0 || items[i].key != items[i - 1].key) {
+      static_cast<void>(table.push(items[i].key, runs.size()));
+      runs.push_back(i);
+    }
+  }
+  runs.push_back(count);
+  std::vector<Coordinates> sorted(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    sorted[i] = cloud_at(points, items[i].index);
+  }
+
+  std::uint32_t max_extent = 0;
+  for (auto const e : grid.extent) {
+    max_extent = std::max(max_extent, e);
+  }
+  std::size_t const scan_budget = 4 * (runs.size() - 1) + 64;
+
+  std::vector<Point> retval(count);
+  auto const work = [&](std::size_t first, std::size_t last) {
+    /* max-heap of (squared distance, sorted index) of the nearest so far */
+    std::vector<std::pair<T, std::size_t>> nearest;
+    nearest.reserve(k);
+    /* the points of the cells next to the current one, shared by all the
+     * points of the cell as they come in a row */
+    std::vector<std::pair<std::size_t, std::size_t>> around;
+    std::uint64_t around_key = std::numeric_limits<std::uint64_t>::max();
+
+    for (std::size_t i = first; i < last; ++i) {
+      Coordinates const & p = sorted[i];
+      auto const home = grid.cell(p);
+      nearest.clear();
+      auto const consider = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t j = begin; j < end; ++j) {
+          T squared_distance{};
+          for (std::size_t d = 0; d < dim; ++d) {
+            squared_distance += (sorted[j][d] - p[d]) * (sorted[j][d] - p[d]);
+          }
+          if (nearest.size() < k) {
+            nearest.emplace_back(squared_distance, j);
+            std::ranges::push_heap(nearest);
+          } else if (squared_distance < nearest.front().first) {
+            std::ranges::pop_heap(nearest);
+            nearest.back() = {squared_distance, j};
+            std::ranges::push_heap(nearest);
+          }
+        }
+      };
+      /* Calls f(run) for the occupied cells at Chebyshev distance ring and
+       * returns how many cells of the grid that ring has. Only the shell is
+       * enumerated: face by face, the cells with offset -ring or ring along
+       * the face dimension, strictly inside along earlier dimensions, so
+       * every cell comes once. */
+      auto const for_each_on_ring = [&](std::uint32_t ring, auto && f) {
+        auto const reach = static_cast<std::int64_t>(ring);
+        std::size_t visited = 0;
+        for (std::size_t face = 0; face < dim; ++face) {
+          std::array<std::int64_t, dim> low{};
+          std::array<std::int64_t, dim> high{};
+          bool empty = false;
+          for (std::size_t d = 0; d < dim; ++d) {
+            std::int64_t const inner = d < face ? 1 : 0;
+            low[d] = std::max(-reach + inner, -static_cast<std::int64_t>(home[d]));
+            high[d] = std::min(reach - inner, static_cast<std::int64_t>(grid.extent[d]) - 1 - static_cast<std::int64_t>(home[d]));
+            empty = empty || (d != face && low[d] > high[d]);
+          }
+          if (empty) {
+            continue;
+          }
+          for (std::int64_t const side : {-reach, reach}) {
+            std::int64_t const along = static_cast<std::int64_t>(home[face]) + side;
+            if (along < 0 || along >= static_cast<std::int64_t>(grid.extent[face])) {
+              continue;
+            }
+            std::array<std::int64_t, dim> offset = low;
+            offset[face] = side;
+            for (;;) {
+              std::array<std::uint32_t, dim> cell{};
+              for (std::size_t d = 0; d < dim; ++d) {
+                cell[d] = static_cast<std::uint32_t>(static_cast<std::int64_t>(home[d]) + offset[d]);
+              }
+              ++visited;
+              if (std::size_t const r = table.head(interleave<dim>(cell)); r != cell_table::none) {
+                f(r);
+              }
+              std::size_t d = 0;
+              for (; d < dim; ++d) {
+                if (d == face) {
+                  continue;
+                }
+                if (offset[d] < high[d]) {
+                  ++offset[d];
+                  break;
+                }
+                offset[d] = low[d];
+              }
+              if (d == dim) {
+                break;
+              }
+            }
+            if (ring == 0) {
+              break;
+            }
+          }
+        }
+        return visited;
+      };
+
+      if (items[i].key != around_key) {
+        around_key = items[i].key;
+        around.clear();
+        for (std::uint32_t ring = 0; ring < 2; ++ring) {
+          for_each_on_ring(ring, [&](std::size_t r) { around.emplace_back(runs[r], runs[r + 1]); });
+        }
+      }
+      for (auto const & [begin, end] : around) {
+        consider(begin, end);
+      }
+      /* Cells beyond a ring are at least ring cells away. Far from the
+       * rest of the cloud, as for outliers, rings hold many empty cells;
+       * once they took more lookups than there are occupied cells, a scan
+       * of all points is cheaper than going on. */
+      std::size_t visited = 0;
+      for (std::uint32_t ring = 2; ring <= max_extent; ++ring) {
+        auto const reach = static_cast<T>(static_cast<double>(ring - 1) * size);
+        if (nearest.size() == k && nearest.front().first <= reach * reach) {
+          break;
+        }
+        if (visited > scan_budget) {
+          nearest.clear();
+          consider(0, count);
+          break;
+        }
+        visited += for_each_on_ring(ring, [&](std::size_t r) { consider(runs[r], runs[r + 1]); });
+      }
+
+      Coordinates mean{};
+      for (auto const & [squared_distance, j] : nearest) {
+        for (std::size_t d = 0; d < dim; ++d) {
+          mean[d] += sorted[j][d];
+        }
+      }
+      for (auto & m : mean) {
+        m /= static_cast<T>(nearest.size());
+      }
+      std::array<std::array<T, dim>, dim> covariance{};
+      for (auto const & [squared_distance, j] : nearest) {
+        for (std::size_t r = 0; r < dim; ++r) {
+          for (std::size_t c = r; c < dim; ++c) {
+            covariance[r][c] += (sorted[j][r] - mean[r]) * (sorted[j][c] - mean[c]);
+          }
+        }
+      }
+      for (std::size_t r = 0; r < dim; ++r) {
+        for (std::size_t c = 0; c < r; ++c) {
+          covariance[r][c] = covariance[c][r];
+        }
+      }
+      retval[items[i].index] = to_point<Point>(smallest_eigenvector(covariance));
+    }
+  };
+  if constexpr (Parallel) {
+    parallel_for(count, work);
+  } else {
+    work(0, count);
+  }
+  return retval;
+}
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef GEO_DETAIL_PREDICATES_HPP
+#define GEO_DETAIL_PREDICATES_HPP
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace geo::detail {
+
+/* Error free transformations (Knuth, Dekker), a + b == s + e exactly */
+template <std::floating_point T>
+struct exact_sum
+{
+  T value;
+  T error;
+};
+
+template <std::floating_point T>
+[[nodiscard]] constexpr exact_sum<T>
+two_sum(T a, T b) noexcept
+{
+  T const s = a + b;
+  T const bv = s - a;
+  T const av = s - bv;
+  return {s, (a - av) + (b - bv)};
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr exact_sum<T>
+two_product(T a, T b) noexcept
+{
+  T const p = a * b;
+  if (std::is_constant_evaluated()) {
+    /* Veltkamp split, no contraction happens in constant evaluation */
+    constexpr T splitter = static_cast<T>((1ull << ((std::numeric_limits<T>::digits + 1) / 2)) + 1);
+    auto const split = [](T x) {
+      T const c = splitter * x;
+      T const hi = c - (c - x);
+      return std::pair{hi, x - hi};
+    };
+    auto const [ahi, alo] = split(a);
+    auto const [bhi, blo] = split(b);
+    return {p, alo * blo - (((p - ahi * bhi) - alo * bhi) - ahi * blo)};
+  } else {
+    return {p, std::fma(a, b, -p)};
+  }
+}
+
+/* Sign of the exact sum of terms. The terms are accumulated into a
+ * nonoverlapping expansion of increasing magnitude, whose largest nonzero
+ * component carries the sign of the sum. */
+template <std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr int
+exact_sign(std::array<T, N> const & terms) noexcept
+{
+  std::array<T, N> expansion{};
+  std::size_t size = 0;
+  for (T const term : terms) {
+    T q = term;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      auto const [sum, error] = two_sum(q, expansion[i]);
+      q = sum;
+      if (error != T{}) {
+        expansion[kept++] = error;
+      }
+    }
+    if (q != T{}) {
+      expansion[kept++] = q;
+    }
+    size = kept;
+  }
+  if (size == 0) {
+    return 0;
+  }
+  return expansion[size - 1] > T{} ? 1 : -1;
+}
+
+/* sign of (ax - cx) (by - cy) - (ay - cy) (bx - cx), exact as long as no
+ * product overflows or underflows */
+template <std::floating_point T>
+[[nodiscard]] constexpr int
+orientation(T ax, T ay, T bx, T by, T cx, T cy) noexcept
+{
+  /* forward error bound of the naive evaluation (Shewchuk) */
+  constexpr T half_epsilon = std::numeric_limits<T>::epsilon() / 2;
+  constexpr T error_bound = (T{3} + T{16} * half_epsilon) * half_epsilon;
+
+  T const left = (ax - cx) * (by - cy);
+  T const right = (ay - cy) * (bx - cx);
+  T const det = left - right;
+  T const magnitude = (left < T{} ? -left : left) + (right < T{} ? -right : right);
+  if (det > error_bound * magnitude) {
+    return 1;
+  }
+  if (-det > error_bound * magnitude) {
+    return -1;
+  }
+
+  /* expanded form ax by - ay bx + bx cy - by cx + cx ay - cy ax, every
+   * product split into a pair of doubles */
+  std::array<T, 12> terms{};
+  std::array const products{
+    two_product(ax, by), two_product(-ay, bx), two_product(bx, cy),
+    two_product(-by, cx), two_product(cx, ay), two_product(-cy, ax)
+  };
+  for (std::size_t i = 0; i < products.size(); ++i) {
+    terms[2 * i] = products[i].value;
+    terms[2 * i + 1] = products[i].error;
+  }
+  return exact_sign(terms);
+}
+
+/* four terms whose exact sum is a * b * c */
+template <std::floating_point T>
+[[nodiscard]] constexpr std::array<T, 4>
+three_product(T a, T b, T c) noexcept
+{
+  auto const ab = two_product(a, b);
+  auto const high = two_product(ab.value, c);
+  auto const low = two_product(ab.error, c);
+  return {high.value, high.error, low.value, low.error};
+}
+
+/* sign of det[b - a, c - a, d - a], exact as long as no product overflows
+ * or underflows */
+template <std::floating_point T>
+[[nodiscard]] constexpr int
+orientation(std::array<T, 3> const & a, std::array<T, 3> const & b,
+            std::array<T, 3> const & c, std::array<T, 3> const & d) noexcept
+{
+  constexpr T half_epsilon = std::numeric_limits<T>::epsilon() / 2;
+  constexpr T error_bound = (T{7} + T{56} * half_epsilon) * half_epsilon;
+  constexpr auto abs = [](T x) { return x < T{} ? -x : x; };
+
+  std::array<T, 3> u{}, v{}, w{};
+  for (std::size_t k = 0; k < 3; ++k) {
+    u[k] = b[k] - a[k];
+    v[k] = c[k] - a[k];
+    w[k] = d[k] - a[k];
+  }
+  T const det = u[0] * (v[1] * w[2] - v[2] * w[1])
+              + u[1] * (v[2] * w[0] - v[0] * w[2])
+              + u[2] * (v[0] * w[1] - v[1] * w[0]);
+  T const permanent = abs(u[0]) * (abs(v[1] * w[2]) + abs(v[2] * w[1]))
+                    + abs(u[1]) * (abs(v[2] * w[0]) + abs(v[0] * w[2]))
+                    + abs(u[2]) * (abs(v[0] * w[1]) + abs(v[1] * w[0]));
+  if (det > error_bound * permanent) {
+    return 1;
+  }
+  if (-det > error_bound * permanent) {
+    return -1;
+  }
+
+  /* multilinear expansion in the raw coordinates,
+   * det(b, c, d) - det(a, c, d) + det(a, b, d) - det(a, b, c) */
+  std::array<T, 96> terms{};
+  std::size_t size = 0;
+  auto const add_det = [&](std::array<T, 3> const & p, std::array<T, 3> const & q,
+                           std::array<T, 3> const & r, T sign) {
+    for (std::size_t i = 0; i < 3; ++i) {
+      std::size_t const j = (i + 1) % 3;
+      std::size_t const k = (i + 2) % 3;
+      for (T const term : three_product(sign * p[i], q[j], r[k])) {
+        terms[size++] = term;
+      }
+      for (T const term : three_product(-sign * p[i], q[k], r[j])) {
+        terms[size++] = term;
+      }
+    }
+  };
+  add_det(b, c, d, T{1});
+  add_det(a, c, d, T{-1});
+  add_det(a, b, d, T{1});
+  add_det(a, b, c, T{-1});
+  return exact_sign(terms);
+}
+
+/* eight terms whose exact sum is a * b * c * d */
+template <std::floating_point T>
+[[nodiscard]] constexpr std::array<T, 8>
+four_product(T a, T b, T c, T d) noexcept
+{
+  std::array<T, 8> retval{};
+  auto const abc = three_product(a, b, c);
+  for (std::size_t i = 0; i < abc.size(); ++i) {
+    auto const [value, error] = two_product(abc[i], d);
+    retval[2 * i] = value;
+    retval[2 * i + 1] = error;
+  }
+  return retval;
+}
+
+/* sign of det[a - d, |a - d|^2; b - d, |b - d|^2; c - d, |c - d|^2], exact
+ * as long as no product overflows or underflows */
+template <std::floating_point T>
+[[nodiscard]] constexpr int
+incircle(std::array<T, 2> const & a, std::array<T, 2> const & b,
+         std::array<T, 2> const & c, std::array<T, 2> const & d) noexcept
+{
+  constexpr T half_epsilon = std::numeric_limits<T>::epsilon() / 2;
+  constexpr T error_bound = (T{10} + T{96} * half_epsilon) * half_epsilon;
+  constexpr auto abs = [](T x) { return x < T{} ? -x : x; };
+
+  T const adx = a[0] - d[0], ady = a[1] - d[1];
+  T const bdx = b[0] - d[0], bdy = b[1] - d[1];
+  T const cdx = c[0] - d[0], cdy = c[1] - d[1];
+  T const alift = adx * adx + ady * ady;
+  T const blift = bdx * bdx + bdy * bdy;
+  T const clift = cdx * cdx + cdy * cdy;
+  T const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  T const cdxady = cdx * ady, adxcdy = adx * cdy;
+  T const adxbdy = adx * bdy, bdxady = bdx * ady;
+  T const det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+  T const permanent = (abs(bdxcdy) + abs(cdxbdy)) * alift
+                    + (abs(cdxady) + abs(adxcdy)) * blift
+                    + (abs(adxbdy) + abs(bdxady)) * clift;
+  if (det > error_bound * permanent) {
+    return 1;
+  }
+  if (-det > error_bound * permanent) {
+    return -1;
+  }
+
+  /* the lifted 4x4 determinant expanded along its column of ones,
+   * det(a, c, d) - det(b, c, d) - det(a, b, d) + det(a, b, c) with rows
+   * (x, y, x^2 + y^2), every lift split into its two squares */
+  std::array<T, 384> terms{};
+  std::size_t size = 0;
+  auto const add_det = [&](std::array<T, 2> const & p, std::array<T, 2> const & q,
+                           std::array<T, 2> const & r, T sign) {
+    auto const add = [&](T s, T x, T y, std::array<T, 2> const & lifted) {
+      for (std::size_t k = 0; k < 2; ++k) {
+        for (T const term : four_product(s * x, y, lifted[k], lifted[k])) {
+          terms[size++] = term;
+        }
+      }
+    };
+    add(sign, p[0], q[1], r);
+    add(-sign, p[0], r[1], q);
+    add(-sign, p[1], q[0], r);
+    add(sign, p[1], r[0], q);
+    add(sign, q[0], r[1], p);
+    add(-sign, q[1], r[0], p);
+  };
+  add_det(a, c, d, T{1});
+  add_det(b, c, d, T{-1});
+  add_det(a, b, d, T{-1});
+  add_det(a, b, c, T{1});
+  return exact_sign(terms);
+}
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef GEO_DETAIL_QUATERNION_HPP
+#define GEO_DETAIL_QUATERNION_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+
+#include "../math.hpp"
+#include "detail_transform.hpp"
+
+namespace geo::detail {
+
+/* above this cosine of the angle between two orientations slerp divides by
+ * a vanishing sine, and nlerp is as accurate */
+template <std::floating_point T>
+inline constexpr T slerp_threshold = T{0.9995};
+
+/* rotation matrix of the unit quaternion w + xi + yj + zk */
+template <std::floating_point T>
+[[nodiscard]] constexpr matrix<T, 3>
+rotation_matrix(T w, T x, T y, T z) noexcept
+{
+  T const xx = x * x, yy = y * y, zz = z * z;
+  T const xy = x * y, xz = x * z, yz = y * z;
+  T const wx = w * x, wy = w * y, wz = w * z;
+  return {{
+    {T{1} - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy)},
+    {2 * (xy + wz), T{1} - 2 * (xx + zz), 2 * (yz - wx)},
+    {2 * (xz - wy), 2 * (yz + wx), T{1} - 2 * (xx + yy)}
+  }};
+}
+
+/* m * p for three components, the kernel of every bulk rotation */
+template <std::floating_point T>
+[[nodiscard]] constexpr std::array<T, 3>
+rotate_coordinates(matrix<T, 3> const & m, T x, T y, T z) noexcept
+{
+  return {
+    m[0][0] * x + m[0][1] * y + m[0][2] * z,
+    m[1][0] * x + m[1][1] * y + m[1][2] * z,
+    m[2][0] * x + m[2][1] * y + m[2][2] * z
+  };
+}
+
+/* Rotates size points of SoA coordinates by m. Six pointers are too many
+ * for the runtime alias checks of the vectorizer, so the inputs go through
+ * a local tile first and m is a local copy; this also makes rotating in
+ * place safe. */
+template <std::floating_point T>
+constexpr void
+rotate_lanes(
+    matrix<T, 3> const m, std::array<T const *, 3> const & in,
+    std::array<T *, 3> const & out, std::size_t size) noexcept
+{
+  constexpr std::size_t tile = 256;
+  std::array<std::array<T, tile>, 3> p;
+  for (std::size_t first = 0; first < size; first += tile) {
+    std::size_t const count = std::min(tile, size - first);
+    for (std::size_t k = 0; k < 3; ++k) {
+      std::copy_n(in[k] + first, count, p[k].data());
+    }
+    T * const xs = out[0] + first;
+    T * const ys = out[1] + first;
+    T * const zs = out[2] + first;
+    for (std::size_t j = 0; j < count; ++j) {
+      auto const r = rotate_coordinates(m, p[0][j], p[1][j], p[2][j]);
+      xs[j] = r[0];
+      ys[j] = r[1];
+      zs[j] = r[2];
+    }
+  }
+}
+
+/* weights of the endpoints for slerp at t between unit quaternions with
+ * the given nonnegative cosine of their angle */
+template <std::floating_point T>
+[[nodiscard]] constexpr std::array<T, 2>
+slerp_weights(T cos, T t) noexcept
+{
+  if (cos > slerp_threshold<T>) {
+    return {T{1} - t, t};
+  }
+  T const angle = geo::acos(cos);
+  T const sin = geo::sin(angle);
+  return {geo::sin((T{1} - t) * angle) / sin, geo::sin(t * angle) / sin};
+}
+
+} // namespace geo::detail
+
+#endif
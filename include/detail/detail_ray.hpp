@@ -0,0 +1,289 @@
+#ifndef GEO_DETAIL_RAY_HPP
+#define GEO_DETAIL_RAY_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "../traits.hpp"
+
+namespace geo::detail {
+
+/* Component k of lane i of a packet lives at [k][i], so the loops over the
+ * lanes below run over contiguous values and vectorize. */
+template <typename T, std::size_t Dim, std::size_t N>
+using lanes_t = std::array<std::array<T, N>, Dim>;
+
+template <typename T>
+inline constexpr T no_hit = std::numeric_limits<T>::infinity();
+
+/* 1 / d; zero becomes the largest value, so that slab tests never compute
+ * 0 * inf */
+template <std::floating_point T>
+[[nodiscard]] T
+inverse_direction(T d) noexcept
+{
+  if (d != T{}) {
+    return T{1} / d;
+  }
+  return std::signbit(d) ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+}
+
+/* mask of the lanes below count */
+[[nodiscard]] constexpr std::uint32_t
+first_lanes(std::size_t count) noexcept
+{
+  return count >= 32 ? ~std::uint32_t{} : (std::uint32_t{1} << count) - 1;
+}
+
+/* stores coordinates c as lane i */
+template <typename T, std::size_t Dim, std::size_t N, typename Coordinates>
+void
+set_lane(lanes_t<T, Dim, N> & lanes, std::size_t i, Coordinates const & c) noexcept
+{
+  for (std::size_t k = 0; k < Dim; ++k) {
+    lanes[k][i] = static_cast<T>(c[k]);
+  }
+}
+
+/***************************** slab tests ********************************/
+
+/* Slab test of rays against boxes: lane i passes if ray i enters box i
+ * before best[i]. The accessors give component k of lane i; one of the two
+ * sides is usually the same for every lane. */
+template <typename T, std::size_t Dim, std::size_t N, typename Origin, typename Inverse, typename Lower, typename Upper>
+[[nodiscard]] std::uint32_t
+slab_mask(Origin origin, Inverse inverse, Lower lower, Upper upper, std::array<T, N> const & best) noexcept
+{
+  std::array<T, N> near{};
+  std::array<T, N> far = best;
+  for (std::size_t k = 0; k < Dim; ++k) {
+    for (std::size_t i = 0; i < N; ++i) {
+      T const a = (lower(k, i) - origin(k, i)) * inverse(k, i);
+      T const b = (upper(k, i) - origin(k, i)) * inverse(k, i);
+      near[i] = std::max(near[i], std::min(a, b));
+      far[i] = std::min(far[i], std::max(a, b));
+    }
+  }
+  std::uint32_t mask = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    mask |= static_cast<std::uint32_t>(near[i] <= far[i]) << i;
+  }
+  return mask;
+}
+
+/***************************** kernels ********************************/
+
+/* First parameter t >= 0 at which ray i meets the sphere or circle i, inf
+ * for none. From inside, that is where the ray leaves. */
+template <typename T, std::size_t Dim, std::size_t N, typename Origin, typename Direction, typename Center, typename Radius>
+[[nodiscard]] std::array<T, N>
+circle_hits(Origin origin, Direction direction, Center center, Radius radius) noexcept
+{
+  std::array<T, N> retval{};
+  for (std::size_t i = 0; i < N; ++i) {
+    T a{}, b{}, c{};
+    for (std::size_t k = 0; k < Dim; ++k) {
+      T const offset = origin(k, i) - center(k, i);
+      T const d = direction(k, i);
+      a += d * d;
+      b += offset * d;
+      c += offset * offset;
+    }
+    c -= radius(i) * radius(i);
+    T const discriminant = b * b - a * c;
+    T const root = std::sqrt(std::max(discriminant, T{}));
+    T const entry = (-b - root) / a;
+    T const exit = (-b + root) / a;
+    T const t = entry >= T{} ? entry : exit;
+    retval[i] = (discriminant >= T{}) & (t >= T{}) ? t : no_hit<T>;
+  }
+  return retval;
+}
+
+/* First parameter t >= 0 at which ray i crosses segment i in 2D, inf for
+ * none; parallel rays miss, collinear ones included. */
+template <typename T, std::size_t N, typename Origin, typename Direction, typename Start, typename End>
+[[nodiscard]] std::array<T, N>
+segment_hits(Origin origin, Direction direction, Start start, End end) noexcept
+{
+  std::array<T, N> retval{};
+  for (std::size_t i = 0; i < N; ++i) {
+    T const dx = direction(0, i), dy = direction(1, i);
+    T const ex = end(0, i) - start(0, i), ey = end(1, i) - start(1, i);
+    T const wx = start(0, i) - origin(0, i), wy = start(1, i) - origin(1, i);
+    T const denominator = dx * ey - dy * ex;
+    T const t = (wx * ey - wy * ex) / denominator;
+    T const s = (wx * dy - wy * dx) / denominator;
+    retval[i] = (denominator != T{}) & (t >= T{}) & (s >= T{}) & (s <= T{1}) ? t : no_hit<T>;
+  }
+  return retval;
+}
+
+/***************************** Bezier subdivision ********************************/
+
+/* Bezier hits subdivide a curve at 1/2 while the box of a part's control
+ * points meets a ray, and intersect the chord of a part once its control
+ * points lie within bezier_flatness times the extent of the curve of it, or
+ * after bezier_max_depth halvings. Hits are off by about that tolerance. */
+inline constexpr double bezier_flatness = 0x1p-20;
+inline constexpr std::size_t bezier_max_depth = 24;
+
+/* control points of the 2D curves of C lanes, component k of control point
+ * j of lane i at [j][k][i] */
+template <std::size_t Degree, typename T, std::size_t C>
+using bezier_lanes_t = std::array<lanes_t<T, 2, C>, Degree + 1>;
+
+/* de Casteljau at 1/2 in place in right, which ends up holding the right
+ * halves; the left halves stay in ctrls */
+template <std::size_t Degree, typename T, std::size_t C>
+void
+split_lanes(bezier_lanes_t<Degree, T, C> & ctrls, bezier_lanes_t<Degree, T, C> & right) noexcept
+{
+  right = ctrls;
+  for (std::size_t level = 1; level <= Degree; ++level) {
+    for (std::size_t j = 0; j + level <= Degree; ++j) {
+      for (std::size_t k = 0; k < 2; ++k) {
+        for (std::size_t i = 0; i < C; ++i) {
+          right[j][k][i] = (right[j][k][i] + right[j + 1][k][i]) / 2;
+        }
+      }
+    }
+    ctrls[level] = right[0];
+  }
+}
+
+template <std::size_t Degree, typename T, std::size_t C>
+void
+bounds_lanes(bezier_lanes_t<Degree, T, C> const & ctrls, lanes_t<T, 2, C> & lower, lanes_t<T, 2, C> & upper) noexcept
+{
+  lower = upper = ctrls[0];
+  for (std::size_t j = 1; j <= Degree; ++j) {
+    for (std::size_t k = 0; k < 2; ++k) {
+      for (std::size_t i = 0; i < C; ++i) {
+        lower[k][i] = std::min(lower[k][i], ctrls[j][k][i]);
+        upper[k][i] = std::max(upper[k][i], ctrls[j][k][i]);
+      }
+    }
+  }
+}
+
+/* Lanes whose control points lie within the tolerance of those of the
+ * chord as a curve of the same degree, P0 + j / Degree * (Pn - P0); then
+ * the whole part lies within the tolerance of the chord. */
+template <std::size_t Degree, typename T, std::size_t C>
+[[nodiscard]] std::uint32_t
+flat_lanes(bezier_lanes_t<Degree, T, C> const & ctrls, std::array<T, C> const & squared_tolerance) noexcept
+{
+  std::array<T, C> worst{};
+  for (std::size_t j = 1; j < Degree; ++j) {
+    T const s = static_cast<T>(j) / static_cast<T>(Degree);
+    for (std::size_t i = 0; i < C; ++i) {
+      T const dx = ctrls[j][0][i] - (ctrls[0][0][i] + s * (ctrls[Degree][0][i] - ctrls[0][0][i]));
+      T const dy = ctrls[j][1][i] - (ctrls[0][1][i] + s * (ctrls[Degree][1][i] - ctrls[0][1][i]));
+      worst[i] = std::max(worst[i], dx * dx + dy * dy);
+    }
+  }
+  std::uint32_t mask = 0;
+  for (std::size_t i = 0; i < C; ++i) {
+    mask |= static_cast<std::uint32_t>(worst[i] <= squared_tolerance[i]) << i;
+  }
+  return mask;
+}
+
+/* First parameter t >= 0 at which ray i meets a 2D Bezier, inf for none.
+ * The parts of the curve are shared: a part is split once for all rays
+ * whose slab test against it passes. Only the rays in active are cast. */
+template <std::size_t Degree, typename T, std::size_t N, typename Origin, typename Direction, typename Inverse>
+[[nodiscard]] std::array<T, N>
+bezier_hits(Origin origin, Direction direction, Inverse inverse,
+            bezier_lanes_t<Degree, T, 1> const & curve, std::uint32_t active) noexcept
+{
+  struct part
+  {
+    bezier_lanes_t<Degree, T, 1> ctrls;
+    std::size_t depth;
+    std::uint32_t mask;
+  };
+
+  std::array<T, N> best;
+  best.fill(no_hit<T>);
+  lanes_t<T, 2, 1> lower, upper;
+  bounds_lanes<Degree>(curve, lower, upper);
+  T const extent = std::max(upper[0][0] - lower[0][0], upper[1][0] - lower[1][0]) * static_cast<T>(bezier_flatness);
+  std::array<T, 1> const squared_tolerance{extent * extent};
+
+  /* depth first, a pending right half per level at most */
+  std::array<part, bezier_max_depth + 1> stack;
+  std::size_t size = 0;
+  stack[size++] = {curve, 0, active};
+  while (size > 0) {
+    part current = stack[--size];
+    bounds_lanes<Degree>(current.ctrls, lower, upper);
+    std::uint32_t const mask = current.mask & slab_mask<T, 2, N>(
+      origin, inverse,
+      [&](std::size_t k, std::size_t) { return lower[k][0]; },
+      [&](std::size_t k, std::size_t) { return upper[k][0]; }, best);
+    if (mask == 0) {
+      continue;
+    }
+
+    if (current.depth == bezier_max_depth || flat_lanes<Degree>(current.ctrls, squared_tolerance) != 0) {
+      auto const t = segment_hits<T, N>(
+        origin, direction,
+        [&](std::size_t k, std::size_t) { return current.ctrls[0][k][0]; },
+        [&](std::size_t k, std::size_t) { return current.ctrls[Degree][k][0]; });
+      for (std::size_t i = 0; i < N; ++i) {
+        best[i] = (mask >> i & 1) != 0 ? std::min(best[i], t[i]) : best[i];
+      }
+      continue;
+    }
+
+    part & right = stack[size++];
+    split_lanes<Degree>(current.ctrls, right.ctrls);
+    right.depth = current.depth + 1;
+    right.mask = mask;
+    stack[size++] = {current.ctrls, current.depth + 1, mask};
+  }
+  return best;
+}
+
+/* First parameter t >= 0 at which ray i meets the 2D Bezier i, inf for
+ * none. The boxes of the control points of all lanes are tested at once and
+ * the curves that pass are subdivided one by one: the parts of different
+ * curves that a ray reaches diverge after a split or two, so lanes that
+ * subdivide in lockstep mostly idle. */
+template <std::size_t Degree, typename T, std::size_t N, typename Origin, typename Direction, typename Inverse>
+[[nodiscard]] std::array<T, N>
+bezier_lane_hits(Origin origin, Direction direction, Inverse inverse,
+                 bezier_lanes_t<Degree, T, N> const & curves, std::uint32_t active) noexcept
+{
+  std::array<T, N> retval;
+  retval.fill(no_hit<T>);
+  lanes_t<T, 2, N> lower, upper;
+  bounds_lanes<Degree>(curves, lower, upper);
+  std::uint32_t const mask = active & slab_mask<T, 2, N>(
+    origin, inverse,
+    [&](std::size_t k, std::size_t i) { return lower[k][i]; },
+    [&](std::size_t k, std::size_t i) { return upper[k][i]; }, retval);
+  for (std::uint32_t lanes = mask; lanes != 0; lanes &= lanes - 1) {
+    auto const i = static_cast<std::size_t>(std::countr_zero(lanes));
+    bezier_lanes_t<Degree, T, 1> curve;
+    for (std::size_t j = 0; j <= Degree; ++j) {
+      curve[j] = {{{curves[j][0][i]}, {curves[j][1][i]}}};
+    }
+    retval[i] = bezier_hits<Degree, T, 1>(
+      [&](std::size_t k, std::size_t) { return origin(k, i); },
+      [&](std::size_t k, std::size_t) { return direction(k, i); },
+      [&](std::size_t k, std::size_t) { return inverse(k, i); }, curve, 1)[0];
+  }
+  return retval;
+}
+
+} // namespace geo::detail
+
+#endif
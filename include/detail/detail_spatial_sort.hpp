@@ -0,0 +1,405 @@
+#ifndef GEO_DETAIL_SPATIAL_SORT_HPP
+#define GEO_DETAIL_SPATIAL_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../point.hpp"
+#include "../traits.hpp"
+#include "detail_bezier.hpp"
+#include "detail_execution.hpp"
+
+/* BMI2 deposits the bits of a coordinate in one instruction. GCC and Clang
+ * announce it with -mbmi2 or -march, MSVC only has the AVX2 switch, every
+ * CPU with AVX2 has BMI2. */
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define GEO_HAS_BMI2
+#endif
+
+namespace geo::detail {
+
+/***************************** bit interleaving ********************************/
+
+inline constexpr std::uint64_t morton_mask_2d = 0x5555555555555555;
+inline constexpr std::uint64_t morton_mask_3d = 0x1249249249249249;
+
+/* the 32 bits of v moved to the even bits */
+[[nodiscard]] constexpr std::uint64_t
+spread_bits_2d(std::uint32_t v) noexcept
+{
+  std::uint64_t x = v;
+  x = (x | x << 16) & 0x0000FFFF0000FFFF;
+  x = (x | x << 8) & 0x00FF00FF00FF00FF;
+  x = (x | x << 4) & 0x0F0F0F0F0F0F0F0F;
+  x = (x | x << 2) & 0x3333333333333333;
+  x = (x | x << 1) & morton_mask_2d;
+  return x;
+}
+
+/* the low 21 bits of v moved to every third bit */
+[[nodiscard]] constexpr std::uint64_t
+spread_bits_3d(std::uint32_t v) noexcept
+{
+  std::uint64_t x = v & 0x1FFFFF;
+  x = (x | x << 32) & 0x001F00000000FFFF;
+  x = (x | x << 16) & 0x001F0000FF0000FF;
+  x = (x | x << 8) & 0x100F00F00F00F00F;
+  x = (x | x << 4) & 0x10C30C30C30C30C3;
+  x = (x | x << 2) & morton_mask_3d;
+  return x;
+}
+
+template <std::size_t Dim>
+[[nodiscard]] constexpr std::uint64_t
+spread_bits(std::uint32_t v) noexcept
+{
+#ifdef GEO_HAS_BMI2
+  if (!std::is_constant_evaluated()) {
+    return _pdep_u64(v, Dim == 2 ? morton_mask_2d : morton_mask_3d);
+  }
+#endif
+  if constexpr (Dim == 2) {
+    return spread_bits_2d(v);
+  } else {
+    return spread_bits_3d(v);
+  }
+}
+
+/* bit b of axis i lands on bit Dim * b + i */
+template <std::size_t Dim>
+[[nodiscard]] constexpr std::uint64_t
+interleave(std::array<std::uint32_t, Dim> const & axes) noexcept
+{
+  std::uint64_t retval = 0;
+  for (std::size_t i = 0; i < Dim; ++i) {
+    retval |= spread_bits<Dim>(axes[i]) << i;
+  }
+  return retval;
+}
+
+/* bits per axis of a 64-bit key */
+template <std::size_t Dim>
+inline constexpr unsigned key_bits = Dim == 2 ? 32 : 21;
+
+/* 2D Hilbert index without a loop over the levels: the orientation state
+ * of every level is a prefix scan over the higher ones, computed for all 32
+ * levels at once in log2(32) rounds of shifted bit operations (after
+ * rawrunprotected's hilbert_curves, public domain). */
+[[nodiscard]] constexpr std::uint64_t
+hilbert_key_2d(std::uint32_t x32, std::uint32_t y32) noexcept
+{
+  constexpr std::uint64_t ones = 0xFFFFFFFF;
+  std::uint64_t const x = x32;
+  std::uint64_t const y = y32;
+
+  std::uint64_t a = x ^ y;
+  std::uint64_t b = ones ^ a;
+  std::uint64_t c = ones ^ (x | y);
+  std::uint64_t d = x & (y ^ ones);
+  std::uint64_t A = a | (b >> 1);
+  std::uint64_t B = (a >> 1) ^ a;
+  std::uint64_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+  std::uint64_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+  for (unsigned shift = 2; shift < 16; shift *= 2) {
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = (a & (a >> shift)) ^ (b & (b >> shift));
+    B = (a & (b >> shift)) ^ (b & ((a ^ b) >> shift));
+    C ^= (a & (c >> shift)) ^ (b & (d >> shift));
+    D ^= (b & (c >> shift)) ^ ((a ^ b) & (d >> shift));
+  }
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  C ^= (a & (c >> 16)) ^ (b & (d >> 16));
+  D ^= (b & (c >> 16)) ^ ((a ^ b) & (d >> 16));
+
+  a = C ^ (C >> 1);
+  b = D ^ (D >> 1);
+  auto const i0 = static_cast<std::uint32_t>(x ^ y);
+  auto const i1 = static_cast<std::uint32_t>(b | (ones ^ (i0 | a)));
+  return spread_bits<2>(i1) << 1 | spread_bits<2>(i0);
+}
+
+/* 3D Hilbert index by Skilling's transform ("Programming the Hilbert
+ * curve", 2004), which turns the coordinates into the transposed index:
+ * its bits read most significant first across the axes, axis 0 leading,
+ * are the index. Written with masks instead of branches on the coordinate
+ * bits, which are unpredictable. */
+[[nodiscard]] constexpr std::uint64_t
+hilbert_key_3d(std::array<std::uint32_t, 3> x) noexcept
+{
+  constexpr std::uint32_t top = std::uint32_t{1} << (key_bits<3> - 1);
+
+  for (std::uint32_t q = top; q > 1; q >>= 1) {
+    std::uint32_t const p = q - 1;
+    for (auto & axis : x) {
+      std::uint32_t const set = 0u - ((axis & q) != 0 ? 1u : 0u);
+      std::uint32_t const t = (x[0] ^ axis) & p & ~set;
+      x[0] ^= (p & set) ^ t;
+      axis ^= t;
+    }
+  }
+
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  std::uint32_t t = 0;
+  for (std::uint32_t q = top; q > 1; q >>= 1) {
+    t ^= (q - 1) & (0u - ((x[2] & q) != 0 ? 1u : 0u));
+  }
+  for (auto & axis : x) {
+    axis ^= t;
+  }
+
+  return interleave<3>({x[2], x[1], x[0]});
+}
+
+template <std::size_t Dim>
+[[nodiscard]] constexpr std::uint64_t
+hilbert_key(std::array<std::uint32_t, Dim> const & cell) noexcept
+{
+  if constexpr (Dim == 2) {
+    return hilbert_key_2d(cell[0], cell[1]);
+  } else {
+    return hilbert_key_3d(cell);
+  }
+}
+
+/***************************** keys ********************************/
+
+/* center of the bounding box of an object, the position it is sorted by */
+template <concepts::point Point>
+[[nodiscard]] constexpr auto
+sort_position(Point const & point) noexcept
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::array<traits::value_type_t<Point>, sizeof...(Is)>{get<Is>(point)...};
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+}
+
+/* the inverse of sort_position for points */
+template <concepts::point Point, typename Coordinates>
+[[nodiscard]] constexpr Point
+to_point(Coordinates const & c) noexcept
+{
+  Point retval{};
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    (set<Is>(retval, static_cast<traits::value_type_t<Point>>(c[Is])), ...);
+  }(std::make_index_sequence<traits::dimension_v<Point>>{});
+  return retval;
+}
+
+template <concepts::circle Circle>
+[[nodiscard]] constexpr auto
+sort_position(Circle const & circle) noexcept
+{
+  return sort_position(traits::access_center<Circle>::get(circle));
+}
+
+template <concepts::line Line>
+[[nodiscard]] constexpr auto
+sort_position(Line const & line) noexcept
+{
+  auto retval = sort_position(line.start);
+  auto const end = sort_position(line.end);
+  for (std::size_t i = 0; i < retval.size(); ++i) {
+    retval[i] = (retval[i] + end[i]) / 2;
+  }
+  return retval;
+}
+
+template <concepts::bezier Bezier>
+[[nodiscard]] constexpr auto
+sort_position(Bezier const & bezier) noexcept
+{
+  auto const ctrls = copy_ctrls(bezier);
+  auto lower = sort_position(ctrls[0]);
+  auto upper = lower;
+  for (auto const & ctrl : ctrls) {
+    auto const p = sort_position(ctrl);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+      lower[i] = std::min(lower[i], p[i]);
+      upper[i] = std::max(upper[i], p[i]);
+    }
+  }
+  for (std::size_t i = 0; i < lower.size(); ++i) {
+    lower[i] = (lower[i] + upper[i]) / 2;
+  }
+  return lower;
+}
+
+template <typename Object>
+using sort_position_t = decltype(sort_position(std::declval<Object const &>()));
+
+struct keyed_index
+{
+  std::uint64_t key;
+  std::size_t index;
+};
+
+/* runs f(block) for blocks [0, blocks), concurrently if Parallel */
+template <bool Parallel, typename F>
+void
+for_each_block(std::size_t blocks, F && f)
+{
+  if constexpr (Parallel) {
+    parallel_for(blocks, [&](std::size_t first, std::size_t last) {
+      for (std::size_t b = first; b < last; ++b) {
+        f(b);
+      }
+    });
+  } else {
+    for (std::size_t b = 0; b < blocks; ++b) {
+      f(b);
+    }
+  }
+}
+
+/* Stable LSD radix sort by key, 11 bits a pass, the most whose counts stay
+ * in L1. Digits that are the same in all keys are skipped, so short keys take
+ * few passes. The
+ * parallel version gives each thread a fixed block: it counts the digits of
+ * its block, the counts of all blocks are turned into offsets in block order
+ * and each block scatters its items to its own offsets. */
+template <bool Parallel>
+void
+radix_sort(std::vector<keyed_index> & items)
+{
+  constexpr unsigned radix_bits = 11;
+  constexpr std::size_t radix = std::size_t{1} << radix_bits;
+  constexpr std::uint64_t digit_mask = radix - 1;
+
+  if (items.size() < 2) {
+    return;
+  }
+
+  std::size_t const blocks = Parallel ? std::clamp<std::size_t>(items.size() / 32768, 1, worker_count()) : 1;
+  auto const block_begin = [&](std::size_t b) { return items.size() * b / blocks; };
+
+  std::uint64_t varying = 0;
+  for (auto const & item : items) {
+    varying |= item.key ^ items[0].key;
+  }
+
+  std::vector<keyed_index> buffer(items.size());
+  std::vector<std::array<std::size_t, radix>> offsets(blocks);
+  for (unsigned shift = 0; shift < 64; shift += radix_bits) {
+    if (((varying >> shift) & digit_mask) == 0) {
+      continue;
+    }
+
+    for_each_block<Parallel>(blocks, [&](std::size_t b) {
+      auto & count = offsets[b];
+      count.fill(0);
+      for (std::size_t i = block_begin(b), end = block_begin(b + 1); i < end; ++i) {
+        ++count[(items[i].key >> shift) & digit_mask];
+      }
+    });
+
+    std::size_t sum = 0;
+    for (std::size_t digit = 0; digit < radix; ++digit) {
+      for (auto & block : offsets) {
+        std::size_t const count = block[digit];
+        block[digit] = sum;
+        sum += count;
+      }
+    }
+
+    for_each_block<Parallel>(blocks, [&](std::size_t b) {
+      auto & offset = offsets[b];
+      for (std::size_t i = block_begin(b), end = block_begin(b + 1); i < end; ++i) {
+        buffer[offset[(items[i].key >> shift) & digit_mask]++] = items[i];
+      }
+    });
+    items.swap(buffer);
+  }
+}
+
+/* indices of the objects sorted along the Hilbert or Morton curve over the
+ * bounds of their positions */
+template <bool Parallel, bool Hilbert, typename Range>
+[[nodiscard]] std::vector<std::size_t>
+spatial_order(Range const & objects)
+{
+  using Object = std::ranges::range_value_t<Range>;
+  using Position = sort_position_t<Object>;
+  constexpr std::size_t dim = std::tuple_size_v<Position>;
+
+  std::size_t const count = std::ranges::size(objects);
+  auto const first = std::ranges::begin(objects);
+  auto const at = [&](std::size_t i) {
+    return sort_position(first[static_cast<std::ranges::range_difference_t<Range>>(i)]);
+  };
+
+  std::vector<keyed_index> items(count);
+  if (count != 0) {
+    Position lower = at(0);
+    Position upper = lower;
+    for (std::size_t i = 1; i < count; ++i) {
+      auto const p = at(i);
+      for (std::size_t k = 0; k < dim; ++k) {
+        lower[k] = std::min(lower[k], p[k]);
+        upper[k] = std::max(upper[k], p[k]);
+      }
+    }
+
+    /* in double, which holds the largest cell index exactly; halves, so
+     * that the extent of finite bounds cannot overflow */
+    constexpr auto levels = static_cast<double>((std::uint64_t{1} << key_bits<dim>) - 1);
+    std::array<double, dim> scale{};
+    for (std::size_t k = 0; k < dim; ++k) {
+      auto const half_extent = static_cast<double>(upper[k]) / 2 - static_cast<double>(lower[k]) / 2;
+      scale[k] = half_extent > 0 ? levels / half_extent : 0.0;
+    }
+
+    /* Both curves nest, the leading bits of an index are the index of the
+     * enclosing cell of a coarser grid. Keys are cut to a grid of about 16^dim
+     * cells per object, finer cells would hardly change the order but cost
+     * radix passes. */
+    constexpr auto key_length = static_cast<unsigned>(dim) * key_bits<dim>;
+    unsigned const dropped = key_length - std::min(key_length, static_cast<unsigned>(std::bit_width(count) + 4 * dim));
+
+    auto const quantize = [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        auto const p = at(i);
+        std::array<std::uint32_t, dim> cell{};
+        for (std::size_t k = 0; k < dim; ++k) {
+          auto const half_offset = static_cast<double>(p[k]) / 2 - static_cast<double>(lower[k]) / 2;
+          /* infinite and NaN coordinates give NaN, which goes to cell 0 */
+          double const position = half_offset * scale[k];
+          cell[k] = position > 0.0 ? static_cast<std::uint32_t>(std::min(position, levels)) : 0;
+        }
+        items[i] = {(Hilbert ? hilbert_key<dim>(cell) : interleave<dim>(cell)) >> dropped, i};
+      }
+    };
+    if constexpr (Parallel) {
+      parallel_for(count, quantize);
+    } else {
+      quantize(0, count);
+    }
+  }
+
+  radix_sort<Parallel>(items);
+
+  std::vector<std::size_t> retval(count);
+  std::ranges::transform(items, retval.begin(), [](keyed_index const & item) { return item.index; });
+  return retval;
+}
+
+} // namespace geo::detail
+
+#endif
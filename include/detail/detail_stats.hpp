@@ -0,0 +1,199 @@
+#ifndef GEO_DETAIL_STATS_HPP
+#define GEO_DETAIL_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#ifdef GEO_ENABLE_STATS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace geo {
+
+namespace stats {
+
+/* instrumented entry points */
+enum class operation : std::size_t
+{
+  dot_product,
+  norm,
+  normalize,
+  distance,
+  vector_product,
+  angle,
+  area,
+  evaluate_at,
+  sample,
+  sqrt,
+};
+
+inline constexpr std::size_t operation_count = 10;
+
+inline constexpr std::array<std::string_view, operation_count> operation_names{
+  "dot_product", "norm", "normalize", "distance", "vector_product",
+  "angle", "area", "evaluate_at", "sample", "sqrt"
+};
+
+} // namespace stats
+
+namespace detail {
+
+#ifdef GEO_ENABLE_STATS
+
+/* Counters of one thread. Only the owning thread writes them, so a relaxed
+ * load and store is enough and no read-modify-write is needed; other threads
+ * only read them for a snapshot. */
+struct stats_block
+{
+  std::array<std::atomic<std::uint64_t>, stats::operation_count> calls{};
+  std::array<std::atomic<std::uint64_t>, stats::operation_count> nanoseconds{};
+};
+
+/* Blocks of live threads; the counts of exited threads are folded into
+ * retired. The mutex is taken on thread start and exit, snapshot and reset,
+ * never when counting. */
+struct stats_registry
+{
+  std::mutex mutex;
+  std::vector<stats_block *> blocks;
+  std::array<std::uint64_t, stats::operation_count> retired_calls{};
+  std::array<std::uint64_t, stats::operation_count> retired_nanoseconds{};
+
+  [[nodiscard]] static stats_registry &
+  instance()
+  {
+    static stats_registry registry;
+    return registry;
+  }
+};
+
+/* Block of the calling thread. The hooks sit in noexcept functions, so
+ * registering must not throw: if the registry cannot take the block, the
+ * thread still counts, but its counts never reach a snapshot. */
+class thread_stats
+{
+public:
+  thread_stats() noexcept
+  {
+    auto & registry = stats_registry::instance();
+    try {
+      std::lock_guard const lock(registry.mutex);
+      registry.blocks.push_back(&block_);
+      registered_ = true;
+    } catch (...) {
+    }
+  }
+
+  thread_stats(thread_stats const &) = delete;
+  thread_stats & operator=(thread_stats const &) = delete;
+
+  ~thread_stats()
+  {
+    if (!registered_) {
+      return;
+    }
+    auto & registry = stats_registry::instance();
+    std::lock_guard const lock(registry.mutex);
+    for (std::size_t i = 0; i < stats::operation_count; ++i) {
+      registry.retired_calls[i] += block_.calls[i].load(std::memory_order_relaxed);
+      registry.retired_nanoseconds[i] += block_.nanoseconds[i].load(std::memory_order_relaxed);
+    }
+    std::erase(registry.blocks, &block_);
+  }
+
+  [[nodiscard]] stats_block &
+  block() noexcept
+  {
+    return block_;
+  }
+
+private:
+  stats_block block_;
+  bool registered_ = false;
+};
+
+[[nodiscard]] inline stats_block &
+local_stats() noexcept
+{
+  thread_local thread_stats stats;
+  return stats.block();
+}
+
+inline void
+stats_add(std::atomic<std::uint64_t> & counter, std::uint64_t value) noexcept
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void
+count_call(stats::operation op) noexcept
+{
+  stats_add(local_stats().calls[static_cast<std::size_t>(op)], 1);
+}
+
+/* Adds the lifetime of the scope to the time of op. Literal, so it may live
+ * in constexpr functions; it does nothing during constant evaluation. */
+class stats_timer
+{
+public:
+  explicit constexpr stats_timer(stats::operation op) noexcept
+    : op_(op)
+  {
+    if (!std::is_constant_evaluated()) {
+      start_ = now();
+    }
+  }
+
+  stats_timer(stats_timer const &) = delete;
+  stats_timer & operator=(stats_timer const &) = delete;
+
+  constexpr ~stats_timer()
+  {
+    if (!std::is_constant_evaluated()) {
+      stats_add(local_stats().nanoseconds[static_cast<std::size_t>(op_)], now() - start_);
+    }
+  }
+
+private:
+  [[nodiscard]] static std::uint64_t
+  now() noexcept
+  {
+    auto const since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+  }
+
+  stats::operation op_;
+  std::uint64_t start_ = 0;
+};
+
+#endif
+
+} // namespace detail
+
+} // namespace geo
+
+/* GEO_STATS_SCOPE(op) at the top of an entry point counts the call and, with
+ * GEO_ENABLE_STATS_TIMERS, times it. Without GEO_ENABLE_STATS it expands to
+ * nothing, constant evaluation skips it either way. */
+#ifdef GEO_ENABLE_STATS
+#define GEO_STATS_COUNT(op) \
+  (std::is_constant_evaluated() ? void() : ::geo::detail::count_call(::geo::stats::operation::op))
+#ifdef GEO_ENABLE_STATS_TIMERS
+#define GEO_STATS_SCOPE(op) \
+  GEO_STATS_COUNT(op); \
+  ::geo::detail::stats_timer const geo_stats_timer_##op{::geo::stats::operation::op}
+#else
+#define GEO_STATS_SCOPE(op) GEO_STATS_COUNT(op)
+#endif
+#else
+#define GEO_STATS_SCOPE(op) static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef GEO_DETAIL_SWEEP_AND_PRUNE_HPP
+#define GEO_DETAIL_SWEEP_AND_PRUNE_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../box.hpp"
+#include "../traits.hpp"
+#include "detail_bvh.hpp"
+#include "detail_execution.hpp"
+
+namespace geo::detail {
+
+/* Objects of a sweep and prune under stable handles, with their bounds as
+ * one array per axis and side indexed by handle. Handles of removed objects
+ * are only reused after the next update, so events never confuse an object
+ * with an earlier one of the same handle. */
+template <typename Object>
+class sap_objects
+{
+public:
+  using box_type = bounding_box_t<Object>;
+  using point_type = traits::point_type_t<box_type>;
+  using value_type = traits::value_type_t<box_type>;
+
+  static constexpr std::size_t dimension = traits::dimension_v<point_type>;
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] std::size_t
+  capacity() const noexcept
+  {
+    return objects_.size();
+  }
+
+  [[nodiscard]] bool
+  contains(std::size_t h) const noexcept
+  {
+    return h < alive_.size() && alive_[h] != 0;
+  }
+
+  [[nodiscard]] Object const &
+  operator[](std::size_t h) const noexcept
+  {
+    return objects_[h];
+  }
+
+  [[nodiscard]] Object &
+  operator[](std::size_t h) noexcept
+  {
+    return objects_[h];
+  }
+
+  std::size_t
+  insert(Object object)
+  {
+    std::size_t h = 0;
+    if (free_.empty()) {
+      h = objects_.size();
+      objects_.push_back(std::move(object));
+      alive_.push_back(1);
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        lower_[axis].push_back({});
+        upper_[axis].push_back({});
+      }
+    } else {
+      h = free_.back();
+      free_.pop_back();
+      objects_[h] = std::move(object);
+      alive_[h] = 1;
+    }
+    refresh(h);
+    ++size_;
+    return h;
+  }
+
+  void
+  remove(std::size_t h)
+  {
+    if (!contains(h)) {
+      throw std::invalid_argument("invalid handle");
+    }
+    alive_[h] = 0;
+    retired_.push_back(h);
+    --size_;
+  }
+
+  [[nodiscard]] bool
+  retired_any() const noexcept
+  {
+    return !retired_.empty();
+  }
+
+  /* makes the handles removed since the last update available again */
+  void
+  recycle()
+  {
+    free_.insert(free_.end(), retired_.begin(), retired_.end());
+    retired_.clear();
+  }
+
+  void
+  refresh(std::size_t h) noexcept
+  {
+    auto const box = geo::bounding_box(objects_[h]);
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((lower_[Is][h] = get<Is>(box.lower), upper_[Is][h] = get<Is>(box.upper)), ...);
+    }(std::make_index_sequence<dimension>{});
+  }
+
+  /* recomputes the bounds of all live objects */
+  template <bool Parallel>
+  void
+  refresh_all()
+  {
+    auto const work = [&](std::size_t first, std::size_t last) {
+      for (std::size_t h = first; h < last; ++h) {
+        if (alive_[h] != 0) {
+          refresh(h);
+        }
+      }
+    };
+    if constexpr (Parallel) {
+      parallel_for(objects_.size(), work);
+    } else {
+      work(0, objects_.size());
+    }
+  }
+
+  [[nodiscard]] std::vector<value_type> const &
+  lower(std::size_t axis) const noexcept
+  {
+    return lower_[axis];
+  }
+
+  [[nodiscard]] std::vector<value_type> const &
+  upper(std::size_t axis) const noexcept
+  {
+    return upper_[axis];
+  }
+
+  [[nodiscard]] bool
+  overlap(std::size_t a, std::size_t b) const noexcept
+  {
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      if (upper_[axis][a] < lower_[axis][b] || upper_[axis][b] < lower_[axis][a]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::vector<Object> objects_{};
+  std::vector<unsigned char> alive_{};
+  std::array<std::vector<value_type>, dimension> lower_{};
+  std::array<std::vector<value_type>, dimension> upper_{};
+  std::vector<std::size_t> free_{};
+  std::vector<std::size_t> retired_{};
+  std::size_t size_ = 0;
+};
+
+/* unordered pair of handles, first < second */
+struct sap_pair
+{
+  std::size_t first;
+  std::size_t second;
+
+  [[nodiscard]] static constexpr sap_pair
+  of(std::size_t a, std::size_t b) noexcept
+  {
+    return a < b ? sap_pair{a, b} : sap_pair{b, a};
+  }
+
+  [[nodiscard]] friend constexpr bool
+  operator==(sap_pair const &, sap_pair const &) noexcept = default;
+};
+
+struct sap_pair_hash
+{
+  [[nodiscard]] std::size_t
+  operator()(sap_pair const & pair) const noexcept
+  {
+    return std::hash<std::size_t>{}(pair.first * 0x9E3779B97F4A7C15u ^ pair.second);
+  }
+};
+
+/* Stable insertion sort, cheap when the order changed little since the last
+ * call. Calls passed(moving, passed) for every element that moves left past
+ * another. */
+template <typename T, typename Less, typename Passed>
+void
+insertion_sort(std::vector<T> & items, Less less, Passed passed)
+{
+  for (std::size_t i = 1; i < items.size(); ++i) {
+    if (!less(items[i], items[i - 1])) {
+      continue;
+    }
+    T const moving = items[i];
+    std::size_t j = i;
+    for (; j > 0 && less(moving, items[j - 1]); --j) {
+      passed(moving, items[j - 1]);
+      items[j] = items[j - 1];
+    }
+    items[j] = moving;
+  }
+}
+
+} // namespace geo::detail
+
+#endif
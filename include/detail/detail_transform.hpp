@@ -0,0 +1,66 @@
+#ifndef GEO_DETAIL_TRANSFORM_HPP
+#define GEO_DETAIL_TRANSFORM_HPP
+
+#include <array>
+#include <concepts>
+#include <utility>
+
+namespace geo::detail {
+
+template <std::floating_point T, std::size_t N>
+using matrix = std::array<std::array<T, N>, N>;
+
+template <std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr matrix<T, N>
+identity_matrix() noexcept
+{
+  matrix<T, N> retval{};
+  for (std::size_t i = 0; i < N; ++i) {
+    retval[i][i] = T{1};
+  }
+  return retval;
+}
+
+template <std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr matrix<T, N>
+multiply(matrix<T, N> const & lhs, matrix<T, N> const & rhs) noexcept
+{
+  matrix<T, N> retval{};
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t k = 0; k < N; ++k) {
+      for (std::size_t j = 0; j < N; ++j) {
+        retval[i][j] += lhs[i][k] * rhs[k][j];
+      }
+    }
+  }
+  return retval;
+}
+
+/* determinant of the upper left Dim x Dim block */
+template <std::size_t Dim, std::floating_point T, std::size_t N>
+requires (Dim == 2 || Dim == 3) && (Dim <= N)
+[[nodiscard]] constexpr T
+linear_determinant(matrix<T, N> const & m) noexcept
+{
+  if constexpr (Dim == 2) {
+    return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+  } else {
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+         - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+         + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  }
+}
+
+/* homogeneous row r of m applied to p, with an implicit trailing 1 */
+template <std::floating_point T, std::size_t N, std::size_t... Js>
+[[nodiscard]] constexpr T
+apply_row(
+    matrix<T, N> const & m, std::size_t r,
+    std::array<T, N - 1> const & p, std::index_sequence<Js...>) noexcept
+{
+  return (m[r][N - 1] + ... + (m[r][Js] * p[Js]));
+}
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef GEO_DETAIL_VIEWS_HPP
+#define GEO_DETAIL_VIEWS_HPP
+
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace geo::detail {
+
+/* Partially applied adaptor, range | closure calls it with the range. The
+ * standard offers no hook for user adaptors before C++23. */
+template <typename F>
+struct view_closure
+{
+  F f;
+
+  template <std::ranges::viewable_range Range>
+  requires std::invocable<F const &, Range>
+  [[nodiscard]] constexpr auto
+  operator()(Range && range) const
+  {
+    return f(std::forward<Range>(range));
+  }
+
+  template <std::ranges::viewable_range Range>
+  requires std::invocable<F const &, Range>
+  [[nodiscard]] friend constexpr auto
+  operator|(Range && range, view_closure const & closure)
+  {
+    return closure.f(std::forward<Range>(range));
+  }
+
+  /* the usual temporary closure binds here, which also keeps it from being
+   * ambiguous with catch-all pipe operators of other libraries */
+  template <std::ranges::viewable_range Range>
+  requires std::invocable<F const &, Range>
+  [[nodiscard]] friend constexpr auto
+  operator|(Range && range, view_closure && closure)
+  {
+    return closure.f(std::forward<Range>(range));
+  }
+};
+
+template <typename F>
+view_closure(F) -> view_closure<F>;
+
+/* An object captured by a lazy view: lvalues by reference, rvalues by
+ * value, so views over temporaries do not dangle. Converts to T const &
+ * either way. */
+template <typename T>
+using view_capture_t = std::conditional_t<
+  std::is_lvalue_reference_v<T>,
+  std::reference_wrapper<std::remove_reference_t<T> const>,
+  std::remove_cvref_t<T>
+>;
+
+} // namespace geo::detail
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef GEO_EXECUTION_HPP
+#define GEO_EXECUTION_HPP
+
+#include <concepts>
+#include <type_traits>
+
+#include "detail/detail_execution.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** policies ********************************/
+
+/* Bulk algorithms take an optional policy as first argument, mirroring the
+ * standard library. The parallel versions run on std::thread directly, so
+ * they work without a parallel STL backend. */
+namespace execution {
+
+struct sequenced_policy {};
+struct parallel_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+
+} // namespace execution
+
+namespace concepts {
+
+template <typename Policy>
+concept execution_policy =
+  std::same_as<std::remove_cvref_t<Policy>, execution::sequenced_policy>
+  || std::same_as<std::remove_cvref_t<Policy>, execution::parallel_policy>;
+
+} // namespace concepts
+
+} // namespace geo
+
+#endif
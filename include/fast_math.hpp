@@ -0,0 +1,200 @@
+#ifndef GEO_FAST_MATH_HPP
+#define GEO_FAST_MATH_HPP
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <numbers>
+#include <ranges>
+
+#include "detail/detail_fast_math.hpp"
+#include "math.hpp"
+
+namespace geo {
+
+/***************************** policies ********************************/
+
+namespace policy {
+
+struct exact {};
+struct fast {};
+
+} // namespace policy
+
+namespace concepts {
+
+template <typename Policy>
+concept math_policy =
+  std::same_as<Policy, policy::exact> || std::same_as<Policy, policy::fast>;
+
+} // namespace concepts
+
+/***************************** fast math ********************************/
+
+// Approximations trading accuracy for throughput. All functions are branch-free
+// apart from selects, so the range overloads vectorize on contiguous input.
+// Error bounds are measured against the correctly rounded result:
+//
+//   rsqrt, sqrt   float: <= 3 ulp       double: <= 3 ulp
+//   acos          float: <= 6e-7 abs    double: <= 3e-8 abs
+//   atan2         float: <= 4e-7 abs    double: <= 4e-8 abs
+//
+// long double falls back to the exact functions.
+namespace fast {
+
+// precondition: x is positive and normal
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+rsqrt(T x) noexcept
+{
+  if constexpr (detail::has_rsqrt_estimate<T>) {
+    using estimate = detail::rsqrt_estimate<T>;
+    using bits_type = typename estimate::bits_type;
+
+    T y = std::bit_cast<T>(estimate::magic - (std::bit_cast<bits_type>(x) >> 1));
+    T const half_x = T{0.5} * x;
+    for (std::size_t i = 0; i < estimate::steps; ++i) {
+      y = y * (T{1.5} - half_x * y * y);
+    }
+    return y;
+  } else {
+    return T{1} / geo::sqrt(x);
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sqrt(T x) noexcept
+{
+  return x > T{} ? x * rsqrt(x) : (x == T{} ? T{} : std::numeric_limits<T>::quiet_NaN());
+}
+
+// precondition: -1 <= x <= 1
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+acos(T x) noexcept
+{
+  T const abs_x = x < T{} ? -x : x;
+  T const result = fast::sqrt(T{1} - abs_x) * detail::horner(abs_x, detail::acos_coeffs<T>);
+  return x < T{} ? std::numbers::pi_v<T> - result : result;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+atan2(T y, T x) noexcept
+{
+  T const abs_x = x < T{} ? -x : x;
+  T const abs_y = y < T{} ? -y : y;
+  T const max = abs_x < abs_y ? abs_y : abs_x;
+  T const min = abs_x < abs_y ? abs_x : abs_y;
+
+  T const z = max == T{} ? T{} : min / max;
+  T result = z * detail::horner(z * z, detail::atan_coeffs<T>);
+  result = abs_y > abs_x ? std::numbers::pi_v<T> / T{2} - result : result;
+  result = x < T{} ? std::numbers::pi_v<T> - result : result;
+  return y < T{} ? -result : result;
+}
+
+/***************************** batch ********************************/
+
+template <std::ranges::input_range Range, std::weakly_incrementable Out>
+requires std::floating_point<std::ranges::range_value_t<Range>>
+constexpr Out
+rsqrt(Range && range, Out out)
+{
+  for (auto const x : range) {
+    *out = fast::rsqrt(x);
+    ++out;
+  }
+  return out;
+}
+
+template <std::ranges::input_range Range, std::weakly_incrementable Out>
+requires std::floating_point<std::ranges::range_value_t<Range>>
+constexpr Out
+sqrt(Range && range, Out out)
+{
+  for (auto const x : range) {
+    *out = fast::sqrt(x);
+    ++out;
+  }
+  return out;
+}
+
+template <std::ranges::input_range Range, std::weakly_incrementable Out>
+requires std::floating_point<std::ranges::range_value_t<Range>>
+constexpr Out
+acos(Range && range, Out out)
+{
+  for (auto const x : range) {
+    *out = fast::acos(x);
+    ++out;
+  }
+  return out;
+}
+
+} // namespace fast
+
+/***************************** dispatch ********************************/
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sqrt(T x, policy::exact) noexcept
+{
+  return geo::sqrt(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sqrt(T x, policy::fast) noexcept
+{
+  return fast::sqrt(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+rsqrt(T x, policy::exact) noexcept
+{
+  return T{1} / geo::sqrt(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+rsqrt(T x, policy::fast) noexcept
+{
+  return fast::rsqrt(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+acos(T x, policy::exact) noexcept
+{
+  return geo::acos(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+acos(T x, policy::fast) noexcept
+{
+  return fast::acos(x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+atan2(T y, T x, policy::exact) noexcept
+{
+  return geo::atan2(y, x);
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+atan2(T y, T x, policy::fast) noexcept
+{
+  return fast::atan2(y, x);
+}
+
+} // namespace geo
+
+#endif
@@ -4,10 +4,35 @@
 #include "algebra.hpp"
 #include "algorithm.hpp"
 #include "bezier.hpp"
+#include "bezier_batch.hpp"
+#include "bezier_degree.hpp"
+#include "bezier_fit.hpp"
+#include "box.hpp"
+#include "bvh.hpp"
 #include "circle.hpp"
+#include "circle_fit.hpp"
+#include "compressed_bezier_batch.hpp"
+#include "convex_hull.hpp"
+#include "delaunay.hpp"
+#include "execution.hpp"
+#include "fast_math.hpp"
+#include "inline_vector.hpp"
+#include "intersect.hpp"
+#include "interval.hpp"
+#include "io.hpp"
 #include "line.hpp"
 #include "math.hpp"
+#include "parse.hpp"
 #include "point.hpp"
+#include "point_cloud.hpp"
+#include "predicates.hpp"
+#include "quaternion.hpp"
+#include "ray.hpp"
+#include "spatial_sort.hpp"
+#include "stats.hpp"
+#include "sweep_and_prune.hpp"
 #include "traits.hpp"
+#include "transform.hpp"
+#include "views.hpp"
 
 #endif
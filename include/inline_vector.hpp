@@ -0,0 +1,133 @@
+#ifndef GEO_INLINE_VECTOR_HPP
+#define GEO_INLINE_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Vector-like container with fixed capacity and inline storage. It never
+ * allocates, is usable in constant expressions and satisfies
+ * concepts::container, so it can replace std::vector as Bezier container.
+ * T has to be default constructible. */
+template <typename T, std::size_t Capacity>
+requires (Capacity > 0) && std::default_initializable<T>
+struct InlineVector
+{
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = value_type const &;
+  using pointer = value_type *;
+  using const_pointer = value_type const *;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+
+  constexpr InlineVector() = default;
+
+  constexpr InlineVector(std::initializer_list<T> init)
+      : InlineVector(init.begin(), init.end())
+  {}
+
+  template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+  constexpr InlineVector(It first, Sentinel last)
+  {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  constexpr explicit InlineVector(size_type initial_size, T const & value = T{})
+  {
+    resize(initial_size, value);
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return elems.data(); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return elems.data(); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return elems.data(); }
+  [[nodiscard]] constexpr iterator end() noexcept { return elems.data() + count; }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return elems.data() + count; }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return elems.data() + count; }
+
+  [[nodiscard]] constexpr pointer data() noexcept { return elems.data(); }
+  [[nodiscard]] constexpr const_pointer data() const noexcept { return elems.data(); }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return count; }
+  [[nodiscard]] constexpr size_type max_size() const noexcept { return Capacity; }
+  [[nodiscard]] constexpr size_type capacity() const noexcept { return Capacity; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+
+  [[nodiscard]] constexpr reference operator[](size_type i) noexcept { return elems[i]; }
+  [[nodiscard]] constexpr const_reference operator[](size_type i) const noexcept { return elems[i]; }
+
+  [[nodiscard]] constexpr reference front() noexcept { return elems[0]; }
+  [[nodiscard]] constexpr const_reference front() const noexcept { return elems[0]; }
+  [[nodiscard]] constexpr reference back() noexcept { return elems[count - 1]; }
+  [[nodiscard]] constexpr const_reference back() const noexcept { return elems[count - 1]; }
+
+  constexpr void
+  push_back(T const & value)
+  {
+    if (count == Capacity) {
+      throw std::length_error("inline vector capacity exceeded");
+    }
+    elems[count++] = value;
+  }
+
+  template <typename... Args>
+  constexpr reference
+  emplace_back(Args && ... args)
+  {
+    push_back(T(std::forward<Args>(args)...));
+    return back();
+  }
+
+  constexpr void
+  pop_back() noexcept
+  {
+    elems[--count] = T{};
+  }
+
+  constexpr void
+  resize(size_type new_size, T const & value = T{})
+  {
+    if (new_size > Capacity) {
+      throw std::length_error("inline vector capacity exceeded");
+    }
+    std::fill(elems.begin() + static_cast<difference_type>(std::min(count, new_size)),
+              elems.begin() + static_cast<difference_type>(new_size),
+              value);
+    std::fill(elems.begin() + static_cast<difference_type>(new_size),
+              elems.begin() + static_cast<difference_type>(std::max(count, new_size)),
+              T{});
+    count = new_size;
+  }
+
+  constexpr void
+  clear() noexcept
+  {
+    resize(0);
+  }
+
+  [[nodiscard]] friend constexpr bool
+  operator==(InlineVector const & lhs, InlineVector const & rhs)
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  std::array<T, Capacity> elems{};
+  size_type count{};
+};
+
+} // namespace geo
+
+#endif
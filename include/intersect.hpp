@@ -0,0 +1,111 @@
+#ifndef GEO_INTERSECT_HPP
+#define GEO_INTERSECT_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <ranges>
+
+#include "algebra.hpp"
+#include "detail/detail_intersect.hpp"
+#include "execution.hpp"
+#include "line.hpp"
+#include "point.hpp"
+#include "predicates.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+template <typename Range>
+concept line_range =
+  std::ranges::random_access_range<Range>
+  && std::ranges::sized_range<Range>
+  && line<std::ranges::range_value_t<Range>>
+  && dimension_equals<detail::line_point_t<std::ranges::range_value_t<Range>>, 2>
+  && std::floating_point<traits::value_type_t<detail::line_point_t<std::ranges::range_value_t<Range>>>>;
+
+} // namespace concepts
+
+/***************************** algorithms ********************************/
+
+/* true if the closed segments share at least one point, decided exactly */
+template <concepts::point Point>
+requires concepts::dimension_equals<Point, 2> && std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr bool
+intersects(Line<Point> const & lhs, Line<Point> const & rhs) noexcept
+{
+  return detail::segments_intersect(lhs.start, lhs.end, rhs.start, rhs.end);
+}
+
+/* Common point of two segments, if any. Whether they intersect is decided
+ * exactly, the point itself is rounded. Overlapping collinear segments
+ * return an end point of the overlap. */
+template <concepts::point Point>
+requires concepts::dimension_equals<Point, 2> && std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr std::optional<Point>
+intersect(Line<Point> const & lhs, Line<Point> const & rhs) noexcept
+{
+  using T = traits::value_type_t<Point>;
+
+  if (!intersects(lhs, rhs)) {
+    return std::nullopt;
+  }
+
+  auto const d1 = lhs.end - lhs.start;
+  auto const d2 = rhs.end - rhs.start;
+  T const denom = get<0>(d1) * get<1>(d2) - get<1>(d1) * get<0>(d2);
+  if (orientation(lhs.start, lhs.end, rhs.start) != 0 || orientation(lhs.start, lhs.end, rhs.end) != 0) {
+    if (denom != T{}) {
+      auto const offset = rhs.start - lhs.start;
+      T const t = (get<0>(offset) * get<1>(d2) - get<1>(offset) * get<0>(d2)) / denom;
+      return lhs.start + d1 * std::clamp(t, T{0}, T{1});
+    }
+  }
+
+  /* collinear or degenerate, one of the end points lies on the other segment */
+  for (auto const & candidate : {rhs.start, rhs.end}) {
+    if (orientation(lhs.start, lhs.end, candidate) == 0 && detail::within_bounds(lhs.start, lhs.end, candidate)) {
+      return candidate;
+    }
+  }
+  return orientation(rhs.start, rhs.end, lhs.start) == 0 ? lhs.start : lhs.end;
+}
+
+/* Calls callback(i, j) with i < j for every pair of intersecting segments
+ * lines[i] and lines[j], each pair exactly once and in no particular order.
+ *
+ * The sequential version is a Bentley-Ottmann sweep over exact predicates
+ * and takes O((n + k) log n) for k intersecting pairs, degenerate input
+ * included. The parallel version buckets each segment into the cells of a
+ * uniform grid that it crosses and processes cells concurrently, suited to
+ * dense input; callback is then invoked from several threads at once and
+ * has to synchronize itself. Both throw std::invalid_argument for a
+ * non-finite coordinate. */
+template <concepts::line_range Range, typename Callback>
+void
+intersections(execution::sequenced_policy, Range const & lines, Callback && callback)
+{
+  detail::sweep_intersections(lines, callback);
+}
+
+template <concepts::line_range Range, typename Callback>
+void
+intersections(execution::parallel_policy, Range const & lines, Callback && callback)
+{
+  detail::grid_intersections(lines, callback);
+}
+
+template <concepts::line_range Range, typename Callback>
+void
+intersections(Range const & lines, Callback && callback)
+{
+  intersections(execution::seq, lines, callback);
+}
+
+} // namespace geo
+
+#endif
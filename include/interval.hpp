@@ -0,0 +1,199 @@
+#ifndef GEO_INTERVAL_HPP
+#define GEO_INTERVAL_HPP
+
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "detail/detail_interval.hpp"
+#include "fast_math.hpp"
+#include "math.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Closed interval [lower, upper] of real numbers, for guaranteed
+ * enclosures: the result of every operation contains the results of the
+ * operation on all numbers of the operands. Under policy::exact each bound
+ * is rounded outwards by an ulp or two, which keeps that guarantee despite
+ * rounding; policy::fast rounds to nearest, is tighter and several times
+ * cheaper, and may miss by rounding. Bounds are meant to be finite; dividing
+ * by an interval that contains zero gives the whole real line.
+ *
+ * Intervals opt in to concepts::arithmetic, so Vector2x<Interval<double>>
+ * is a point and Beziers over such points evaluate, at an Interval of
+ * parameters, to an enclosure of the curve over those parameters. Such an
+ * enclosure of a part of a curve rules that part out of an intersection or
+ * nearest point search without subdividing it. */
+template <std::floating_point T, concepts::math_policy Policy = policy::exact>
+struct Interval
+{
+  using value_type = T;
+  using policy_type = Policy;
+
+  constexpr Interval() = default;
+
+  /* implicit, so that numbers mix with intervals */
+  constexpr Interval(T value) noexcept
+      : lower(value), upper(value)
+  {}
+
+  constexpr Interval(T lower, T upper)
+      : lower(lower), upper(upper)
+  {
+    if (!(lower <= upper)) {
+      throw std::invalid_argument("empty interval");
+    }
+  }
+
+  [[nodiscard]] constexpr T
+  width() const noexcept
+  {
+    return upper - lower;
+  }
+
+  [[nodiscard]] constexpr T
+  midpoint() const noexcept
+  {
+    return lower + (upper - lower) / 2;
+  }
+
+  [[nodiscard]] constexpr bool
+  contains(T value) const noexcept
+  {
+    return lower <= value && value <= upper;
+  }
+
+  [[nodiscard]] friend constexpr bool
+  operator==(Interval const &, Interval const &) noexcept = default;
+
+  [[nodiscard]] friend constexpr Interval
+  operator-(Interval const & x) noexcept
+  {
+    return bounds(-x.upper, -x.lower);
+  }
+
+  [[nodiscard]] friend constexpr Interval
+  operator+(Interval const & lhs, Interval const & rhs) noexcept
+  {
+    return bounds(detail::round_down<Policy>(lhs.lower + rhs.lower), detail::round_up<Policy>(lhs.upper + rhs.upper));
+  }
+
+  [[nodiscard]] friend constexpr Interval
+  operator-(Interval const & lhs, Interval const & rhs) noexcept
+  {
+    return bounds(detail::round_down<Policy>(lhs.lower - rhs.upper), detail::round_up<Policy>(lhs.upper - rhs.lower));
+  }
+
+  [[nodiscard]] friend constexpr Interval
+  operator*(Interval const & lhs, Interval const & rhs) noexcept
+  {
+    auto const [low, high] = detail::corner_bounds(
+      lhs.lower, lhs.upper, rhs.lower, rhs.upper, [](T a, T b) { return a * b; });
+    return bounds(detail::round_down<Policy>(low), detail::round_up<Policy>(high));
+  }
+
+  [[nodiscard]] friend constexpr Interval
+  operator/(Interval const & lhs, Interval const & rhs) noexcept
+  {
+    if (rhs.lower <= T{} && T{} <= rhs.upper) {
+      return bounds(-std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity());
+    }
+    auto const [low, high] = detail::corner_bounds(
+      lhs.lower, lhs.upper, rhs.lower, rhs.upper, [](T a, T b) { return a / b; });
+    return bounds(detail::round_down<Policy>(low), detail::round_up<Policy>(high));
+  }
+
+  constexpr Interval &
+  operator+=(Interval const & rhs) noexcept
+  {
+    return *this = *this + rhs;
+  }
+
+  constexpr Interval &
+  operator-=(Interval const & rhs) noexcept
+  {
+    return *this = *this - rhs;
+  }
+
+  constexpr Interval &
+  operator*=(Interval const & rhs) noexcept
+  {
+    return *this = *this * rhs;
+  }
+
+  constexpr Interval &
+  operator/=(Interval const & rhs) noexcept
+  {
+    return *this = *this / rhs;
+  }
+
+  T lower{};
+  T upper{};
+
+private:
+  /* the bounds are ordered by construction, no check needed */
+  [[nodiscard]] static constexpr Interval
+  bounds(T lower, T upper) noexcept
+  {
+    Interval retval;
+    retval.lower = lower;
+    retval.upper = upper;
+    return retval;
+  }
+};
+
+/***************************** adaptors ********************************/
+
+namespace traits {
+
+template <std::floating_point T, concepts::math_policy Policy>
+struct is_arithmetic<Interval<T, Policy>> : std::true_type {};
+
+} // namespace traits
+
+/***************************** algorithms ********************************/
+
+/* x * x, which unlike the product never reaches below zero */
+template <std::floating_point T, concepts::math_policy Policy>
+[[nodiscard]] constexpr Interval<T, Policy>
+square(Interval<T, Policy> const & x)
+{
+  if (x.lower >= T{} || x.upper <= T{}) {
+    return x * x;
+  }
+  T const high = std::max(x.lower * x.lower, x.upper * x.upper);
+  return {T{}, detail::round_up<Policy>(high)};
+}
+
+/* square root of the nonnegative part of x */
+template <std::floating_point T, concepts::math_policy Policy>
+[[nodiscard]] constexpr Interval<T, Policy>
+sqrt(Interval<T, Policy> const & x)
+{
+  T const low = x.lower > T{} ? detail::round_down<Policy>(geo::sqrt(x.lower)) : T{};
+  T const high = x.upper > T{} ? detail::round_up<Policy>(geo::sqrt(x.upper)) : T{};
+  return {std::max(low, T{}), high};
+}
+
+/* the smallest interval containing both */
+template <std::floating_point T, concepts::math_policy Policy>
+[[nodiscard]] constexpr Interval<T, Policy>
+hull(Interval<T, Policy> const & lhs, Interval<T, Policy> const & rhs)
+{
+  return {std::min(lhs.lower, rhs.lower), std::max(lhs.upper, rhs.upper)};
+}
+
+template <std::floating_point T, concepts::math_policy Policy>
+[[nodiscard]] constexpr bool
+intersects(Interval<T, Policy> const & lhs, Interval<T, Policy> const & rhs) noexcept
+{
+  return lhs.lower <= rhs.upper && rhs.lower <= lhs.upper;
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef GEO_IO_HPP
+#define GEO_IO_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "bezier.hpp"
+#include "circle.hpp"
+#include "detail/detail_bezier.hpp"
+#include "detail/detail_io.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo::io {
+
+/***************************** format ********************************/
+
+/* File layout, native byte order (checked on open):
+ *
+ *   header    64 bytes: magic, version, byte order mark, section count and
+ *             offset of the section table
+ *   sections  packed scalars, every section starts at a 64 byte boundary
+ *               points   count * dimension
+ *               circles  count * (dimension + 1), center then radius
+ *               beziers  count * (degree + 1) * dimension
+ *   table     section_count section headers
+ *
+ * The table is written last, so sections stream out without knowing their
+ * number or size in advance. */
+enum class section_kind : std::uint32_t
+{
+  points = 1,
+  circles = 2,
+  beziers = 3
+};
+
+struct SectionInfo
+{
+  section_kind kind;
+  std::uint32_t scalar;     /* byte size, bit 8 floating point, bit 9 signed */
+  std::size_t dimension;
+  std::size_t degree;
+  std::size_t count;
+  std::size_t offset;
+};
+
+/***************************** writer ********************************/
+
+class Writer
+{
+public:
+  explicit Writer(std::filesystem::path const & path)
+      : out_(path, std::ios::binary | std::ios::trunc)
+  {
+    if (!out_) {
+      throw std::runtime_error("unable to open " + path.string());
+    }
+    write_header(0, 0);
+  }
+
+  Writer(Writer &&) = default;
+  Writer & operator=(Writer &&) = default;
+
+  ~Writer()
+  {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  template <std::ranges::input_range Range>
+  requires concepts::point<std::ranges::range_value_t<Range>>
+  void
+  write_points(Range && points)
+  {
+    using Point = std::ranges::range_value_t<Range>;
+
+    auto & section = begin_section(
+      section_kind::points, detail::scalar_code<traits::value_type_t<Point>>(),
+      traits::dimension_v<Point>, 0);
+    for (auto const & point : points) {
+      write_point(point);
+      ++section.count;
+    }
+  }
+
+  template <std::ranges::input_range Range>
+  requires concepts::circle<std::ranges::range_value_t<Range>>
+  void
+  write_circles(Range && circles)
+  {
+    using Circle = std::ranges::range_value_t<Range>;
+    using Point = traits::point_type_t<Circle>;
+
+    auto & section = begin_section(
+      section_kind::circles, detail::scalar_code<traits::value_type_t<Point>>(),
+      traits::dimension_v<Point>, 0);
+    for (auto const & circle : circles) {
+      write_point(traits::access_center<Circle>::get(circle));
+      write_scalar(traits::access_radius<Circle>::get(circle));
+      ++section.count;
+    }
+  }
+
+  template <std::ranges::input_range Range>
+  requires concepts::bezier<std::ranges::range_value_t<Range>>
+  void
+  write_beziers(Range && beziers)
+  {
+    using Bezier = std::ranges::range_value_t<Range>;
+    using Point = detail::ctrl_point_t<Bezier>;
+
+    auto & section = begin_section(
+      section_kind::beziers, detail::scalar_code<traits::value_type_t<Point>>(),
+      traits::dimension_v<Point>, traits::degree_v<Bezier>);
+    for (auto const & bezier : beziers) {
+      for (auto const & ctrl : detail::copy_ctrls(bezier)) {
+        write_point(ctrl);
+      }
+      ++section.count;
+    }
+  }
+
+  /* writes the section table, the writer is unusable afterwards */
+  void
+  close()
+  {
+    if (!out_.is_open()) {
+      return;
+    }
+    auto const table_offset = pad();
+    for (auto const & section : sections_) {
+      write_bytes(&section, sizeof(section));
+    }
+    out_.seekp(0);
+    write_header(sections_.size(), table_offset);
+    out_.close();
+    if (out_.fail()) {
+      throw std::runtime_error("unable to write geometry file");
+    }
+  }
+
+private:
+  void
+  write_header(std::uint64_t section_count, std::uint64_t table_offset)
+  {
+    detail::file_header const header{
+      detail::file_magic, detail::file_version, detail::file_byte_order,
+      section_count, table_offset, {}
+    };
+    write_bytes(&header, sizeof(header));
+  }
+
+  detail::section_header &
+  begin_section(section_kind kind, std::uint32_t scalar, std::size_t dimension, std::size_t degree)
+  {
+    if (!out_.is_open()) {
+      throw std::logic_error("geometry file already closed");
+    }
+    auto const offset = pad();
+    return sections_.emplace_back(detail::section_header{
+      static_cast<std::uint32_t>(kind),
+      scalar,
+      static_cast<std::uint32_t>(dimension),
+      static_cast<std::uint32_t>(degree),
+      0,
+      offset
+    });
+  }
+
+  template <concepts::point Point>
+  void
+  write_point(Point const & point)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (..., write_scalar(get<Is>(point)));
+    }(std::make_index_sequence<traits::dimension_v<Point>>{});
+  }
+
+  template <concepts::arithmetic T>
+  void
+  write_scalar(T value)
+  {
+    write_bytes(&value, sizeof(value));
+  }
+
+  void
+  write_bytes(void const * data, std::size_t size)
+  {
+    out_.write(static_cast<char const *>(data), static_cast<std::streamsize>(size));
+  }
+
+  /* zero fills up to the next section boundary and returns the new offset */
+  std::uint64_t
+  pad()
+  {
+    auto const offset = static_cast<std::uint64_t>(out_.tellp());
+    auto const aligned = detail::align_up(offset);
+    std::array<char, detail::file_alignment> const zeros{};
+    write_bytes(zeros.data(), aligned - offset);
+    return aligned;
+  }
+
+  std::ofstream out_;
+  std::vector<detail::section_header> sections_;
+};
+
+/***************************** reader ********************************/
+
+/* Maps a geometry file into memory. Sections are exposed as random access
+ * views over the mapping whose elements satisfy the point, circle and bezier
+ * concepts; reading an element copies it out. The views stay valid as long
+ * as the reader lives. */
+class Reader
+{
+public:
+  explicit Reader(std::filesystem::path const & path)
+      : file_(path)
+  {
+    auto const bytes = file_.bytes();
+
+    detail::file_header header;
+    if (bytes.size() < sizeof(header)) {
+      throw std::runtime_error("invalid geometry file: truncated header");
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != detail::file_magic) {
+      throw std::runtime_error("invalid geometry file: bad magic");
+    }
+    if (header.byte_order != detail::file_byte_order) {
+      throw std::runtime_error("invalid geometry file: foreign byte order");
+    }
+    if (header.version != detail::file_version) {
+      throw std::runtime_error("unsupported geometry file version");
+    }
+    if (header.table_offset > bytes.size()
+        || header.section_count > (bytes.size() - header.table_offset) / sizeof(detail::section_header)) {
+      throw std::runtime_error("invalid geometry file: truncated section table");
+    }
+
+    sections_.reserve(header.section_count);
+    for (std::size_t i = 0; i < header.section_count; ++i) {
+      detail::section_header section;
+      std::memcpy(&section,
+                  bytes.data() + header.table_offset + i * sizeof(section),
+                  sizeof(section));
+      SectionInfo const info{
+        static_cast<section_kind>(section.kind),
+        section.scalar, section.dimension, section.degree,
+        static_cast<std::size_t>(section.count), static_cast<std::size_t>(section.offset)
+      };
+      auto const scalar_size = info.scalar & 0xffu;
+      if (scalar_size == 0
+          || info.offset > bytes.size()
+          || !fits(info, (bytes.size() - info.offset) / scalar_size)) {
+        throw std::runtime_error("invalid geometry file: truncated section");
+      }
+      if (info.offset % detail::file_alignment != 0) {
+        throw std::runtime_error("invalid geometry file: misaligned section");
+      }
+      sections_.push_back(info);
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  section_count() const noexcept
+  {
+    return sections_.size();
+  }
+
+  [[nodiscard]] SectionInfo const &
+  section(std::size_t index) const
+  {
+    return sections_.at(index);
+  }
+
+  /* Point has to be layout compatible with value_type_t<Point>[dimension],
+   * e.g. Vector2x<T> or Vector3x<T>. Random access range of Point. */
+  template <concepts::point Point>
+  [[nodiscard]] auto
+  points(std::size_t index) const
+  {
+    static_assert(sizeof(Point) == traits::dimension_v<Point> * sizeof(traits::value_type_t<Point>)
+                  && std::is_standard_layout_v<Point> && std::is_trivially_copyable_v<Point>);
+
+    auto const & info = checked_section<Point>(index, section_kind::points, 0);
+    return elements<Point>(info);
+  }
+
+  /* Circle has to be layout compatible with center followed by radius,
+   * e.g. Circle<Vector3x<T>>. Random access range of Circle. */
+  template <concepts::circle Circle>
+  [[nodiscard]] auto
+  circles(std::size_t index) const
+  {
+    using Point = traits::point_type_t<Circle>;
+    static_assert(sizeof(Circle) == (traits::dimension_v<Point> + 1) * sizeof(traits::value_type_t<Point>)
+                  && std::is_standard_layout_v<Circle> && std::is_trivially_copyable_v<Circle>);
+
+    auto const & info = checked_section<Point>(index, section_kind::circles, 0);
+    return elements<Circle>(info);
+  }
+
+  /* random access range of Bezier<Degree, Point, std::array<Point, Degree + 1>> */
+  template <std::size_t Degree, concepts::point Point>
+  [[nodiscard]] auto
+  beziers(std::size_t index) const
+  {
+    using Ctrls = std::array<Point, Degree + 1>;
+    static_assert(sizeof(Point) == traits::dimension_v<Point> * sizeof(traits::value_type_t<Point>)
+                  && std::is_standard_layout_v<Point> && std::is_trivially_copyable_v<Point>
+                  && sizeof(Ctrls) == (Degree + 1) * sizeof(Point));
+
+    auto const & info = checked_section<Point>(index, section_kind::beziers, Degree);
+    return elements<Ctrls>(info)
+      | std::views::transform([](Ctrls const & ctrls) { return Bezier<Degree, Point, Ctrls>(ctrls); });
+  }
+
+private:
+  /* whether the section holds at most limit scalars; divides instead of
+   * multiplying, counts come from untrusted files and may be huge */
+  [[nodiscard]] static bool
+  fits(SectionInfo const & info, std::size_t limit) noexcept
+  {
+    std::size_t per_element = 0;
+    switch (info.kind) {
+      case section_kind::points: per_element = info.dimension; break;
+      case section_kind::circles: per_element = info.dimension + 1; break;
+      case section_kind::beziers:
+        if (info.dimension != 0 && info.degree + 1 > limit / info.dimension) {
+          return info.count == 0;
+        }
+        per_element = (info.degree + 1) * info.dimension;
+        break;
+    }
+    return per_element == 0 || info.count <= limit / per_element;
+  }
+
+  template <concepts::point Point>
+  [[nodiscard]] SectionInfo const &
+  checked_section(std::size_t index, section_kind kind, std::size_t degree) const
+  {
+    auto const & info = section(index);
+    if (info.kind != kind
+        || info.scalar != detail::scalar_code<traits::value_type_t<Point>>()
+        || info.dimension != traits::dimension_v<Point>
+        || info.degree != degree) {
+      throw std::invalid_argument("geometry file section does not match the requested type");
+    }
+    return info;
+  }
+
+  /* The mapping holds bytes, not objects of T, so elements are copied out
+   * of it rather than accessed through a T const * into it. */
+  template <typename T>
+  [[nodiscard]] auto
+  elements(SectionInfo const & info) const
+  {
+    std::byte const * const first = file_.bytes().data() + info.offset;
+    return std::views::iota(std::size_t{0}, info.count)
+      | std::views::transform([first](std::size_t i) {
+          T element;
+          std::memcpy(&element, first + i * sizeof(T), sizeof(T));
+          return element;
+        });
+  }
+
+  detail::mapped_file file_;
+  std::vector<SectionInfo> sections_;
+};
+
+} // namespace geo::io
+
+#endif
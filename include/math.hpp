@@ -7,6 +7,7 @@
 #include <numbers>
 
 #include "detail/detail_math.hpp"
+#include "detail/detail_stats.hpp"
 
 namespace geo {
 
@@ -35,10 +36,12 @@ template <std::floating_point T>
 [[nodiscard]] constexpr T
 sqrt(T x)
 {
+  GEO_STATS_SCOPE(sqrt);
   if (std::is_constant_evaluated()) {
-    return x >= T{} && x < std::numeric_limits<T>::infinity()
-      ? detail::sqrt_newton_raphson(x, x, T())
-      : std::numeric_limits<T>::quiet_NaN();
+    if (detail::is_nan(x) || x < T{}) {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+    return x == T{} || detail::is_inf(x) ? x : detail::sqrt_newton_raphson(x);
   } else {
     return std::sqrt(x);
   }
@@ -51,6 +54,75 @@ sqrt(T x)
   return sqrt(static_cast<double>(x));
 }
 
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+cbrt(T x)
+{
+  if (std::is_constant_evaluated()) {
+    if (detail::is_nan(x) || x == T{} || detail::is_inf(x)) {
+      return x;
+    }
+    return x < T{} ? -detail::cbrt_newton_raphson(-x) : detail::cbrt_newton_raphson(x);
+  } else {
+    return std::cbrt(x);
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+hypot(T x, T y)
+{
+  if (std::is_constant_evaluated()) {
+    return detail::hypot_impl(x, y);
+  } else {
+    return std::hypot(x, y);
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+sin(T x)
+{
+  if (std::is_constant_evaluated()) {
+    return detail::sin_impl(x);
+  } else {
+    return std::sin(x);
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+cos(T x)
+{
+  if (std::is_constant_evaluated()) {
+    return detail::cos_impl(x);
+  } else {
+    return std::cos(x);
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+atan2(T y, T x)
+{
+  if (std::is_constant_evaluated()) {
+    return detail::atan2_impl(y, x);
+  } else {
+    return std::atan2(y, x);
+  }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+acos(T x)
+{
+  if (std::is_constant_evaluated()) {
+    return detail::acos_impl(x);
+  } else {
+    return std::acos(x);
+  }
+}
+
 // TODO fix constraints
 template <
   std::totally_ordered Head0,
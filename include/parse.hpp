@@ -0,0 +1,433 @@
+#ifndef GEO_PARSE_HPP
+#define GEO_PARSE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "algebra.hpp"
+#include "bezier.hpp"
+#include "detail/detail_parse.hpp"
+#include "line.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+#if defined(_WIN32)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace geo::io {
+
+/***************************** parsers ********************************/
+
+/* Streaming parsers for text geometry. Input arrives in chunks of any size
+ * through feed(), finish() ends the input. Geometry is handed to the sink as
+ * soon as it is complete, the sink is invoked with
+ *
+ *   Line<Point>               line segments
+ *   InlineBezier<2, Point>    quadratic segments (SVG only)
+ *   InlineBezier<3, Point>    cubic segments (SVG only)
+ *
+ * Parsing never allocates. Malformed input throws std::invalid_argument with
+ * the byte offset of the offending token. */
+
+/* SVG path data (the d attribute), all commands but elliptical arcs */
+template <concepts::point Point, typename Sink>
+requires concepts::dimension_equals<Point, 2>
+      && std::floating_point<traits::value_type_t<Point>>
+class SvgPathParser
+{
+public:
+  using value_type = traits::value_type_t<Point>;
+
+  explicit SvgPathParser(Sink sink)
+      : sink_(std::forward<Sink>(sink))
+  {}
+
+  void
+  feed(std::string_view chunk)
+  {
+    carry_.feed(chunk, is_separator, [this](std::string_view text, std::size_t offset) {
+      parse(text, offset);
+    });
+  }
+
+  void
+  finish()
+  {
+    carry_.flush([this](std::string_view text, std::size_t offset) {
+      parse(text, offset);
+    });
+    if (count_ != 0) {
+      throw detail::parse_error("incomplete path command", carry_.consumed);
+    }
+  }
+
+private:
+  static constexpr bool
+  is_separator(char c) noexcept
+  {
+    return detail::is_space(c) || c == ',' || arity(c) >= 0;
+  }
+
+  /* number of arguments of a command, -1 if c is not a command */
+  static constexpr int
+  arity(char c) noexcept
+  {
+    switch (c) {
+      case 'Z': case 'z': return 0;
+      case 'H': case 'h': case 'V': case 'v': return 1;
+      case 'M': case 'm': case 'L': case 'l': case 'T': case 't': return 2;
+      case 'S': case 's': case 'Q': case 'q': return 4;
+      case 'C': case 'c': return 6;
+      case 'A': case 'a': return 7;
+      default: return -1;
+    }
+  }
+
+  void
+  parse(std::string_view text, std::size_t offset)
+  {
+    auto const size = text.size();
+    while (!text.empty()) {
+      char const c = text.front();
+      auto const position = offset + size - text.size();
+      if (detail::is_space(c) || c == ',') {
+        text.remove_prefix(1);
+      } else if (arity(c) >= 0) {
+        if (count_ != 0) {
+          throw detail::parse_error("incomplete path command", position);
+        }
+        if (c == 'A' || c == 'a') {
+          throw detail::parse_error("unsupported path command", position);
+        }
+        command_ = c;
+        text.remove_prefix(1);
+        if (arity(c) == 0) {
+          execute();
+        }
+      } else {
+        if (command_ == '\0' || arity(command_) == 0) {
+          throw detail::parse_error("number without path command", position);
+        }
+        args_[count_++] = detail::consume_number<value_type>(text, position);
+        if (count_ == static_cast<std::size_t>(arity(command_))) {
+          execute();
+          count_ = 0;
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] Point
+  arg_point(std::size_t i, bool relative) const noexcept
+  {
+    Point const point(args_[i], args_[i + 1]);
+    return relative ? current_ + point : point;
+  }
+
+  void
+  execute()
+  {
+    bool const relative = command_ >= 'a';
+    char const command = static_cast<char>(relative ? command_ - ('a' - 'A') : command_);
+    char previous = previous_;
+    previous_ = command;
+
+    switch (command) {
+      case 'M':
+        current_ = start_ = arg_point(0, relative);
+        /* further coordinate pairs are implicit line commands */
+        command_ = relative ? 'l' : 'L';
+        break;
+      case 'L':
+        line_to(arg_point(0, relative));
+        break;
+      case 'H':
+        line_to(Point(relative ? get<0>(current_) + args_[0] : args_[0], get<1>(current_)));
+        break;
+      case 'V':
+        line_to(Point(get<0>(current_), relative ? get<1>(current_) + args_[0] : args_[0]));
+        break;
+      case 'C':
+        cubic_to(arg_point(0, relative), arg_point(2, relative), arg_point(4, relative));
+        break;
+      case 'S':
+        cubic_to(previous == 'C' || previous == 'S' ? reflect(control_) : current_,
+                 arg_point(0, relative), arg_point(2, relative));
+        break;
+      case 'Q':
+        quadratic_to(arg_point(0, relative), arg_point(2, relative));
+        break;
+      case 'T':
+        quadratic_to(previous == 'Q' || previous == 'T' ? reflect(control_) : current_,
+                     arg_point(0, relative));
+        break;
+      default: /* Z */
+        if (get<0>(current_) != get<0>(start_) || get<1>(current_) != get<1>(start_)) {
+          line_to(start_);
+        }
+        previous_ = 'Z';
+        break;
+    }
+  }
+
+  [[nodiscard]] Point
+  reflect(Point const & control) const noexcept
+  {
+    return current_ + (current_ - control);
+  }
+
+  void
+  line_to(Point const & end)
+  {
+    sink_(Line<Point>(current_, end));
+    current_ = end;
+  }
+
+  void
+  quadratic_to(Point const & control, Point const & end)
+  {
+    std::array const ctrls{current_, control, end};
+    sink_(InlineBezier<2, Point>(ctrls.cbegin(), ctrls.cend()));
+    control_ = control;
+    current_ = end;
+  }
+
+  void
+  cubic_to(Point const & control0, Point const & control1, Point const & end)
+  {
+    std::array const ctrls{current_, control0, control1, end};
+    sink_(InlineBezier<3, Point>(ctrls.cbegin(), ctrls.cend()));
+    control_ = control1;
+    current_ = end;
+  }
+
+  Sink sink_;
+  detail::chunk_carry<> carry_;
+  std::array<value_type, 7> args_{};
+  std::size_t count_{};
+  char command_{};
+  char previous_{};
+  Point current_{};
+  Point start_{};
+  Point control_{};
+};
+
+/* WKT LINESTRING, POLYGON, MULTILINESTRING and MULTIPOLYGON, optionally with
+ * a Z dimension matching Point. Consecutive vertices become line segments,
+ * any number of geometries may follow each other. */
+template <concepts::point Point, typename Sink>
+requires (concepts::dimension_equals<Point, 2> || concepts::dimension_equals<Point, 3>)
+      && std::floating_point<traits::value_type_t<Point>>
+class WktParser
+{
+public:
+  using value_type = traits::value_type_t<Point>;
+
+  explicit WktParser(Sink sink)
+      : sink_(std::forward<Sink>(sink))
+  {}
+
+  void
+  feed(std::string_view chunk)
+  {
+    carry_.feed(chunk, is_separator, [this](std::string_view text, std::size_t offset) {
+      parse(text, offset);
+    });
+  }
+
+  void
+  finish()
+  {
+    carry_.flush([this](std::string_view text, std::size_t offset) {
+      parse(text, offset);
+    });
+    if (depth_ != 0 || state_ == state::dimension) {
+      throw detail::parse_error("incomplete geometry", carry_.consumed);
+    }
+  }
+
+private:
+  enum class state { keyword, dimension, coordinates };
+
+  static constexpr bool
+  is_separator(char c) noexcept
+  {
+    return detail::is_space(c) || c == ',' || c == '(' || c == ')';
+  }
+
+  [[nodiscard]] static bool
+  equals_ignore_case(std::string_view lhs, std::string_view rhs) noexcept
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char l, char r) {
+      return (l >= 'a' && l <= 'z' ? static_cast<char>(l - ('a' - 'A')) : l) == r;
+    });
+  }
+
+  void
+  parse(std::string_view text, std::size_t offset)
+  {
+    auto const size = text.size();
+    while (!text.empty()) {
+      char const c = text.front();
+      auto const position = offset + size - text.size();
+      if (detail::is_space(c)) {
+        text.remove_prefix(1);
+      } else if (detail::is_alpha(c)) {
+        auto const length = static_cast<std::size_t>(
+          std::find_if_not(text.begin(), text.end(), detail::is_alpha) - text.begin());
+        word(text.substr(0, length), position);
+        text.remove_prefix(length);
+      } else if (c == '(') {
+        if (state_ == state::keyword) {
+          throw detail::parse_error("missing geometry type", position);
+        }
+        state_ = state::coordinates;
+        ++depth_;
+        text.remove_prefix(1);
+      } else if (c == ')' || c == ',') {
+        if (state_ != state::coordinates || count_ != 0) {
+          throw detail::parse_error("incomplete coordinate", position);
+        }
+        if (c == ')') {
+          has_previous_ = false;
+          if (--depth_ == 0) {
+            state_ = state::keyword;
+          }
+        }
+        text.remove_prefix(1);
+      } else {
+        if (state_ != state::coordinates || count_ == coords_.size()) {
+          throw detail::parse_error("unexpected number", position);
+        }
+        coords_[count_++] = detail::consume_number<value_type>(text, position);
+        if (count_ == coords_.size()) {
+          vertex();
+        }
+      }
+    }
+  }
+
+  void
+  word(std::string_view token, std::size_t position)
+  {
+    constexpr bool is_3d = traits::dimension_v<Point> == 3;
+
+    if (state_ == state::keyword) {
+      if (!equals_ignore_case(token, "LINESTRING") && !equals_ignore_case(token, "POLYGON")
+          && !equals_ignore_case(token, "MULTILINESTRING") && !equals_ignore_case(token, "MULTIPOLYGON")) {
+        throw detail::parse_error("unsupported geometry type", position);
+      }
+      state_ = state::dimension;
+    } else if (state_ == state::dimension && equals_ignore_case(token, "Z") && is_3d) {
+      /* explicit dimension, nothing to do */
+    } else if (state_ == state::dimension && equals_ignore_case(token, "EMPTY")) {
+      state_ = state::keyword;
+    } else {
+      throw detail::parse_error("unexpected word", position);
+    }
+  }
+
+  void
+  vertex()
+  {
+    Point point;
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (..., set<Is>(point, coords_[Is]));
+    }(std::make_index_sequence<traits::dimension_v<Point>>{});
+    count_ = 0;
+
+    if (has_previous_) {
+      sink_(Line<Point>(previous_, point));
+    }
+    previous_ = point;
+    has_previous_ = true;
+  }
+
+  Sink sink_;
+  detail::chunk_carry<> carry_;
+  std::array<value_type, traits::dimension_v<Point>> coords_{};
+  std::size_t count_{};
+  std::size_t depth_{};
+  state state_{state::keyword};
+  bool has_previous_{};
+  Point previous_{};
+};
+
+/***************************** drivers ********************************/
+
+inline constexpr std::size_t parse_chunk_size = std::size_t{1} << 16;
+
+template <typename Parser>
+void
+feed(Parser & parser, std::istream & in)
+{
+  std::array<char, parse_chunk_size> buffer;
+  while (in) {
+    in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    parser.feed(std::string_view(buffer.data(), static_cast<std::size_t>(in.gcount())));
+  }
+}
+
+/* reads until end of file, input may exceed the available memory */
+template <typename Parser>
+void
+feed(Parser & parser, int fd)
+{
+  std::array<char, parse_chunk_size> buffer;
+  for (;;) {
+#if defined(_WIN32)
+    auto const count = ::_read(fd, buffer.data(), static_cast<unsigned>(buffer.size()));
+#else
+    auto const count = ::read(fd, buffer.data(), buffer.size());
+#endif
+    if (count < 0) {
+      throw std::runtime_error("unable to read geometry input");
+    }
+    if (count == 0) {
+      return;
+    }
+    parser.feed(std::string_view(buffer.data(), static_cast<std::size_t>(count)));
+  }
+}
+
+/* Parses a complete input, which is either text, an std::istream or a file
+ * descriptor, and returns the sink. */
+template <concepts::point Point, typename Sink, typename Input>
+Sink
+parse_svg_path(Input && input, Sink sink)
+{
+  SvgPathParser<Point, Sink &> parser(sink);
+  if constexpr (std::is_convertible_v<Input, std::string_view>) {
+    parser.feed(std::string_view(input));
+  } else {
+    feed(parser, input);
+  }
+  parser.finish();
+  return sink;
+}
+
+template <concepts::point Point, typename Sink, typename Input>
+Sink
+parse_wkt(Input && input, Sink sink)
+{
+  WktParser<Point, Sink &> parser(sink);
+  if constexpr (std::is_convertible_v<Input, std::string_view>) {
+    parser.feed(std::string_view(input));
+  } else {
+    feed(parser, input);
+  }
+  parser.finish();
+  return sink;
+}
+
+} // namespace geo::io
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef GEO_POINT_HPP
 #define GEO_POINT_HPP
 
+#include <array>
+#include <concepts>
+#include <cstddef>
+
 #include "traits.hpp"
 
 namespace geo {
@@ -32,8 +36,47 @@ struct Vector3x : public Mixins...
   T z{};
 };
 
+/* Any dimension, components in an array aligned to Align bytes. The array
+ * is padded to a multiple of the alignment with lanes that stay zero, so
+ * VectorNx<double, 3, 32> fills exactly one 256 bit register and the
+ * algebra overloads can run over all lanes at once. */
+template <concepts::arithmetic T, std::size_t N, std::size_t Align = alignof(T)>
+requires (N > 0) && (Align >= alignof(T)) && ((Align & (Align - 1)) == 0)
+struct VectorNx
+{
+  static constexpr std::size_t dimension = N;
+  static constexpr std::size_t lanes = (N * sizeof(T) + Align - 1) / Align * Align / sizeof(T);
+
+  constexpr VectorNx() = default;
+
+  template <std::convertible_to<T>... Ts>
+  requires (sizeof...(Ts) == N)
+  constexpr VectorNx(Ts const &... values) noexcept
+  {
+    std::size_t i = 0;
+    (..., (data[i++] = values));
+  }
+
+  [[nodiscard]] constexpr T &
+  operator[](std::size_t i) noexcept
+  {
+    return data[i];
+  }
+
+  [[nodiscard]] constexpr T const &
+  operator[](std::size_t i) const noexcept
+  {
+    return data[i];
+  }
+
+  alignas(Align) std::array<T, lanes> data{};
+};
+
 using Vector2d = Vector2x<double>;
 using Vector3d = Vector3x<double>;
+using PaddedVector3d = VectorNx<double, 3, 32>;
+using Vector4d = VectorNx<double, 4, 32>;
+using Vector6d = VectorNx<double, 6, 16>;
 
 /***************************** adaptors ********************************/
 
@@ -110,6 +153,32 @@ struct access<Vector3x<T, Mixins...>, 2>
   static constexpr void set(Vector3x<T, Mixins...> & vec, T z) { vec.z = z; }
 };
 
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+struct tag<VectorNx<T, N, Align>>
+{
+  using type = point_tag;
+};
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+struct value_type<VectorNx<T, N, Align>>
+{
+  using type = T;
+};
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align>
+struct dimension<VectorNx<T, N, Align>>
+{
+  static constexpr std::size_t value = N;
+};
+
+template <concepts::arithmetic T, std::size_t N, std::size_t Align, std::size_t I>
+requires (I < N)
+struct access<VectorNx<T, N, Align>, I>
+{
+  static constexpr T get(VectorNx<T, N, Align> const & vec) { return vec.data[I]; }
+  static constexpr void set(VectorNx<T, N, Align> & vec, T value) { vec.data[I] = value; }
+};
+
 } // namespace traits
 
 } // namespace geo
@@ -0,0 +1,137 @@
+#ifndef GEO_POINT_CLOUD_HPP
+#define GEO_POINT_CLOUD_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "convex_hull.hpp"
+#include "detail/detail_point_cloud.hpp"
+#include "execution.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+template <typename Range>
+concept point_cloud = point_range<Range, 2> || point_range<Range, 3>;
+
+} // namespace concepts
+
+/***************************** voxel downsampling ********************************/
+
+/* Thins out a point cloud to the centroid of the points in each cubic voxel
+ * of side voxel_size, the voxels aligned to the lower corner of the bounding
+ * box. Writes the centroids to out in Morton order of their voxels, which
+ * keeps neighbours close in memory. The points are keyed by voxel and radix
+ * sorted, no per-voxel objects are built; the parallel version keys, sorts
+ * and averages concurrently. Throws std::invalid_argument for a voxel_size
+ * that is not positive or splits an axis into more than 2^21 voxels in 3D,
+ * 2^32 in 2D. */
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+Out
+voxel_downsample(execution::sequenced_policy, Range const & points,
+                 traits::value_type_t<std::ranges::range_value_t<Range>> voxel_size, Out out)
+{
+  return std::ranges::copy(detail::voxel_downsample<false>(points, voxel_size), out).out;
+}
+
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+Out
+voxel_downsample(execution::parallel_policy, Range const & points,
+                 traits::value_type_t<std::ranges::range_value_t<Range>> voxel_size, Out out)
+{
+  return std::ranges::copy(detail::voxel_downsample<true>(points, voxel_size), out).out;
+}
+
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+Out
+voxel_downsample(Range const & points, traits::value_type_t<std::ranges::range_value_t<Range>> voxel_size, Out out)
+{
+  return voxel_downsample(execution::seq, points, voxel_size, out);
+}
+
+/***************************** welding ********************************/
+
+/* Merges points closer than epsilon. In input order, each point joins the
+ * earliest kept point within epsilon or is kept itself, so kept points
+ * are more than epsilon apart. Writes the kept points to out and returns,
+ * for every input point, the position of its kept point in that output, to
+ * remap indices that refer to the points. A hash grid of cells of side
+ * 2 epsilon limits the search to 2^dim cells. The parallel version finds
+ * the cells concurrently; the merge itself depends on the order and runs
+ * in one pass. Throws std::invalid_argument for a non-positive epsilon. */
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+std::vector<std::size_t>
+weld(execution::sequenced_policy, Range const & points, traits::value_type_t<std::ranges::range_value_t<Range>> epsilon,
+     Out out)
+{
+  auto [kept, remap] = detail::weld<false>(points, epsilon);
+  auto const first = std::ranges::begin(points);
+  for (std::size_t const i : kept) {
+    *out = first[static_cast<std::ranges::range_difference_t<Range>>(i)];
+    ++out;
+  }
+  return std::move(remap);
+}
+
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+std::vector<std::size_t>
+weld(execution::parallel_policy, Range const & points, traits::value_type_t<std::ranges::range_value_t<Range>> epsilon,
+     Out out)
+{
+  auto [kept, remap] = detail::weld<true>(points, epsilon);
+  auto const first = std::ranges::begin(points);
+  for (std::size_t const i : kept) {
+    *out = first[static_cast<std::ranges::range_difference_t<Range>>(i)];
+    ++out;
+  }
+  return std::move(remap);
+}
+
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+std::vector<std::size_t>
+weld(Range const & points, traits::value_type_t<std::ranges::range_value_t<Range>> epsilon, Out out)
+{
+  return weld(execution::seq, points, epsilon, out);
+}
+
+/***************************** normals ********************************/
+
+/* Unit normal of each point, written to out in input order: the direction
+ * of least variance of its k nearest neighbours, the point included, from
+ * the eigenvectors of their covariance. The sign is arbitrary; orient the
+ * normals towards the scanner where that is known. The neighbours are found
+ * in a hashed grid of about k / 2 points per occupied cell. The parallel version
+ * handles the points concurrently. Throws std::invalid_argument for k less
+ * than the dimension. */
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+Out
+estimate_normals(execution::sequenced_policy, Range const & points, std::size_t k, Out out)
+{
+  return std::ranges::copy(detail::estimate_normals<false>(points, k), out).out;
+}
+
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+Out
+estimate_normals(execution::parallel_policy, Range const & points, std::size_t k, Out out)
+{
+  return std::ranges::copy(detail::estimate_normals<true>(points, k), out).out;
+}
+
+template <concepts::point_cloud Range, std::weakly_incrementable Out>
+Out
+estimate_normals(Range const & points, std::size_t k, Out out)
+{
+  return estimate_normals(execution::seq, points, k, out);
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef GEO_PREDICATES_HPP
+#define GEO_PREDICATES_HPP
+
+#include <array>
+#include <concepts>
+
+#include "detail/detail_predicates.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** predicates ********************************/
+
+/* Geometric predicates with exact results. A floating point filter decides
+ * almost all inputs at the cost of the naive formula, only nearly degenerate
+ * configurations fall back to exact expansion arithmetic. Exactness assumes
+ * that no intermediate product overflows or underflows. */
+
+/* 1 if a, b, c turn counter-clockwise, -1 if clockwise, 0 if collinear */
+template <concepts::point Point>
+requires concepts::dimension_equals<Point, 2> && std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr int
+orientation(Point const & a, Point const & b, Point const & c) noexcept
+{
+  return detail::orientation(get<0>(a), get<1>(a), get<0>(b), get<1>(b), get<0>(c), get<1>(c));
+}
+
+/* 1 if d lies on the side of the plane through a, b, c that the normal
+ * (b - a) x (c - a) points to, -1 if on the other side, 0 if coplanar */
+template <concepts::point Point>
+requires concepts::dimension_equals<Point, 3> && std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr int
+orientation(Point const & a, Point const & b, Point const & c, Point const & d) noexcept
+{
+  using T = traits::value_type_t<Point>;
+
+  auto const coords = [](Point const & p) { return std::array<T, 3>{get<0>(p), get<1>(p), get<2>(p)}; };
+  return detail::orientation(coords(a), coords(b), coords(c), coords(d));
+}
+
+/* 1 if d lies inside the circle through the counter-clockwise a, b, c, -1
+ * if outside, 0 if on it; the signs swap for clockwise a, b, c */
+template <concepts::point Point>
+requires concepts::dimension_equals<Point, 2> && std::floating_point<traits::value_type_t<Point>>
+[[nodiscard]] constexpr int
+incircle(Point const & a, Point const & b, Point const & c, Point const & d) noexcept
+{
+  using T = traits::value_type_t<Point>;
+
+  auto const coords = [](Point const & p) { return std::array<T, 2>{get<0>(p), get<1>(p)}; };
+  return detail::incircle(coords(a), coords(b), coords(c), coords(d));
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,353 @@
+#ifndef GEO_QUATERNION_HPP
+#define GEO_QUATERNION_HPP
+
+#include <array>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "algebra.hpp"
+#include "bezier.hpp"
+#include "bezier_batch.hpp"
+#include "detail/detail_execution.hpp"
+#include "detail/detail_quaternion.hpp"
+#include "execution.hpp"
+#include "fast_math.hpp"
+#include "math.hpp"
+#include "traits.hpp"
+#include "transform.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Orientation in 3D as the quaternion w + xi + yj + zk. Rotations are
+ * meant to be unit quaternions, q and -q are the same rotation. Composition
+ * with operator* applies the right hand side first, as for Affine, and like
+ * every other operation here is constexpr. */
+template <std::floating_point T>
+struct Quaternion
+{
+  using value_type = T;
+
+  constexpr Quaternion() noexcept = default;
+
+  constexpr Quaternion(T w, T x, T y, T z) noexcept
+      : w(w), x(x), y(y), z(z)
+  {}
+
+  [[nodiscard]] static constexpr Quaternion
+  identity() noexcept
+  {
+    return {};
+  }
+
+  /* right-handed rotation about an axis through the origin */
+  template <concepts::point Point>
+  requires concepts::dimension_equals<Point, 3> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] static constexpr Quaternion
+  rotation(Point const & axis, T radians) noexcept
+  {
+    T const scale = geo::sin(radians / 2) / norm(axis);
+    return {geo::cos(radians / 2), get<0>(axis) * scale, get<1>(axis) * scale, get<2>(axis) * scale};
+  }
+
+  /* rotation of the linear part of xf, which has to be orthonormal with
+   * determinant 1; pivots on the largest diagonal term (Shepperd) */
+  [[nodiscard]] static constexpr Quaternion
+  from_matrix(Affine<T, 3> const & xf) noexcept
+  {
+    auto const & m = xf.matrix;
+    T const trace = m[0][0] + m[1][1] + m[2][2];
+    if (trace > T{}) {
+      T const s = 2 * geo::sqrt(T{1} + trace);
+      return {s / 4, (m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s, (m[1][0] - m[0][1]) / s};
+    }
+    if (m[0][0] >= m[1][1] && m[0][0] >= m[2][2]) {
+      T const s = 2 * geo::sqrt(T{1} + m[0][0] - m[1][1] - m[2][2]);
+      return {(m[2][1] - m[1][2]) / s, s / 4, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s};
+    }
+    if (m[1][1] >= m[2][2]) {
+      T const s = 2 * geo::sqrt(T{1} + m[1][1] - m[0][0] - m[2][2]);
+      return {(m[0][2] - m[2][0]) / s, (m[0][1] + m[1][0]) / s, s / 4, (m[1][2] + m[2][1]) / s};
+    }
+    T const s = 2 * geo::sqrt(T{1} + m[2][2] - m[0][0] - m[1][1]);
+    return {(m[1][0] - m[0][1]) / s, (m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, s / 4};
+  }
+
+  [[nodiscard]] constexpr Affine<T, 3>
+  to_matrix() const noexcept
+  {
+    auto const m = detail::rotation_matrix(w, x, y, z);
+    Affine<T, 3> retval;
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        retval.matrix[i][j] = m[i][j];
+      }
+    }
+    return retval;
+  }
+
+  [[nodiscard]] friend constexpr bool
+  operator==(Quaternion const &, Quaternion const &) noexcept = default;
+
+  [[nodiscard]] friend constexpr Quaternion
+  operator-(Quaternion const & q) noexcept
+  {
+    return {-q.w, -q.x, -q.y, -q.z};
+  }
+
+  /* Hamilton product */
+  [[nodiscard]] friend constexpr Quaternion
+  operator*(Quaternion const & lhs, Quaternion const & rhs) noexcept
+  {
+    return {
+      lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
+      lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+      lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+      lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w
+    };
+  }
+
+  T w{1};
+  T x{};
+  T y{};
+  T z{};
+};
+
+using Quaterniond = Quaternion<double>;
+using Quaternionf = Quaternion<float>;
+
+/***************************** concepts ********************************/
+
+namespace traits {
+
+template <typename T>
+struct is_quaternion : std::false_type {};
+
+template <std::floating_point T>
+struct is_quaternion<Quaternion<T>> : std::true_type {};
+
+} // namespace traits
+
+namespace concepts {
+
+template <typename T>
+concept quaternion = traits::is_quaternion<T>::value;
+
+template <typename Quaternion, typename Point>
+concept rotates_point =
+  quaternion<Quaternion>
+  && point<Point>
+  && dimension_equals<Point, 3>
+  && value_type_equals<Point, typename Quaternion::value_type>;
+
+} // namespace concepts
+
+/***************************** algorithms ********************************/
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+dot_product(Quaternion<T> const & lhs, Quaternion<T> const & rhs) noexcept
+{
+  return lhs.w * rhs.w + lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr T
+norm(Quaternion<T> const & q) noexcept
+{
+  return geo::sqrt(dot_product(q, q));
+}
+
+template <std::floating_point T, concepts::math_policy Policy = policy::exact>
+[[nodiscard]] constexpr Quaternion<T>
+normalize(Quaternion<T> const & q, Policy policy = {}) noexcept
+{
+  T const scale = rsqrt(dot_product(q, q), policy);
+  return {q.w * scale, q.x * scale, q.y * scale, q.z * scale};
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr Quaternion<T>
+conjugate(Quaternion<T> const & q) noexcept
+{
+  return {q.w, -q.x, -q.y, -q.z};
+}
+
+/* the conjugate for unit quaternions */
+template <std::floating_point T>
+[[nodiscard]] constexpr Quaternion<T>
+inverse(Quaternion<T> const & q) noexcept
+{
+  T const scale = T{1} / dot_product(q, q);
+  return {q.w * scale, -q.x * scale, -q.y * scale, -q.z * scale};
+}
+
+/* Normalized linear interpolation along the shorter arc. Cheaper than slerp
+ * and with the same path, but not at constant angular velocity. */
+template <std::floating_point T>
+[[nodiscard]] constexpr Quaternion<T>
+nlerp(Quaternion<T> const & from, Quaternion<T> const & to, T t) noexcept
+{
+  T const a = T{1} - t;
+  T const b = dot_product(from, to) < T{} ? -t : t;
+  return normalize(Quaternion<T>(
+    a * from.w + b * to.w, a * from.x + b * to.x, a * from.y + b * to.y, a * from.z + b * to.z));
+}
+
+/* spherical linear interpolation of unit quaternions along the shorter arc,
+ * at constant angular velocity */
+template <std::floating_point T>
+[[nodiscard]] constexpr Quaternion<T>
+slerp(Quaternion<T> const & from, Quaternion<T> const & to, T t) noexcept
+{
+  T const cos = dot_product(from, to);
+  auto const [a, b] = detail::slerp_weights(cos < T{} ? -cos : cos, t);
+  T const c = cos < T{} ? -b : b;
+  return normalize(Quaternion<T>(
+    a * from.w + c * to.w, a * from.x + c * to.x, a * from.y + c * to.y, a * from.z + c * to.z));
+}
+
+/* Slerps pairs of keyframes, as the orientations of many objects between
+ * two frames, at the same t and writes the results to out. */
+template <std::ranges::input_range From, std::ranges::input_range To, std::weakly_incrementable Out>
+requires concepts::quaternion<std::ranges::range_value_t<From>>
+      && std::same_as<std::ranges::range_value_t<From>, std::ranges::range_value_t<To>>
+Out
+slerp(From && from, To && to, typename std::ranges::range_value_t<From>::value_type t, Out out)
+{
+  if constexpr (std::ranges::sized_range<From> && std::ranges::sized_range<To>) {
+    if (std::ranges::size(from) != std::ranges::size(to)) {
+      throw std::invalid_argument("keyframe ranges differ in size");
+    }
+  }
+  auto it = std::ranges::begin(to);
+  for (auto const & q : from) {
+    *out = slerp(q, *it, t);
+    ++out;
+    ++it;
+  }
+  return out;
+}
+
+/* rotation by a unit quaternion as p + w t + (x, y, z) x t with
+ * t = 2 (x, y, z) x p */
+template <std::floating_point T, concepts::point Point>
+requires concepts::rotates_point<Quaternion<T>, Point>
+[[nodiscard]] constexpr Point
+rotate(Quaternion<T> const & q, Point const & point) noexcept
+{
+  T const px = get<0>(point), py = get<1>(point), pz = get<2>(point);
+  T const tx = 2 * (q.y * pz - q.z * py);
+  T const ty = 2 * (q.z * px - q.x * pz);
+  T const tz = 2 * (q.x * py - q.y * px);
+
+  Point retval;
+  set<0>(retval, px + q.w * tx + (q.y * tz - q.z * ty));
+  set<1>(retval, py + q.w * ty + (q.z * tx - q.x * tz));
+  set<2>(retval, pz + q.w * tz + (q.x * ty - q.y * tx));
+  return retval;
+}
+
+template <std::floating_point T, concepts::bezier Bezier>
+requires concepts::rotates_point<Quaternion<T>, detail::ctrl_point_t<Bezier>>
+[[nodiscard]] Bezier
+rotate(Quaternion<T> const & q, Bezier const & bezier)
+{
+  return transform(q.to_matrix(), bezier);
+}
+
+/* AoS bulk rotation of points or Beziers. Points go through the rotation
+ * matrix, computed once, which takes half the multiplications of rotating
+ * each by the quaternion. */
+template <std::floating_point T, std::ranges::input_range Range, std::weakly_incrementable Out>
+requires requires (Quaternion<T> const & q, std::ranges::range_reference_t<Range> geo) {
+  rotate(q, geo);
+}
+constexpr Out
+rotate(Quaternion<T> const & q, Range && range, Out out)
+{
+  using Geo = std::ranges::range_value_t<Range>;
+
+  if constexpr (concepts::point<Geo>) {
+    auto const m = detail::rotation_matrix(q.w, q.x, q.y, q.z);
+    for (auto const & point : range) {
+      auto const p = detail::rotate_coordinates(m, get<0>(point), get<1>(point), get<2>(point));
+      Geo retval;
+      set<0>(retval, p[0]);
+      set<1>(retval, p[1]);
+      set<2>(retval, p[2]);
+      *out = retval;
+      ++out;
+    }
+    return out;
+  } else {
+    return transform(q.to_matrix(), range, out);
+  }
+}
+
+template <std::floating_point T, std::ranges::input_range Range, std::weakly_incrementable Out>
+requires requires (Quaternion<T> const & q, std::ranges::range_reference_t<Range> geo) {
+  rotate(q, geo);
+}
+constexpr Out
+rotate(execution::sequenced_policy, Quaternion<T> const & q, Range && range, Out out)
+{
+  return rotate(q, range, out);
+}
+
+/* rotates chunks of the range concurrently, out has to be random access */
+template <std::floating_point T, std::ranges::random_access_range Range, std::random_access_iterator Out>
+requires std::ranges::sized_range<Range>
+      && requires (Quaternion<T> const & q, std::ranges::range_reference_t<Range> geo) {
+  rotate(q, geo);
+}
+Out
+rotate(execution::parallel_policy, Quaternion<T> const & q, Range && range, Out out)
+{
+  auto const first = std::ranges::begin(range);
+  auto const size = std::ranges::size(range);
+  detail::parallel_for(size, [&](std::size_t begin, std::size_t end) {
+    using difference = std::iter_difference_t<Out>;
+    rotate(q, std::ranges::subrange(first + static_cast<difference>(begin), first + static_cast<difference>(end)),
+           out + static_cast<difference>(begin));
+  });
+  return out + static_cast<std::iter_difference_t<Out>>(size);
+}
+
+/* SoA bulk rotation, in[k][j] is component k of point j, in the layout of
+ * transform. The loop is a 3 x 3 matrix product per point without branches,
+ * which compilers vectorize. in and out may alias, every span must hold at
+ * least as many elements as in[0]. */
+template <std::floating_point T>
+constexpr void
+rotate(
+    Quaternion<T> const & q,
+    std::array<std::span<T const>, 3> const & in,
+    std::array<std::span<T>, 3> const & out) noexcept
+{
+  detail::rotate_lanes(
+    detail::rotation_matrix(q.w, q.x, q.y, q.z),
+    {in[0].data(), in[1].data(), in[2].data()},
+    {out[0].data(), out[1].data(), out[2].data()},
+    in[0].size());
+}
+
+/* rotates every control point of the batch in place */
+template <std::size_t Degree, std::floating_point T>
+void
+rotate(Quaternion<T> const & q, BezierBatch<Degree, T, 3> & batch) noexcept
+{
+  for (std::size_t i = 0; i <= Degree; ++i) {
+    std::array<std::span<T>, 3> const out{batch.lane(i, 0), batch.lane(i, 1), batch.lane(i, 2)};
+    rotate(q, {out[0], out[1], out[2]}, out);
+  }
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,635 @@
+#ifndef GEO_RAY_HPP
+#define GEO_RAY_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+
+#include "bezier.hpp"
+#include "bvh.hpp"
+#include "circle.hpp"
+#include "detail/detail_bezier.hpp"
+#include "detail/detail_intersect.hpp"
+#include "detail/detail_ray.hpp"
+#include "detail/detail_spatial_sort.hpp"
+#include "line.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Half-line origin + t * direction, t >= 0. Hits are reported as t, in
+ * units of the length of direction, which needs no normalizing but must not
+ * be zero. */
+template <concepts::point Point>
+requires std::floating_point<traits::value_type_t<Point>>
+struct Ray
+{
+  constexpr Ray() = default;
+  constexpr Ray(Point const & origin, Point const & direction)
+      : origin(origin), direction(direction)
+  {}
+
+  Point origin{};
+  Point direction{};
+};
+
+/* nearest hit of a ray cast into a DynamicBvh, object is DynamicBvh::none
+ * for a miss */
+template <std::floating_point T>
+struct RayHit
+{
+  T t = detail::no_hit<T>;
+  std::size_t object = std::numeric_limits<std::size_t>::max();
+};
+
+/***************************** adaptors ********************************/
+
+namespace traits {
+
+template <concepts::point Point>
+struct tag<Ray<Point>>
+{
+  using type = ray_tag;
+};
+
+template <concepts::point Point>
+struct point_type<Ray<Point>>
+{
+  using type = Point;
+};
+
+template <concepts::point Point>
+struct value_type<Ray<Point>>
+{
+  using type = value_type_t<Point>;
+};
+
+} // namespace traits
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+template <std::size_t N>
+concept packet_size = (N == 4 || N == 8 || N == 16);
+
+/* Lines and Beziers are hit in 2D only; in 3D a ray meets a curve with
+ * probability zero. Circles are spheres in 3D. */
+template <typename Object>
+concept raycast_circle = circle<Object> && std::floating_point<traits::value_type_t<Object>>;
+
+template <typename Object>
+concept raycast_line =
+  line<Object>
+  && std::floating_point<traits::value_type_t<detail::line_point_t<Object>>>
+  && traits::dimension_v<detail::line_point_t<Object>> == 2;
+
+template <typename Object>
+concept raycast_bezier =
+  bezier<Object>
+  && std::floating_point<traits::value_type_t<detail::ctrl_point_t<Object>>>
+  && traits::dimension_v<detail::ctrl_point_t<Object>> == 2;
+
+} // namespace concepts
+
+/***************************** packets ********************************/
+
+/* Packets hold N rays or N objects of one kind in SoA form, a lane per ray
+ * or object, for the kernels below to process N at a time: N rays against
+ * one object, as a bundle of coherent rays from a camera or a light, or one
+ * ray against N objects. Packets are filled up to N with push_back; the
+ * lanes beyond size() are never hit. */
+template <concepts::point Point, std::size_t N>
+requires std::floating_point<traits::value_type_t<Point>> && concepts::packet_size<N>
+class RayPacket
+{
+public:
+  using point_type = Point;
+  using value_type = traits::value_type_t<Point>;
+  using lanes_type = detail::lanes_t<value_type, traits::dimension_v<Point>, N>;
+
+  RayPacket() = default;
+
+  template <std::ranges::input_range Range>
+  requires std::convertible_to<std::ranges::range_reference_t<Range>, Ray<Point>>
+  explicit RayPacket(Range && rays)
+  {
+    for (Ray<Point> const & ray : rays) {
+      push_back(ray);
+    }
+  }
+
+  [[nodiscard]] static constexpr std::size_t
+  capacity() noexcept
+  {
+    return N;
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  void
+  push_back(Ray<Point> const & ray)
+  {
+    if (size_ == N) {
+      throw std::length_error("packet capacity exceeded");
+    }
+    auto const direction = detail::sort_position(ray.direction);
+    detail::set_lane(origin_, size_, detail::sort_position(ray.origin));
+    detail::set_lane(direction_, size_, direction);
+    for (std::size_t k = 0; k < direction.size(); ++k) {
+      inverse_[k][size_] = detail::inverse_direction(direction[k]);
+    }
+    ++size_;
+  }
+
+  void
+  clear() noexcept
+  {
+    size_ = 0;
+  }
+
+  [[nodiscard]] lanes_type const &
+  origin() const noexcept
+  {
+    return origin_;
+  }
+
+  [[nodiscard]] lanes_type const &
+  direction() const noexcept
+  {
+    return direction_;
+  }
+
+  /* 1 / direction, for slab tests */
+  [[nodiscard]] lanes_type const &
+  inverse() const noexcept
+  {
+    return inverse_;
+  }
+
+private:
+  lanes_type origin_{};
+  lanes_type direction_{};
+  lanes_type inverse_{};
+  std::size_t size_ = 0;
+};
+
+template <concepts::raycast_circle Circle, std::size_t N>
+requires concepts::packet_size<N>
+class CirclePacket
+{
+public:
+  using value_type = traits::value_type_t<Circle>;
+  using lanes_type = detail::lanes_t<value_type, traits::dimension_v<traits::point_type_t<Circle>>, N>;
+
+  [[nodiscard]] static constexpr std::size_t
+  capacity() noexcept
+  {
+    return N;
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  void
+  push_back(Circle const & circle)
+  {
+    if (size_ == N) {
+      throw std::length_error("packet capacity exceeded");
+    }
+    detail::set_lane(center_, size_, detail::sort_position(traits::access_center<Circle>::get(circle)));
+    radius_[size_] = traits::access_radius<Circle>::get(circle);
+    ++size_;
+  }
+
+  void
+  clear() noexcept
+  {
+    size_ = 0;
+  }
+
+  [[nodiscard]] lanes_type const &
+  center() const noexcept
+  {
+    return center_;
+  }
+
+  [[nodiscard]] std::array<value_type, N> const &
+  radius() const noexcept
+  {
+    return radius_;
+  }
+
+private:
+  lanes_type center_{};
+  std::array<value_type, N> radius_{};
+  std::size_t size_ = 0;
+};
+
+template <concepts::raycast_line Line, std::size_t N>
+requires concepts::packet_size<N>
+class LinePacket
+{
+public:
+  using value_type = traits::value_type_t<detail::line_point_t<Line>>;
+  using lanes_type = detail::lanes_t<value_type, 2, N>;
+
+  [[nodiscard]] static constexpr std::size_t
+  capacity() noexcept
+  {
+    return N;
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  void
+  push_back(Line const & line)
+  {
+    if (size_ == N) {
+      throw std::length_error("packet capacity exceeded");
+    }
+    detail::set_lane(start_, size_, detail::sort_position(line.start));
+    detail::set_lane(end_, size_, detail::sort_position(line.end));
+    ++size_;
+  }
+
+  void
+  clear() noexcept
+  {
+    size_ = 0;
+  }
+
+  [[nodiscard]] lanes_type const &
+  start() const noexcept
+  {
+    return start_;
+  }
+
+  [[nodiscard]] lanes_type const &
+  end() const noexcept
+  {
+    return end_;
+  }
+
+private:
+  lanes_type start_{};
+  lanes_type end_{};
+  std::size_t size_ = 0;
+};
+
+template <concepts::raycast_bezier Bezier, std::size_t N>
+requires concepts::packet_size<N>
+class BezierPacket
+{
+public:
+  static constexpr std::size_t degree = traits::degree_v<Bezier>;
+  using value_type = traits::value_type_t<detail::ctrl_point_t<Bezier>>;
+  using lanes_type = detail::bezier_lanes_t<degree, value_type, N>;
+
+  [[nodiscard]] static constexpr std::size_t
+  capacity() noexcept
+  {
+    return N;
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  void
+  push_back(Bezier const & bezier)
+  {
+    if (size_ == N) {
+      throw std::length_error("packet capacity exceeded");
+    }
+    auto const ctrls = detail::copy_ctrls(bezier);
+    for (std::size_t j = 0; j <= degree; ++j) {
+      detail::set_lane(ctrls_[j], size_, detail::sort_position(ctrls[j]));
+    }
+    ++size_;
+  }
+
+  void
+  clear() noexcept
+  {
+    size_ = 0;
+  }
+
+  [[nodiscard]] lanes_type const &
+  ctrls() const noexcept
+  {
+    return ctrls_;
+  }
+
+private:
+  lanes_type ctrls_{};
+  std::size_t size_ = 0;
+};
+
+/***************************** algorithms ********************************/
+
+namespace detail {
+
+/* accessors of the kernels in detail_ray.hpp for a ray or an object that
+ * is the same in every lane */
+template <typename Coordinates>
+[[nodiscard]] auto
+broadcast(Coordinates const & c) noexcept
+{
+  return [&c](std::size_t k, std::size_t) { return c[k]; };
+}
+
+template <typename Lanes>
+[[nodiscard]] auto
+lanes(Lanes const & l) noexcept
+{
+  return [&l](std::size_t k, std::size_t i) { return l[k][i]; };
+}
+
+/* misses for the lanes beyond count */
+template <typename T, std::size_t N>
+[[nodiscard]] std::array<T, N>
+mask_lanes(std::array<T, N> hits, std::size_t count) noexcept
+{
+  for (std::size_t i = count; i < N; ++i) {
+    hits[i] = no_hit<T>;
+  }
+  return hits;
+}
+
+template <concepts::raycast_bezier Bezier>
+[[nodiscard]] auto
+single_lane(Bezier const & bezier) noexcept
+{
+  using T = traits::value_type_t<ctrl_point_t<Bezier>>;
+  constexpr std::size_t degree = traits::degree_v<Bezier>;
+  auto const ctrls = copy_ctrls(bezier);
+  bezier_lanes_t<degree, T, 1> retval{};
+  for (std::size_t j = 0; j <= degree; ++j) {
+    set_lane(retval[j], 0, sort_position(ctrls[j]));
+  }
+  return retval;
+}
+
+template <typename T>
+[[nodiscard]] std::optional<T>
+optional_hit(T t) noexcept
+{
+  return t != no_hit<T> ? std::optional<T>(t) : std::nullopt;
+}
+
+} // namespace detail
+
+/* Nearest t >= 0 at which the ray meets the circle, sphere in 3D; from
+ * inside, where the ray leaves. */
+template <concepts::point Point, concepts::raycast_circle Circle>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<Circle>>
+      && concepts::same_dimension<Point, traits::point_type_t<Circle>>
+[[nodiscard]] std::optional<traits::value_type_t<Point>>
+raycast(Ray<Point> const & ray, Circle const & circle) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  auto const center = detail::sort_position(traits::access_center<Circle>::get(circle));
+  T const radius = traits::access_radius<Circle>::get(circle);
+  return detail::optional_hit(detail::circle_hits<T, traits::dimension_v<Point>, 1>(
+    detail::broadcast(detail::sort_position(ray.origin)), detail::broadcast(detail::sort_position(ray.direction)),
+    detail::broadcast(center), [radius](std::size_t) { return radius; })[0]);
+}
+
+/* Nearest t >= 0 at which the ray crosses the segment; rays parallel to it
+ * miss, even along it. */
+template <concepts::point Point, concepts::raycast_line Line>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<detail::line_point_t<Line>>>
+      && concepts::dimension_equals<Point, 2>
+[[nodiscard]] std::optional<traits::value_type_t<Point>>
+raycast(Ray<Point> const & ray, Line const & line) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  return detail::optional_hit(detail::segment_hits<T, 1>(
+    detail::broadcast(detail::sort_position(ray.origin)), detail::broadcast(detail::sort_position(ray.direction)),
+    detail::broadcast(detail::sort_position(line.start)), detail::broadcast(detail::sort_position(line.end)))[0]);
+}
+
+/* Nearest t >= 0 at which the ray meets the curve, up to about 2^-20 of the
+ * extent of the curve. The curve is halved while the box of a part's
+ * control points meets the ray before the nearest hit so far; flat parts are
+ * intersected as segments. */
+template <concepts::point Point, concepts::raycast_bezier Bezier>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<detail::ctrl_point_t<Bezier>>>
+      && concepts::dimension_equals<Point, 2>
+[[nodiscard]] std::optional<traits::value_type_t<Point>>
+raycast(Ray<Point> const & ray, Bezier const & bezier) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  auto const direction = detail::sort_position(ray.direction);
+  std::array<T, 2> const inverse{detail::inverse_direction(direction[0]), detail::inverse_direction(direction[1])};
+  return detail::optional_hit(detail::bezier_hits<traits::degree_v<Bezier>, T, 1>(
+    detail::broadcast(detail::sort_position(ray.origin)), detail::broadcast(direction), detail::broadcast(inverse),
+    detail::single_lane(bezier), 1)[0]);
+}
+
+/* Nearest hits of N rays against one object, inf for a miss and for the
+ * lanes beyond the size of the packet. Against a Bezier, the rays share the
+ * subdivision of the curve: a part is halved once for all rays that meet
+ * its box. */
+template <concepts::point Point, std::size_t N, concepts::raycast_circle Circle>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<Circle>>
+      && concepts::same_dimension<Point, traits::point_type_t<Circle>>
+[[nodiscard]] std::array<traits::value_type_t<Point>, N>
+raycast(RayPacket<Point, N> const & rays, Circle const & circle) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  auto const center = detail::sort_position(traits::access_center<Circle>::get(circle));
+  T const radius = traits::access_radius<Circle>::get(circle);
+  return detail::mask_lanes(detail::circle_hits<T, traits::dimension_v<Point>, N>(
+    detail::lanes(rays.origin()), detail::lanes(rays.direction()),
+    detail::broadcast(center), [radius](std::size_t) { return radius; }), rays.size());
+}
+
+template <concepts::point Point, std::size_t N, concepts::raycast_line Line>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<detail::line_point_t<Line>>>
+      && concepts::dimension_equals<Point, 2>
+[[nodiscard]] std::array<traits::value_type_t<Point>, N>
+raycast(RayPacket<Point, N> const & rays, Line const & line) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  return detail::mask_lanes(detail::segment_hits<T, N>(
+    detail::lanes(rays.origin()), detail::lanes(rays.direction()),
+    detail::broadcast(detail::sort_position(line.start)), detail::broadcast(detail::sort_position(line.end))),
+    rays.size());
+}
+
+template <concepts::point Point, std::size_t N, concepts::raycast_bezier Bezier>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<detail::ctrl_point_t<Bezier>>>
+      && concepts::dimension_equals<Point, 2>
+[[nodiscard]] std::array<traits::value_type_t<Point>, N>
+raycast(RayPacket<Point, N> const & rays, Bezier const & bezier) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  return detail::bezier_hits<traits::degree_v<Bezier>, T, N>(
+    detail::lanes(rays.origin()), detail::lanes(rays.direction()), detail::lanes(rays.inverse()),
+    detail::single_lane(bezier), detail::first_lanes(rays.size()));
+}
+
+/* Hits of one ray against the N objects of a packet, inf for a miss and for
+ * the lanes beyond the size of the packet. Of Beziers, the control boxes are
+ * tested at once and only the curves whose box the ray meets are
+ * subdivided. */
+template <concepts::point Point, concepts::raycast_circle Circle, std::size_t N>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<Circle>>
+      && concepts::same_dimension<Point, traits::point_type_t<Circle>>
+[[nodiscard]] std::array<traits::value_type_t<Point>, N>
+raycast(Ray<Point> const & ray, CirclePacket<Circle, N> const & circles) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  auto const & radius = circles.radius();
+  return detail::mask_lanes(detail::circle_hits<T, traits::dimension_v<Point>, N>(
+    detail::broadcast(detail::sort_position(ray.origin)), detail::broadcast(detail::sort_position(ray.direction)),
+    detail::lanes(circles.center()), [&radius](std::size_t i) { return radius[i]; }), circles.size());
+}
+
+template <concepts::point Point, concepts::raycast_line Line, std::size_t N>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<detail::line_point_t<Line>>>
+      && concepts::dimension_equals<Point, 2>
+[[nodiscard]] std::array<traits::value_type_t<Point>, N>
+raycast(Ray<Point> const & ray, LinePacket<Line, N> const & lines) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  return detail::mask_lanes(detail::segment_hits<T, N>(
+    detail::broadcast(detail::sort_position(ray.origin)), detail::broadcast(detail::sort_position(ray.direction)),
+    detail::lanes(lines.start()), detail::lanes(lines.end())), lines.size());
+}
+
+template <concepts::point Point, concepts::raycast_bezier Bezier, std::size_t N>
+requires std::same_as<traits::value_type_t<Point>, traits::value_type_t<detail::ctrl_point_t<Bezier>>>
+      && concepts::dimension_equals<Point, 2>
+[[nodiscard]] std::array<traits::value_type_t<Point>, N>
+raycast(Ray<Point> const & ray, BezierPacket<Bezier, N> const & beziers) noexcept
+{
+  using T = traits::value_type_t<Point>;
+  auto const direction = detail::sort_position(ray.direction);
+  std::array<T, 2> const inverse{detail::inverse_direction(direction[0]), detail::inverse_direction(direction[1])};
+  return detail::bezier_lane_hits<BezierPacket<Bezier, N>::degree, T, N>(
+    detail::broadcast(detail::sort_position(ray.origin)), detail::broadcast(direction), detail::broadcast(inverse),
+    beziers.ctrls(), detail::first_lanes(beziers.size()));
+}
+
+/* Nearest object of a DynamicBvh that the ray hits. Nodes are skipped once
+ * their fat box lies beyond the nearest hit so far; the nodes are visited in
+ * a fixed order, not nearest first. */
+template <typename Object, concepts::point Point>
+requires std::same_as<Point, traits::point_type_t<typename DynamicBvh<Object>::box_type>>
+      && requires(Ray<Point> const & ray, Object const & object) { raycast(ray, object); }
+[[nodiscard]] RayHit<traits::value_type_t<Point>>
+raycast(DynamicBvh<Object> const & bvh, Ray<Point> const & ray)
+{
+  using T = traits::value_type_t<Point>;
+  using box_type = typename DynamicBvh<Object>::box_type;
+  auto const origin = detail::sort_position(ray.origin);
+  auto const direction = detail::sort_position(ray.direction);
+  std::array<T, traits::dimension_v<Point>> inverse{};
+  for (std::size_t k = 0; k < inverse.size(); ++k) {
+    inverse[k] = detail::inverse_direction(direction[k]);
+  }
+  RayHit<T> retval;
+  std::array<T, 1> best{detail::no_hit<T>};
+  bvh.traverse(
+    [&](box_type const & box) {
+      return detail::slab_mask<T, traits::dimension_v<Point>, 1>(
+        detail::broadcast(origin), detail::broadcast(inverse),
+        detail::broadcast(detail::sort_position(box.lower)), detail::broadcast(detail::sort_position(box.upper)), best) != 0;
+    },
+    [&](std::size_t h) {
+      if (auto const t = raycast(ray, bvh[h]); t && *t < best[0]) {
+        best[0] = *t;
+        retval = {*t, h};
+      }
+    });
+  return retval;
+}
+
+/* Nearest objects of a DynamicBvh that the rays of a packet hit. The rays
+ * traverse the tree together, a node is visited once for all rays whose
+ * slab test against it passes, which pays off for coherent rays. */
+template <typename Object, concepts::point Point, std::size_t N>
+requires std::same_as<Point, traits::point_type_t<typename DynamicBvh<Object>::box_type>>
+      && requires(RayPacket<Point, N> const & rays, Object const & object) { raycast(rays, object); }
+[[nodiscard]] std::array<RayHit<traits::value_type_t<Point>>, N>
+raycast(DynamicBvh<Object> const & bvh, RayPacket<Point, N> const & rays)
+{
+  using T = traits::value_type_t<Point>;
+  using box_type = typename DynamicBvh<Object>::box_type;
+  std::uint32_t const active = detail::first_lanes(rays.size());
+  std::array<RayHit<T>, N> retval{};
+  std::array<T, N> best;
+  best.fill(detail::no_hit<T>);
+  if (active == 0) {
+    return retval;
+  }
+  bvh.traverse(
+    [&](box_type const & box) {
+      auto const lower = detail::sort_position(box.lower);
+      auto const upper = detail::sort_position(box.upper);
+      return (active & detail::slab_mask<T, traits::dimension_v<Point>, N>(
+        detail::lanes(rays.origin()), detail::lanes(rays.inverse()),
+        detail::broadcast(lower), detail::broadcast(upper), best)) != 0;
+    },
+    [&](std::size_t h) {
+      auto const hits = raycast(rays, bvh[h]);
+      for (std::size_t i = 0; i < N; ++i) {
+        if (hits[i] < best[i]) {
+          best[i] = hits[i];
+          retval[i] = {hits[i], h};
+        }
+      }
+    });
+  return retval;
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef GEO_SPATIAL_SORT_HPP
+#define GEO_SPATIAL_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "detail/detail_spatial_sort.hpp"
+#include "execution.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+/* objects with a position to sort by: points, circles by their center,
+ * lines and Beziers by the center of their bounding box */
+template <typename Object>
+concept spatially_sortable = requires (Object const & object) {
+  { detail::sort_position(object) };
+} && std::floating_point<typename detail::sort_position_t<Object>::value_type>
+  && (std::tuple_size_v<detail::sort_position_t<Object>> == 2 || std::tuple_size_v<detail::sort_position_t<Object>> == 3);
+
+template <typename Range>
+concept spatially_sortable_range =
+  std::ranges::random_access_range<Range>
+  && std::ranges::sized_range<Range>
+  && spatially_sortable<std::ranges::range_value_t<Range>>;
+
+} // namespace concepts
+
+/***************************** curve indices ********************************/
+
+/* Position of a cell along the Z-order (Morton) curve: the bits of the
+ * coordinates interleaved, x in the lowest bit. 2D cells have 32 bits a
+ * coordinate, 3D cells the low 21 bits. With BMI2 enabled at compile time
+ * (-mbmi2, -march=haswell or later, /arch:AVX2) each coordinate is spread
+ * by a single pdep, otherwise by shifts and masks. */
+[[nodiscard]] constexpr std::uint64_t
+morton_code(std::uint32_t x, std::uint32_t y) noexcept
+{
+  return detail::interleave<2>({x, y});
+}
+
+[[nodiscard]] constexpr std::uint64_t
+morton_code(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+{
+  return detail::interleave<3>({x, y, z});
+}
+
+/* Position of a cell along the Hilbert curve over the same grids. Unlike
+ * Morton order, consecutive cells are always neighbors. */
+[[nodiscard]] constexpr std::uint64_t
+hilbert_index(std::uint32_t x, std::uint32_t y) noexcept
+{
+  return detail::hilbert_key<2>({x, y});
+}
+
+[[nodiscard]] constexpr std::uint64_t
+hilbert_index(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+{
+  return detail::hilbert_key<3>({x, y, z});
+}
+
+/* Cells of points with unsigned integer coordinates, e.g. Vector2x<uint32_t> */
+template <concepts::point Point>
+requires std::unsigned_integral<traits::value_type_t<Point>>
+      && (traits::dimension_v<Point> == 2 || traits::dimension_v<Point> == 3)
+[[nodiscard]] constexpr std::uint64_t
+morton_code(Point const & cell) noexcept
+{
+  if constexpr (traits::dimension_v<Point> == 2) {
+    return morton_code(static_cast<std::uint32_t>(get<0>(cell)), static_cast<std::uint32_t>(get<1>(cell)));
+  } else {
+    return morton_code(static_cast<std::uint32_t>(get<0>(cell)), static_cast<std::uint32_t>(get<1>(cell)),
+                       static_cast<std::uint32_t>(get<2>(cell)));
+  }
+}
+
+template <concepts::point Point>
+requires std::unsigned_integral<traits::value_type_t<Point>>
+      && (traits::dimension_v<Point> == 2 || traits::dimension_v<Point> == 3)
+[[nodiscard]] constexpr std::uint64_t
+hilbert_index(Point const & cell) noexcept
+{
+  if constexpr (traits::dimension_v<Point> == 2) {
+    return hilbert_index(static_cast<std::uint32_t>(get<0>(cell)), static_cast<std::uint32_t>(get<1>(cell)));
+  } else {
+    return hilbert_index(static_cast<std::uint32_t>(get<0>(cell)), static_cast<std::uint32_t>(get<1>(cell)),
+                         static_cast<std::uint32_t>(get<2>(cell)));
+  }
+}
+
+/***************************** sorting ********************************/
+
+enum class space_filling_curve
+{
+  hilbert,
+  morton,
+};
+
+/* Indices of the objects in the order of their positions along a
+ * space-filling curve over the bounds of all positions. Objects close in the
+ * order are close in space, so traversals in that order touch memory and
+ * cache lines of neighbors together. Ties keep input order.
+ *
+ * Positions are quantized to the full key grid and sorted by an LSD radix
+ * sort that skips digits shared by all keys. The parallel version computes
+ * keys and runs the digit passes concurrently. */
+template <concepts::spatially_sortable_range Range>
+[[nodiscard]] std::vector<std::size_t>
+spatial_order(execution::sequenced_policy, Range const & objects, space_filling_curve curve = space_filling_curve::hilbert)
+{
+  return curve == space_filling_curve::hilbert ? detail::spatial_order<false, true>(objects)
+                                               : detail::spatial_order<false, false>(objects);
+}
+
+template <concepts::spatially_sortable_range Range>
+[[nodiscard]] std::vector<std::size_t>
+spatial_order(execution::parallel_policy, Range const & objects, space_filling_curve curve = space_filling_curve::hilbert)
+{
+  return curve == space_filling_curve::hilbert ? detail::spatial_order<true, true>(objects)
+                                               : detail::spatial_order<true, false>(objects);
+}
+
+template <concepts::spatially_sortable_range Range>
+[[nodiscard]] std::vector<std::size_t>
+spatial_order(Range const & objects, space_filling_curve curve = space_filling_curve::hilbert)
+{
+  return spatial_order(execution::seq, objects, curve);
+}
+
+/* Reorders the objects in place into spatial_order(). */
+template <concepts::execution_policy Policy, concepts::spatially_sortable_range Range>
+requires std::movable<std::ranges::range_value_t<Range>>
+void
+spatial_sort(Policy && policy, Range && objects, space_filling_curve curve = space_filling_curve::hilbert)
+{
+  auto const order = spatial_order(std::forward<Policy>(policy), objects, curve);
+
+  auto const first = std::ranges::begin(objects);
+  std::vector<std::ranges::range_value_t<Range>> sorted;
+  sorted.reserve(order.size());
+  for (std::size_t const i : order) {
+    sorted.push_back(std::move(first[static_cast<std::ranges::range_difference_t<Range>>(i)]));
+  }
+  std::ranges::move(sorted, first);
+}
+
+template <concepts::spatially_sortable_range Range>
+requires std::movable<std::ranges::range_value_t<Range>>
+void
+spatial_sort(Range && objects, space_filling_curve curve = space_filling_curve::hilbert)
+{
+  spatial_sort(execution::seq, std::forward<Range>(objects), curve);
+}
+
+} // namespace geo
+
+#endif
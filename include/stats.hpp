@@ -0,0 +1,101 @@
+#ifndef GEO_STATS_HPP
+#define GEO_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "detail/detail_stats.hpp"
+
+namespace geo::stats {
+
+/* Opt-in instrumentation. Compiled with GEO_ENABLE_STATS, every call of an
+ * instrumented entry point (see operation) bumps a counter of the calling
+ * thread, GEO_ENABLE_STATS_TIMERS also adds up the time spent in it. Calls
+ * from other entry points count as well, norm() counts a dot_product() and a
+ * sqrt(). Without GEO_ENABLE_STATS the hooks vanish and snapshots are
+ * empty. */
+
+struct snapshot
+{
+  std::array<std::uint64_t, operation_count> calls{};
+  std::array<std::uint64_t, operation_count> nanoseconds{};
+
+  [[nodiscard]] constexpr std::uint64_t
+  calls_of(operation op) const noexcept
+  {
+    return calls[static_cast<std::size_t>(op)];
+  }
+
+  [[nodiscard]] constexpr std::uint64_t
+  nanoseconds_of(operation op) const noexcept
+  {
+    return nanoseconds[static_cast<std::size_t>(op)];
+  }
+};
+
+/* totals over all threads, past and present */
+[[nodiscard]] inline snapshot
+take_snapshot()
+{
+  snapshot retval;
+#ifdef GEO_ENABLE_STATS
+  auto & registry = detail::stats_registry::instance();
+  std::lock_guard const lock(registry.mutex);
+  retval.calls = registry.retired_calls;
+  retval.nanoseconds = registry.retired_nanoseconds;
+  for (auto const * block : registry.blocks) {
+    for (std::size_t i = 0; i < operation_count; ++i) {
+      retval.calls[i] += block->calls[i].load(std::memory_order_relaxed);
+      retval.nanoseconds[i] += block->nanoseconds[i].load(std::memory_order_relaxed);
+    }
+  }
+#endif
+  return retval;
+}
+
+/* zeroes all counters; counts racing with the reset on other threads may
+ * survive it */
+inline void
+reset()
+{
+#ifdef GEO_ENABLE_STATS
+  auto & registry = detail::stats_registry::instance();
+  std::lock_guard const lock(registry.mutex);
+  registry.retired_calls = {};
+  registry.retired_nanoseconds = {};
+  for (auto * block : registry.blocks) {
+    for (std::size_t i = 0; i < operation_count; ++i) {
+      block->calls[i].store(0, std::memory_order_relaxed);
+      block->nanoseconds[i].store(0, std::memory_order_relaxed);
+    }
+  }
+#endif
+}
+
+/* {"dot_product": {"calls": 3, "nanoseconds": 0}, ...}, operations that were
+ * never called are left out */
+[[nodiscard]] inline std::string
+to_json(snapshot const & stats)
+{
+  std::string retval = "{";
+  for (std::size_t i = 0; i < operation_count; ++i) {
+    if (stats.calls[i] == 0) {
+      continue;
+    }
+    if (retval.size() > 1) {
+      retval += ", ";
+    }
+    retval += '"';
+    retval += operation_names[i];
+    retval += "\": {\"calls\": " + std::to_string(stats.calls[i])
+            + ", \"nanoseconds\": " + std::to_string(stats.nanoseconds[i]) + "}";
+  }
+  retval += "}";
+  return retval;
+}
+
+} // namespace geo::stats
+
+#endif
@@ -0,0 +1,521 @@
+#ifndef GEO_SWEEP_AND_PRUNE_HPP
+#define GEO_SWEEP_AND_PRUNE_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "box.hpp"
+#include "detail/detail_bvh.hpp"
+#include "detail/detail_execution.hpp"
+#include "detail/detail_sweep_and_prune.hpp"
+#include "execution.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** concepts ********************************/
+
+namespace concepts {
+
+template <typename Object>
+concept broad_phase_object =
+  geo_object<Object>
+  && std::floating_point<traits::value_type_t<detail::bounding_box_t<Object>>>
+  && (traits::dimension_v<traits::point_type_t<detail::bounding_box_t<Object>>> == 2
+      || traits::dimension_v<traits::point_type_t<detail::bounding_box_t<Object>>> == 3);
+
+} // namespace concepts
+
+/***************************** SweepAndPrune ********************************/
+
+/* Persistent sort and sweep broad phase over the bounding boxes of moving
+ * objects, for motion that is mostly coherent.
+ *
+ * The objects stay sorted by the lower end of their box on one axis, the
+ * sweep axis. Between frames they move little, so an insertion sort puts
+ * them back in order in about linear time. The sweep then tests each object
+ * against those that start before it ends on the sweep axis; the other axes
+ * are gathered into arrays in sweep order first, so that test is a
+ * branchless loop over contiguous memory that compilers vectorize.
+ *
+ * update() reports changes only: on_add(a, b) for pairs whose boxes started
+ * to overlap since the last update, on_remove(a, b) for pairs that stopped
+ * to or lost an object, both with a < b. Handles stay valid until removed
+ * and are reused, but not before the next update. Boxes are closed, touching
+ * boxes overlap.
+ *
+ * The sweep axis is best one along which the objects spread out and move
+ * least. */
+template <concepts::broad_phase_object Object>
+class SweepAndPrune
+{
+  using objects_type = detail::sap_objects<Object>;
+
+public:
+  using object_type = Object;
+  using box_type = typename objects_type::box_type;
+  using value_type = typename objects_type::value_type;
+  using handle = std::size_t;
+
+  static constexpr std::size_t dimension = objects_type::dimension;
+
+  SweepAndPrune() = default;
+
+  explicit SweepAndPrune(std::size_t axis)
+    : axis_(axis)
+  {
+    if (axis >= dimension) {
+      throw std::invalid_argument("sweep axis out of range");
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return objects_.size();
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return objects_.size() == 0;
+  }
+
+  [[nodiscard]] bool
+  contains(handle h) const noexcept
+  {
+    return objects_.contains(h);
+  }
+
+  [[nodiscard]] Object const &
+  operator[](handle h) const noexcept
+  {
+    return objects_[h];
+  }
+
+  /* for changes in place, seen by the next update() */
+  [[nodiscard]] Object &
+  operator[](handle h) noexcept
+  {
+    return objects_[h];
+  }
+
+  /* number of overlapping pairs as of the last update */
+  [[nodiscard]] std::size_t
+  pair_count() const noexcept
+  {
+    return pairs_.size();
+  }
+
+  handle
+  insert(Object object)
+  {
+    handle const h = objects_.insert(std::move(object));
+    order_.push_back({{}, h});
+    ++inserted_;
+    return h;
+  }
+
+  void
+  remove(handle h)
+  {
+    objects_.remove(h);
+  }
+
+  template <typename OnAdd, typename OnRemove>
+  requires std::invocable<OnAdd &, handle, handle> && std::invocable<OnRemove &, handle, handle>
+  void
+  update(execution::sequenced_policy, OnAdd && on_add, OnRemove && on_remove)
+  {
+    update_impl<false>(on_add, on_remove);
+  }
+
+  /* computes the boxes concurrently */
+  template <typename OnAdd, typename OnRemove>
+  requires std::invocable<OnAdd &, handle, handle> && std::invocable<OnRemove &, handle, handle>
+  void
+  update(execution::parallel_policy, OnAdd && on_add, OnRemove && on_remove)
+  {
+    update_impl<true>(on_add, on_remove);
+  }
+
+  template <typename OnAdd, typename OnRemove>
+  requires std::invocable<OnAdd &, handle, handle> && std::invocable<OnRemove &, handle, handle>
+  void
+  update(OnAdd && on_add, OnRemove && on_remove)
+  {
+    update_impl<false>(on_add, on_remove);
+  }
+
+private:
+  struct entry
+  {
+    value_type lower;
+    handle h;
+  };
+
+  template <bool Parallel, typename OnAdd, typename OnRemove>
+  void
+  update_impl(OnAdd & on_add, OnRemove & on_remove)
+  {
+    objects_.template refresh_all<Parallel>();
+
+    if (objects_.retired_any()) {
+      std::erase_if(order_, [&](entry const & e) { return !objects_.contains(e.h); });
+    }
+    auto const & lower = objects_.lower(axis_);
+    for (auto & e : order_) {
+      e.lower = lower[e.h];
+    }
+    auto const less = [](entry const & lhs, entry const & rhs) { return lhs.lower < rhs.lower; };
+    if (inserted_ > order_.size() / 4) {
+      std::ranges::stable_sort(order_, less);
+    } else {
+      detail::insertion_sort(order_, less, [](entry const &, entry const &) {});
+    }
+    inserted_ = 0;
+
+    /* the boxes in sweep order, one array per axis and side */
+    std::size_t const n = order_.size();
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sorted_lower_[axis].resize(n);
+      sorted_upper_[axis].resize(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        sorted_lower_[axis][i] = objects_.lower(axis)[order_[i].h];
+        sorted_upper_[axis][i] = objects_.upper(axis)[order_[i].h];
+      }
+    }
+
+    ++stamp_;
+    auto const & sweep_lower = sorted_lower_[axis_];
+    auto const & sweep_upper = sorted_upper_[axis_];
+    for (std::size_t i = 0; i < n; ++i) {
+      std::size_t end = i + 1;
+      while (end < n && sweep_lower[end] <= sweep_upper[i]) {
+        ++end;
+      }
+      if (end == i + 1) {
+        continue;
+      }
+
+      hits_.assign(end - i - 1, 1);
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        if (axis == axis_) {
+          continue;
+        }
+        value_type const * const lo = sorted_lower_[axis].data() + i + 1;
+        value_type const * const hi = sorted_upper_[axis].data() + i + 1;
+        value_type const lo_i = sorted_lower_[axis][i];
+        value_type const hi_i = sorted_upper_[axis][i];
+        unsigned char * const hit = hits_.data();
+        for (std::size_t j = 0; j < hits_.size(); ++j) {
+          hit[j] = static_cast<unsigned char>(hit[j] & static_cast<unsigned char>(lo[j] <= hi_i) & static_cast<unsigned char>(lo_i <= hi[j]));
+        }
+      }
+
+      for (std::size_t j = 0; j < hits_.size(); ++j) {
+        if (hits_[j] == 0) {
+          continue;
+        }
+        auto const pair = detail::sap_pair::of(order_[i].h, order_[i + 1 + j].h);
+        auto const [it, added] = pairs_.try_emplace(pair, stamp_);
+        if (added) {
+          on_add(pair.first, pair.second);
+        } else {
+          it->second = stamp_;
+        }
+      }
+    }
+
+    for (auto it = pairs_.begin(); it != pairs_.end();) {
+      if (it->second != stamp_) {
+        on_remove(it->first.first, it->first.second);
+        it = pairs_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    objects_.recycle();
+  }
+
+  std::size_t axis_ = 0;
+  objects_type objects_{};
+  std::vector<entry> order_{};
+  std::size_t inserted_ = 0;
+  std::unordered_map<detail::sap_pair, std::size_t, detail::sap_pair_hash> pairs_{};
+  std::size_t stamp_ = 0;
+
+  /* scratch of update(), kept to reuse the memory */
+  std::array<std::vector<value_type>, dimension> sorted_lower_{};
+  std::array<std::vector<value_type>, dimension> sorted_upper_{};
+  std::vector<unsigned char> hits_{};
+};
+
+/***************************** MultiAxisSweepAndPrune ********************************/
+
+/* Incremental sweep and prune over all axes (Baraff; Bullet's axis sweep).
+ * Every axis keeps the box ends of all objects sorted. Re-sorting them by
+ * insertion after motion swaps exactly the ends that crossed: a lower end
+ * passing an upper one may start an overlap, an upper end passing a lower
+ * one ends it. Only those pairs are tested, so a frame costs about the
+ * number of crossings instead of the number of overlaps, which pays off for
+ * the largest and densest scenes. The parallel version sorts the axes
+ * concurrently, the crossings are then resolved against the new boxes.
+ *
+ * Interface and events are those of SweepAndPrune. */
+template <concepts::broad_phase_object Object>
+class MultiAxisSweepAndPrune
+{
+  using objects_type = detail::sap_objects<Object>;
+
+public:
+  using object_type = Object;
+  using box_type = typename objects_type::box_type;
+  using value_type = typename objects_type::value_type;
+  using handle = std::size_t;
+
+  static constexpr std::size_t dimension = objects_type::dimension;
+
+  [[nodiscard]] std::size_t
+  size() const noexcept
+  {
+    return objects_.size();
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept
+  {
+    return objects_.size() == 0;
+  }
+
+  [[nodiscard]] bool
+  contains(handle h) const noexcept
+  {
+    return objects_.contains(h);
+  }
+
+  [[nodiscard]] Object const &
+  operator[](handle h) const noexcept
+  {
+    return objects_[h];
+  }
+
+  /* for changes in place, seen by the next update() */
+  [[nodiscard]] Object &
+  operator[](handle h) noexcept
+  {
+    return objects_[h];
+  }
+
+  [[nodiscard]] std::size_t
+  pair_count() const noexcept
+  {
+    return pairs_.size();
+  }
+
+  handle
+  insert(Object object)
+  {
+    handle const h = objects_.insert(std::move(object));
+    inserted_.push_back(h);
+    return h;
+  }
+
+  void
+  remove(handle h)
+  {
+    objects_.remove(h);
+  }
+
+  template <typename OnAdd, typename OnRemove>
+  requires std::invocable<OnAdd &, handle, handle> && std::invocable<OnRemove &, handle, handle>
+  void
+  update(execution::sequenced_policy, OnAdd && on_add, OnRemove && on_remove)
+  {
+    update_impl<false>(on_add, on_remove);
+  }
+
+  /* computes the boxes and sorts the axes concurrently */
+  template <typename OnAdd, typename OnRemove>
+  requires std::invocable<OnAdd &, handle, handle> && std::invocable<OnRemove &, handle, handle>
+  void
+  update(execution::parallel_policy, OnAdd && on_add, OnRemove && on_remove)
+  {
+    update_impl<true>(on_add, on_remove);
+  }
+
+  template <typename OnAdd, typename OnRemove>
+  requires std::invocable<OnAdd &, handle, handle> && std::invocable<OnRemove &, handle, handle>
+  void
+  update(OnAdd && on_add, OnRemove && on_remove)
+  {
+    update_impl<false>(on_add, on_remove);
+  }
+
+private:
+  /* one end of a box on an axis; lower ends sort before upper ends of the
+   * same value, so touching boxes overlap */
+  struct endpoint
+  {
+    value_type value;
+    handle h;
+    bool upper;
+
+    [[nodiscard]] friend bool
+    operator<(endpoint const & lhs, endpoint const & rhs) noexcept
+    {
+      return lhs.value < rhs.value || (lhs.value == rhs.value && !lhs.upper && rhs.upper);
+    }
+  };
+
+  struct crossing
+  {
+    detail::sap_pair pair;
+    bool starts;
+  };
+
+  template <bool Parallel, typename OnAdd, typename OnRemove>
+  void
+  update_impl(OnAdd & on_add, OnRemove & on_remove)
+  {
+    objects_.template refresh_all<Parallel>();
+
+    if (objects_.retired_any()) {
+      for (auto & endpoints : endpoints_) {
+        std::erase_if(endpoints, [&](endpoint const & e) { return !objects_.contains(e.h); });
+      }
+      for (auto it = pairs_.begin(); it != pairs_.end();) {
+        if (!objects_.contains(it->first.first) || !objects_.contains(it->first.second)) {
+          on_remove(it->first.first, it->first.second);
+          it = pairs_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    /* many new objects: sorting from scratch and one sweep beats sorting
+     * each of them in */
+    bool const rebuild = inserted_.size() > objects_.size() / 4;
+    for (handle const h : inserted_) {
+      if (objects_.contains(h)) {
+        for (auto & endpoints : endpoints_) {
+          endpoints.push_back({{}, h, false});
+          endpoints.push_back({{}, h, true});
+        }
+      }
+    }
+    inserted_.clear();
+
+    auto const sort_axis = [&](std::size_t axis) {
+      auto & endpoints = endpoints_[axis];
+      auto const & lower = objects_.lower(axis);
+      auto const & upper = objects_.upper(axis);
+      for (auto & e : endpoints) {
+        e.value = e.upper ? upper[e.h] : lower[e.h];
+      }
+      crossings_[axis].clear();
+      if (rebuild) {
+        std::sort(endpoints.begin(), endpoints.end());
+        return;
+      }
+      detail::insertion_sort(endpoints, std::less<>{}, [&](endpoint const & moving, endpoint const & passed) {
+        if (moving.upper != passed.upper) {
+          crossings_[axis].push_back({detail::sap_pair::of(moving.h, passed.h), passed.upper});
+        }
+      });
+    };
+    if constexpr (Parallel) {
+      detail::parallel_for(dimension, [&](std::size_t first, std::size_t last) {
+        for (std::size_t axis = first; axis < last; ++axis) {
+          sort_axis(axis);
+        }
+      });
+    } else {
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        sort_axis(axis);
+      }
+    }
+
+    if (rebuild) {
+      sweep(on_add, on_remove);
+    } else {
+      for (auto const & crossings : crossings_) {
+        for (auto const & [pair, starts] : crossings) {
+          if (starts) {
+            if (objects_.overlap(pair.first, pair.second) && pairs_.try_emplace(pair, 0).second) {
+              on_add(pair.first, pair.second);
+            }
+          } else if (!objects_.overlap(pair.first, pair.second) && pairs_.erase(pair) != 0) {
+            on_remove(pair.first, pair.second);
+          }
+        }
+      }
+    }
+    objects_.recycle();
+  }
+
+  /* all overlaps from the sorted first axis, reported against the last
+   * state */
+  template <typename OnAdd, typename OnRemove>
+  void
+  sweep(OnAdd & on_add, OnRemove & on_remove)
+  {
+    ++stamp_;
+    active_.clear();
+    position_.resize(objects_.capacity());
+    for (auto const & e : endpoints_[0]) {
+      if (e.upper) {
+        handle const last = active_.back();
+        active_[position_[e.h]] = last;
+        position_[last] = position_[e.h];
+        active_.pop_back();
+        continue;
+      }
+      for (handle const other : active_) {
+        if (objects_.overlap(e.h, other)) {
+          auto const pair = detail::sap_pair::of(e.h, other);
+          auto const [it, added] = pairs_.try_emplace(pair, stamp_);
+          if (added) {
+            on_add(pair.first, pair.second);
+          } else {
+            it->second = stamp_;
+          }
+        }
+      }
+      position_[e.h] = active_.size();
+      active_.push_back(e.h);
+    }
+
+    for (auto it = pairs_.begin(); it != pairs_.end();) {
+      if (it->second != stamp_) {
+        on_remove(it->first.first, it->first.second);
+        it = pairs_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  objects_type objects_{};
+  std::array<std::vector<endpoint>, dimension> endpoints_{};
+  std::vector<handle> inserted_{};
+  std::unordered_map<detail::sap_pair, std::size_t, detail::sap_pair_hash> pairs_{};
+  std::size_t stamp_ = 0;
+
+  /* scratch of update(), kept to reuse the memory */
+  std::array<std::vector<crossing>, dimension> crossings_{};
+  std::vector<handle> active_{};
+  std::vector<std::size_t> position_{};
+};
+
+} // namespace geo
+
+#endif
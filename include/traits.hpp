@@ -4,6 +4,7 @@
 #include <array>
 #include <concepts>
 #include <cstdint>
+#include <type_traits>
 
 namespace geo {
 
@@ -29,6 +30,7 @@ struct box_tag {};
 struct circle_tag {};
 struct arc_tag {};
 struct bezier_tag {};
+struct ray_tag {};
 
 template <typename T>
 struct tag;
@@ -72,8 +74,13 @@ struct iter;
 template <typename T>
 using iter_t = typename iter<T>::type;
 
+/* number types beyond the built-in ones, as Interval, opt in here to serve
+ * as coordinates and scalars */
+template <typename T>
+struct is_arithmetic : std::is_arithmetic<T> {};
+
 template <typename T, bool _ = (std::is_same_v<tag_t<T>, point_tag>
-                                 && std::is_arithmetic_v<value_type_t<T>>)>
+                                 && is_arithmetic<value_type_t<T>>::value)>
 struct is_point : std::false_type {};
 
 template <typename T>
@@ -143,7 +150,12 @@ template <typename T>
 concept not_an_array = !geo::traits::is_array<T>::value;
 
 template <typename T>
-concept arithmetic = std::integral<T> || std::floating_point<T>;
+concept arithmetic = geo::traits::is_arithmetic<T>::value;
+
+/* arithmetic types that are not integers, that is floating point types and
+ * intervals of them */
+template <typename T>
+concept real = arithmetic<T> && !std::integral<T>;
 
 template <typename GeoObject1, typename GeoObject2>
 concept same_dimension =
@@ -0,0 +1,336 @@
+#ifndef GEO_TRANSFORM_HPP
+#define GEO_TRANSFORM_HPP
+
+#include <array>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "algebra.hpp"
+#include "bezier.hpp"
+#include "bezier_batch.hpp"
+#include "circle.hpp"
+#include "detail/detail_transform.hpp"
+#include "math.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+
+namespace geo {
+
+/***************************** model ********************************/
+
+/* Both transforms store the full homogeneous (Dim + 1) x (Dim + 1) matrix,
+ * an affine transform keeps its last row at (0, ..., 0, 1). Composition with
+ * operator* is constexpr, so chains of constant transforms fold into a single
+ * matrix at compile time. */
+template <std::floating_point T, std::size_t Dim>
+requires (Dim > 0)
+struct Affine
+{
+  using value_type = T;
+
+  static constexpr std::size_t dimension = Dim;
+
+  constexpr Affine() noexcept
+      : matrix(detail::identity_matrix<T, Dim + 1>())
+  {}
+
+  [[nodiscard]] static constexpr Affine
+  identity() noexcept
+  {
+    return {};
+  }
+
+  template <concepts::point Point>
+  requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] static constexpr Affine
+  translation(Point const & offset) noexcept
+  {
+    Affine retval;
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (..., (retval.matrix[Is][Dim] = get<Is>(offset)));
+    }(std::make_index_sequence<Dim>{});
+    return retval;
+  }
+
+  [[nodiscard]] static constexpr Affine
+  scaling(T factor) noexcept
+  {
+    Affine retval;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      retval.matrix[i][i] = factor;
+    }
+    return retval;
+  }
+
+  template <concepts::point Point>
+  requires concepts::dimension_equals<Point, Dim> && concepts::value_type_equals<Point, T>
+  [[nodiscard]] static constexpr Affine
+  scaling(Point const & factors) noexcept
+  {
+    Affine retval;
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (..., (retval.matrix[Is][Is] = get<Is>(factors)));
+    }(std::make_index_sequence<Dim>{});
+    return retval;
+  }
+
+  /* counter-clockwise rotation about the origin */
+  [[nodiscard]] static constexpr Affine
+  rotation(T radians) noexcept
+  requires (Dim == 2)
+  {
+    T const sin = geo::sin(radians);
+    T const cos = geo::cos(radians);
+
+    Affine retval;
+    retval.matrix[0][0] = cos;
+    retval.matrix[0][1] = -sin;
+    retval.matrix[1][0] = sin;
+    retval.matrix[1][1] = cos;
+    return retval;
+  }
+
+  /* right-handed rotation about an axis through the origin (Rodrigues) */
+  template <concepts::point Point>
+  requires (Dim == 3)
+        && concepts::dimension_equals<Point, Dim>
+        && concepts::value_type_equals<Point, T>
+  [[nodiscard]] static constexpr Affine
+  rotation(Point const & axis, T radians) noexcept
+  {
+    T const length = norm(axis);
+    std::array<T, 3> const u{get<0>(axis) / length, get<1>(axis) / length, get<2>(axis) / length};
+    T const sin = geo::sin(radians);
+    T const cos = geo::cos(radians);
+
+    Affine retval;
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        retval.matrix[i][j] = (i == j ? cos : T{}) + (T{1} - cos) * u[i] * u[j];
+      }
+    }
+    retval.matrix[0][1] -= sin * u[2];
+    retval.matrix[0][2] += sin * u[1];
+    retval.matrix[1][0] += sin * u[2];
+    retval.matrix[1][2] -= sin * u[0];
+    retval.matrix[2][0] -= sin * u[1];
+    retval.matrix[2][1] += sin * u[0];
+    return retval;
+  }
+
+  /* volume scale factor of the linear part */
+  [[nodiscard]] constexpr T
+  determinant() const noexcept
+  requires (Dim == 2 || Dim == 3)
+  {
+    return detail::linear_determinant<Dim>(matrix);
+  }
+
+  [[nodiscard]] friend constexpr Affine
+  operator*(Affine const & lhs, Affine const & rhs) noexcept
+  {
+    Affine retval;
+    retval.matrix = detail::multiply(lhs.matrix, rhs.matrix);
+    return retval;
+  }
+
+  detail::matrix<T, Dim + 1> matrix;
+};
+
+template <std::floating_point T, std::size_t Dim>
+requires (Dim > 0)
+struct Projective
+{
+  using value_type = T;
+
+  static constexpr std::size_t dimension = Dim;
+
+  constexpr Projective() noexcept
+      : matrix(detail::identity_matrix<T, Dim + 1>())
+  {}
+
+  constexpr explicit Projective(detail::matrix<T, Dim + 1> const & matrix) noexcept
+      : matrix(matrix)
+  {}
+
+  constexpr Projective(Affine<T, Dim> const & affine) noexcept
+      : matrix(affine.matrix)
+  {}
+
+  [[nodiscard]] friend constexpr Projective
+  operator*(Projective const & lhs, Projective const & rhs) noexcept
+  {
+    return Projective(detail::multiply(lhs.matrix, rhs.matrix));
+  }
+
+  detail::matrix<T, Dim + 1> matrix;
+};
+
+template <std::floating_point T>
+using Affine2x = Affine<T, 2>;
+
+template <std::floating_point T>
+using Affine3x = Affine<T, 3>;
+
+template <std::floating_point T>
+using Projective3x = Projective<T, 3>;
+
+using Affine2d = Affine2x<double>;
+using Affine3d = Affine3x<double>;
+using Projective3d = Projective3x<double>;
+
+/***************************** concepts ********************************/
+
+namespace traits {
+
+template <typename T>
+struct is_transform : std::false_type {};
+
+template <std::floating_point T, std::size_t Dim>
+struct is_transform<Affine<T, Dim>> : std::true_type {};
+
+template <std::floating_point T, std::size_t Dim>
+struct is_transform<Projective<T, Dim>> : std::true_type {};
+
+} // namespace traits
+
+namespace concepts {
+
+template <typename T>
+concept transform = traits::is_transform<T>::value;
+
+template <typename Transform, typename Point>
+concept transforms_point =
+  transform<Transform>
+  && point<Point>
+  && dimension_equals<Point, Transform::dimension>
+  && value_type_equals<Point, typename Transform::value_type>;
+
+} // namespace concepts
+
+/***************************** algorithms ********************************/
+
+template <std::floating_point T, std::size_t Dim, concepts::point Point>
+requires concepts::transforms_point<Affine<T, Dim>, Point>
+[[nodiscard]] constexpr Point
+transform(Affine<T, Dim> const & xf, Point const & point) noexcept
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+  {
+    std::array<T, Dim> const p{get<Is>(point)...};
+    Point retval;
+    (..., set<Is>(retval, detail::apply_row(xf.matrix, Is, p, std::index_sequence<Is...>{})));
+    return retval;
+  }(std::make_index_sequence<Dim>{});
+}
+
+template <std::floating_point T, std::size_t Dim, concepts::point Point>
+requires concepts::transforms_point<Projective<T, Dim>, Point>
+[[nodiscard]] constexpr Point
+transform(Projective<T, Dim> const & xf, Point const & point) noexcept
+{
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+  {
+    std::array<T, Dim> const p{get<Is>(point)...};
+    T const w = detail::apply_row(xf.matrix, Dim, p, std::index_sequence<Is...>{});
+    Point retval;
+    (..., set<Is>(retval, detail::apply_row(xf.matrix, Is, p, std::index_sequence<Is...>{}) / w));
+    return retval;
+  }(std::make_index_sequence<Dim>{});
+}
+
+/* circles map to circles under similarity transforms only, the radius is
+ * scaled by the mean scale factor |det|^(1 / Dim) of the linear part */
+template <std::floating_point T, std::size_t Dim, concepts::circle Circle>
+requires concepts::transforms_point<Affine<T, Dim>, traits::point_type_t<Circle>>
+[[nodiscard]] constexpr Circle
+transform(Affine<T, Dim> const & xf, Circle const & circle)
+{
+  T const det = detail::abs(xf.determinant());
+  T const scale = Dim == 2 ? sqrt(det) : cbrt(det);
+
+  Circle retval = circle;
+  traits::access_center<Circle>::set(
+    retval, transform(xf, traits::access_center<Circle>::get(circle)));
+  traits::access_radius<Circle>::set(
+    retval, traits::access_radius<Circle>::get(circle) * scale);
+  return retval;
+}
+
+template <concepts::transform Transform, concepts::bezier Bezier>
+requires concepts::transforms_point<Transform, detail::ctrl_point_t<Bezier>>
+[[nodiscard]] Bezier
+transform(Transform const & xf, Bezier const & bezier)
+{
+  Bezier retval = bezier;
+  auto it = traits::access_bezier<Bezier>::begin(retval);
+  for (std::size_t i = 0; i <= traits::degree_v<Bezier>; ++i, ++it) {
+    *it = transform(xf, *it);
+  }
+  return retval;
+}
+
+/* AoS bulk transform of points, circles or Beziers */
+template <concepts::transform Transform, std::ranges::input_range Range, std::weakly_incrementable Out>
+requires requires (Transform const & xf, std::ranges::range_reference_t<Range> geo) {
+  transform(xf, geo);
+}
+constexpr Out
+transform(Transform const & xf, Range && range, Out out)
+{
+  for (auto const & geo : range) {
+    *out = transform(xf, geo);
+    ++out;
+  }
+  return out;
+}
+
+/* SoA bulk transform, in[k][j] is component k of point j. in and out may
+ * alias, every span must hold at least as many elements as in[0]. */
+template <concepts::transform Transform, std::size_t Dim = Transform::dimension>
+constexpr void
+transform(
+    Transform const & xf,
+    std::array<std::span<typename Transform::value_type const>, Dim> const & in,
+    std::array<std::span<typename Transform::value_type>, Dim> const & out) noexcept
+{
+  using T = typename Transform::value_type;
+
+  auto const & m = xf.matrix;
+  std::size_t const size = in[0].size();
+  for (std::size_t j = 0; j < size; ++j) {
+    std::array<T, Dim> p;
+    for (std::size_t k = 0; k < Dim; ++k) {
+      p[k] = in[k][j];
+    }
+    T w{1};
+    if constexpr (std::is_same_v<Transform, Projective<T, Dim>>) {
+      w = detail::apply_row(m, Dim, p, std::make_index_sequence<Dim>{});
+    }
+    for (std::size_t r = 0; r < Dim; ++r) {
+      out[r][j] = detail::apply_row(m, r, p, std::make_index_sequence<Dim>{}) / w;
+    }
+  }
+}
+
+/* transforms every control point of the batch in place */
+template <concepts::transform Transform, std::size_t Degree, std::floating_point T, std::size_t Dim>
+requires (Transform::dimension == Dim) && std::same_as<typename Transform::value_type, T>
+void
+transform(Transform const & xf, BezierBatch<Degree, T, Dim> & batch) noexcept
+{
+  for (std::size_t i = 0; i <= Degree; ++i) {
+    std::array<std::span<T const>, Dim> in;
+    std::array<std::span<T>, Dim> out;
+    for (std::size_t k = 0; k < Dim; ++k) {
+      out[k] = batch.lane(i, k);
+      in[k] = out[k];
+    }
+    transform(xf, in, out);
+  }
+}
+
+} // namespace geo
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef GEO_VIEWS_HPP
+#define GEO_VIEWS_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "bezier.hpp"
+#include "detail/detail_bezier.hpp"
+#include "detail/detail_views.hpp"
+#include "line.hpp"
+#include "point.hpp"
+#include "traits.hpp"
+#include "transform.hpp"
+
+namespace geo {
+
+namespace detail {
+
+struct sample_fn
+{
+  template <typename Bezier>
+  requires concepts::bezier<std::remove_cvref_t<Bezier>>
+  [[nodiscard]] constexpr auto
+  operator()(Bezier && bezier, std::size_t n) const
+  {
+    using Curve = std::remove_cvref_t<Bezier>;
+    using T = traits::value_type_t<ctrl_point_t<Curve>>;
+
+    auto const last = static_cast<T>(n > 1 ? n - 1 : 1);
+    return std::views::iota(std::size_t{0}, n)
+      | std::views::transform([curve = view_capture_t<Bezier>(std::forward<Bezier>(bezier)), last](std::size_t i) {
+          return evaluate_at(static_cast<Curve const &>(curve), static_cast<T>(i) / last);
+        });
+  }
+
+  template <std::ranges::viewable_range Range>
+  requires concepts::bezier<std::ranges::range_value_t<Range>>
+  [[nodiscard]] constexpr auto
+  operator()(Range && beziers, std::size_t n) const
+  {
+    return std::views::all(std::forward<Range>(beziers))
+      | std::views::transform([n]<typename Bezier>(Bezier && bezier) {
+          return sample_fn{}(std::forward<Bezier>(bezier), n);
+        })
+      | std::views::join;
+  }
+
+  [[nodiscard]] constexpr auto
+  operator()(std::size_t n) const
+  {
+    return view_closure{[n]<typename Range>(Range && beziers) {
+      return sample_fn{}(std::forward<Range>(beziers), n);
+    }};
+  }
+};
+
+struct transform_points_fn
+{
+  template <std::ranges::viewable_range Range, concepts::transform Transform>
+  requires requires (Transform const & xf, std::ranges::range_reference_t<Range> object) {
+    geo::transform(xf, object);
+  }
+  [[nodiscard]] constexpr auto
+  operator()(Range && range, Transform const & xf) const
+  {
+    return std::views::transform(std::forward<Range>(range), [xf](auto const & object) {
+      return geo::transform(xf, object);
+    });
+  }
+
+  template <concepts::transform Transform>
+  [[nodiscard]] constexpr auto
+  operator()(Transform const & xf) const
+  {
+    return view_closure{[xf]<typename Range>(Range && range) {
+      return transform_points_fn{}(std::forward<Range>(range), xf);
+    }};
+  }
+};
+
+/* The Lines between consecutive points of a random access view. A view
+ * type of its own rather than a transform over indices: the view over the
+ * points, which owns them for rvalue containers and may be move-only, is a
+ * member instead of a capture. */
+template <std::ranges::view V>
+requires std::ranges::random_access_range<V>
+      && std::ranges::sized_range<V>
+      && concepts::point<std::ranges::range_value_t<V>>
+class segments_view : public std::ranges::view_interface<segments_view<V>>
+{
+  template <bool Const>
+  class iterator
+  {
+    using Base = std::conditional_t<Const, V const, V>;
+    using Point = std::ranges::range_value_t<Base>;
+
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Line<Point>;
+    using difference_type = std::ranges::range_difference_t<Base>;
+
+    iterator() = default;
+
+    constexpr explicit iterator(std::ranges::iterator_t<Base> current)
+        : current_(std::move(current))
+    {}
+
+    [[nodiscard]] constexpr value_type
+    operator*() const
+    {
+      return value_type(current_[0], current_[1]);
+    }
+
+    [[nodiscard]] constexpr value_type
+    operator[](difference_type n) const
+    {
+      return value_type(current_[n], current_[n + 1]);
+    }
+
+    constexpr iterator &
+    operator++()
+    {
+      ++current_;
+      return *this;
+    }
+
+    constexpr iterator
+    operator++(int)
+    {
+      auto retval = *this;
+      ++current_;
+      return retval;
+    }
+
+    constexpr iterator &
+    operator--()
+    {
+      --current_;
+      return *this;
+    }
+
+    constexpr iterator
+    operator--(int)
+    {
+      auto retval = *this;
+      --current_;
+      return retval;
+    }
+
+    constexpr iterator &
+    operator+=(difference_type n)
+    {
+      current_ += n;
+      return *this;
+    }
+
+    constexpr iterator &
+    operator-=(difference_type n)
+    {
+      current_ -= n;
+      return *this;
+    }
+
+    [[nodiscard]] friend constexpr iterator
+    operator+(iterator it, difference_type n)
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr iterator
+    operator+(difference_type n, iterator it)
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr iterator
+    operator-(iterator it, difference_type n)
+    {
+      return it -= n;
+    }
+
+    [[nodiscard]] friend constexpr difference_type
+    operator-(iterator const & lhs, iterator const & rhs)
+    {
+      return lhs.current_ - rhs.current_;
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator==(iterator const & lhs, iterator const & rhs)
+    {
+      return lhs.current_ == rhs.current_;
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator<(iterator const & lhs, iterator const & rhs)
+    {
+      return lhs.current_ < rhs.current_;
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator>(iterator const & lhs, iterator const & rhs)
+    {
+      return rhs.current_ < lhs.current_;
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator<=(iterator const & lhs, iterator const & rhs)
+    {
+      return !(rhs.current_ < lhs.current_);
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator>=(iterator const & lhs, iterator const & rhs)
+    {
+      return !(lhs.current_ < rhs.current_);
+    }
+
+  private:
+    std::ranges::iterator_t<Base> current_{};
+  };
+
+public:
+  segments_view() requires std::default_initializable<V> = default;
+
+  constexpr explicit segments_view(V points)
+      : points_(std::move(points))
+  {}
+
+  [[nodiscard]] constexpr auto
+  begin()
+  {
+    return iterator<false>(std::ranges::begin(points_));
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const
+  requires std::ranges::random_access_range<V const> && std::ranges::sized_range<V const>
+  {
+    return iterator<true>(std::ranges::begin(points_));
+  }
+
+  [[nodiscard]] constexpr auto
+  end()
+  {
+    return begin() + static_cast<std::ranges::range_difference_t<V>>(size());
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const
+  requires std::ranges::random_access_range<V const> && std::ranges::sized_range<V const>
+  {
+    return begin() + static_cast<std::ranges::range_difference_t<V const>>(size());
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  size() const
+  requires std::ranges::sized_range<V const>
+  {
+    auto const points = static_cast<std::size_t>(std::ranges::size(points_));
+    return points > 1 ? points - 1 : 0;
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  size()
+  {
+    auto const points = static_cast<std::size_t>(std::ranges::size(points_));
+    return points > 1 ? points - 1 : 0;
+  }
+
+private:
+  V points_{};
+};
+
+template <typename Range>
+segments_view(Range &&) -> segments_view<std::views::all_t<Range>>;
+
+struct segments_fn
+{
+  template <std::ranges::viewable_range Range>
+  requires std::ranges::random_access_range<Range>
+        && std::ranges::sized_range<Range>
+        && concepts::point<std::ranges::range_value_t<Range>>
+  [[nodiscard]] constexpr auto
+  operator()(Range && polyline) const
+  {
+    return segments_view(std::forward<Range>(polyline));
+  }
+
+  template <std::ranges::viewable_range Range>
+  requires std::invocable<segments_fn const &, Range>
+  [[nodiscard]] friend constexpr auto
+  operator|(Range && polyline, segments_fn const & segments)
+  {
+    return segments(std::forward<Range>(polyline));
+  }
+};
+
+} // namespace detail
+
+/***************************** views ********************************/
+
+/* Lazy adaptors over geometry. They compose with each other and with the
+ * standard views into a single loop, nothing is materialized in between:
+ *
+ *   for (auto const & p : beziers | views::sample(16) | views::transform_points(xf)) {
+ *     max_x = std::max(max_x, get<0>(p));
+ *   }
+ *
+ * Like the standard views they refer to lvalue inputs, which have to
+ * outlive the view. */
+namespace views {
+
+/* sample(bezier, n): the n points at parameters i / (n - 1), a single curve
+ * held by value if passed as an rvalue
+ * sample(beziers, n) or beziers | sample(n): the samples of every curve of a
+ * range, concatenated */
+inline constexpr detail::sample_fn sample{};
+
+/* transform_points(range, xf) or range | transform_points(xf): every point,
+ * circle or Bezier of the range mapped by an Affine or Projective */
+inline constexpr detail::transform_points_fn transform_points{};
+
+/* segments(polyline) or polyline | segments: the Line between each pair of
+ * consecutive points, one less than there are points; holds an rvalue
+ * polyline by value */
+inline constexpr detail::segments_fn segments{};
+
+} // namespace views
+
+} // namespace geo
+
+#endif
@@ -1,7 +1,14 @@
 #include "geometry.hpp"
 #include "ut.hpp"
 
+#include <filesystem>
+#include <memory_resource>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string_view>
 #include <tuple>
+#include <variant>
 
 using namespace boost::ut;
 
@@ -78,6 +85,123 @@ int main()
     2346872.245324
   };
 
+  "constexpr sqrt and cbrt"_test = [] {
+    constexpr std::array<double, 7> numbers{
+      0.0, 1e-310, 0.25, 2.0, 13.45, 2346872.245324, 1.7e308
+    };
+    constexpr auto sqrts = [&] {
+      std::array<double, numbers.size()> retval{};
+      for (std::size_t i = 0; i < numbers.size(); ++i) {
+        retval[i] = geo::sqrt(numbers[i]);
+      }
+      return retval;
+    }();
+    constexpr auto cbrts = [&] {
+      std::array<double, numbers.size()> retval{};
+      for (std::size_t i = 0; i < numbers.size(); ++i) {
+        retval[i] = geo::cbrt(-numbers[i]);
+      }
+      return retval;
+    }();
+
+    constexpr auto epsilon = 2 * std::numeric_limits<double>::epsilon();
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+      expect(std::abs(sqrts[i] - std::sqrt(numbers[i])) <= epsilon * std::sqrt(numbers[i]));
+      expect(std::abs(cbrts[i] - std::cbrt(-numbers[i])) <= epsilon * std::cbrt(numbers[i]));
+    }
+    static_assert(geo::sqrt(-1.0) != geo::sqrt(-1.0));
+    static_assert(geo::sqrt(4.0f) == 2.0f);
+    static_assert(geo::cbrt(27.0) == 3.0);
+    static_assert(geo::hypot(3.0, 4.0) == 5.0);
+    static_assert(geo::hypot(1e300, 1e300) > 1e300);
+  };
+
+  "constexpr sin, cos, atan2 and acos"_test = [] {
+    constexpr std::array<double, 8> angles{
+      0.0, 0.5, -1.0, 2.0, std::numbers::pi, -4.0, 10.0, 1000.0
+    };
+    constexpr auto table = [&] {
+      std::array<std::array<double, 4>, angles.size()> retval{};
+      for (std::size_t i = 0; i < angles.size(); ++i) {
+        retval[i] = {
+          geo::sin(angles[i]),
+          geo::cos(angles[i]),
+          geo::atan2(geo::sin(angles[i]), geo::cos(angles[i])),
+          geo::acos(geo::cos(angles[i]))
+        };
+      }
+      return retval;
+    }();
+
+    constexpr auto epsilon = 4 * std::numeric_limits<double>::epsilon();
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+      auto const sin = std::sin(angles[i]);
+      auto const cos = std::cos(angles[i]);
+      expect(std::abs(table[i][0] - sin) < epsilon);
+      expect(std::abs(table[i][1] - cos) < epsilon);
+      expect(std::abs(table[i][2] - std::atan2(sin, cos)) < epsilon);
+      expect(std::abs(table[i][3] - std::acos(cos)) < 1e-7);
+    }
+    static_assert(geo::atan2(0.0, -1.0) == std::numbers::pi);
+    static_assert(geo::atan2(-0.0, -1.0) == -std::numbers::pi);
+    static_assert(geo::atan2(0.0, -0.0) == std::numbers::pi && geo::atan2(-0.0, -0.0) == -std::numbers::pi);
+
+    constexpr std::array<std::array<double, 2>, 6> special{{
+      {-0.0, 1.0}, {0.0, 0.0}, {-0.0, -0.0}, {-1.0, -0.0},
+      {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()},
+      {-std::numeric_limits<double>::infinity(), 2.0}
+    }};
+    constexpr auto special_table = [&] {
+      std::array<double, special.size()> retval{};
+      for (std::size_t i = 0; i < special.size(); ++i) {
+        retval[i] = geo::atan2(special[i][0], special[i][1]);
+      }
+      return retval;
+    }();
+    for (std::size_t i = 0; i < special.size(); ++i) {
+      auto const expected = std::atan2(special[i][0], special[i][1]);
+      expect(std::abs(special_table[i] - expected) < epsilon);
+      expect(std::signbit(special_table[i]) == std::signbit(expected));
+    }
+    static_assert(geo::sin(1e16) != geo::sin(1e16));
+    static_assert(geo::acos(-1.0f) == std::numbers::pi_v<float>);
+    static_assert(geo::sin(0.5f) == static_cast<float>(geo::sin(0.5)));
+  };
+
+  "constexpr norm and angle"_test = [] {
+    constexpr geo::Vector3d lhs(1.0, 2.0, 2.0);
+    constexpr geo::Vector3d rhs(0.0, 0.0, 1.0);
+    static_assert(geo::norm(lhs) == 3.0);
+    constexpr auto angle = geo::angle(lhs, rhs);
+    expect(std::abs(angle - std::acos(2.0 / 3.0)) < 1e-7);
+  };
+
+  "fast::rsqrt and fast::sqrt"_test = [](const auto & number){
+    constexpr auto epsilon = 4 * std::numeric_limits<double>::epsilon();
+    expect(std::abs(geo::fast::rsqrt(number) * std::sqrt(number) - 1.0) < epsilon);
+    expect(std::abs(geo::fast::sqrt(number) / std::sqrt(number) - 1.0) < epsilon);
+    expect(std::abs(geo::fast::rsqrt(static_cast<float>(number))
+                    * std::sqrt(static_cast<float>(number)) - 1.0f) < 4e-7f);
+  } | std::vector<double>{
+    1e-30,
+    1.0,
+    13.45,
+    2343.424,
+    2346872.245324
+  };
+
+  "fast::acos and fast::atan2"_test = [](const auto & number){
+    expect(std::abs(geo::fast::acos(number) - std::acos(number)) < 3e-8);
+    expect(std::abs(geo::fast::atan2(number, 0.5) - std::atan2(number, 0.5)) < 4e-8);
+    expect(std::abs(geo::fast::atan2(-0.5, number) - std::atan2(-0.5, number)) < 4e-8);
+  } | std::vector<double>{
+    -1.0,
+    -0.7,
+    0.0,
+    0.3,
+    1.0
+  };
+
   "dot_product Vector3d"_test = [](const auto & args) {
     const auto & [lhs, rhs, result] = args;
     constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
@@ -155,6 +279,42 @@ int main()
     {geo::Vector3d(2.2, 4.4, 6.6), 2.0, geo::Vector3d(1.1, 2.2, 3.3)}
   };
 
+  "normalize Vector3d"_test = [] {
+    std::vector<geo::Vector3d> const points{
+      geo::Vector3d(1.0, 0.0, 0.0),
+      geo::Vector3d(1.0, 2.0, 3.0),
+      geo::Vector3d(-4.0, 0.5, 1e3)
+    };
+    std::vector<geo::Vector3d> exact;
+    std::vector<geo::Vector3d> fast;
+    geo::normalize(points, std::back_inserter(exact));
+    geo::normalize(points, std::back_inserter(fast), geo::policy::fast{});
+
+    constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      expect(std::abs(geo::norm(exact[i]) - 1.0) < epsilon);
+      expect(geo::distance(exact[i], fast[i]) < epsilon);
+      expect(geo::distance(exact[i], geo::normalize(points[i])) < epsilon);
+    }
+  };
+
+  "angle Vector3d"_test = [](const auto & args) {
+    const auto & [lhs, rhs, result] = args;
+    constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
+    expect(std::abs(geo::angle(lhs, rhs) - result) < epsilon);
+    expect(std::abs(geo::angle(lhs, rhs, geo::policy::exact{}) - result) < epsilon);
+    expect(std::abs(geo::angle(lhs, rhs, geo::policy::fast{}) - result) < 3e-8);
+
+    double batched{};
+    geo::angle(std::array{lhs}, std::array{rhs}, &batched, geo::policy::fast{});
+    expect(batched == geo::angle(lhs, rhs, geo::policy::fast{}));
+  } | std::vector<std::tuple<geo::Vector3d, geo::Vector3d, double>>{
+    {geo::Vector3d(1.0, 0.0, 0.0), geo::Vector3d(1.0, 0.0, 0.0), 0.0},
+    {geo::Vector3d(1.0, 0.0, 0.0), geo::Vector3d(0.0, 2.0, 0.0), std::numbers::pi / 2.0},
+    {geo::Vector3d(1.0, 1.0, 0.0), geo::Vector3d(-3.0, -3.0, 0.0), std::numbers::pi},
+    {geo::Vector3d(1.0, 0.0, 0.0), geo::Vector3d(1.0, 1.0, 0.0), std::numbers::pi / 4.0}
+  };
+
   "area() Circle"_test = [](const auto & args) {
     const auto & [circle, result] = args;
     constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
@@ -164,5 +324,1360 @@ int main()
     {geo::Circle<geo::Vector3d>(geo::Vector3d(1.0, 2.0, 3.0), 4.0), 16.0 * std::numbers::pi}
   };
 
+  "sample Bezier with SampledBasis"_test = [] {
+    using Basis = geo::SampledBasis<3, 17>;
+    static_assert(Basis::weights[0][0] == 1.0 && Basis::weights[16][3] == 1.0);
+    static_assert(Basis::weights[8][1] == 3.0 * 0.5 * 0.5 * 0.5);
+
+    constexpr std::array<geo::Vector3d, 4> ctrls{
+      geo::Vector3d(1.0, 0.0, 0.0),
+      geo::Vector3d(1.0, 0.558, 0.0),
+      geo::Vector3d(0.558, 1.0, 0.0),
+      geo::Vector3d(0.0, 1.0, 0.0)
+    };
+    geo::Bezier<3, geo::Vector3d> const bezier(ctrls.cbegin(), ctrls.cend());
+
+    std::vector<geo::Vector3d> samples;
+    geo::sample(bezier, Basis{}, std::back_inserter(samples));
+    expect(samples.size() == Basis::samples);
+
+    constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+      auto const t = static_cast<double>(i) / 16.0;
+      expect(geo::distance(samples[i], geo::evaluate_at(bezier, t)) < epsilon);
+    }
+
+    std::vector<geo::Vector3d> batched;
+    geo::sample(std::vector{bezier, bezier}, Basis{}, std::back_inserter(batched));
+    expect(batched.size() == 2 * Basis::samples);
+    expect(geo::distance(batched[Basis::samples + 3], samples[3]) == 0.0);
+
+    using StaticCubicBezier = geo::Bezier<3, geo::Vector3d, std::array<geo::Vector3d, 4>>;
+    constexpr auto static_samples = [&] {
+      std::array<geo::Vector3d, Basis::samples> retval{};
+      geo::sample(StaticCubicBezier(ctrls), Basis{}, retval.begin());
+      return retval;
+    }();
+    expect(geo::distance(static_samples[5], samples[5]) < epsilon);
+  };
+
+  "evaluate_at BezierBatch"_test = [] {
+    using CubicBezier = geo::Bezier<3, geo::Vector3d>;
+    std::vector<CubicBezier> beziers;
+    for (int i = 0; i < 37; ++i) {
+      auto const offset = static_cast<double>(i);
+      std::array const ctrls{
+        geo::Vector3d(offset, 0.0, 1.0),
+        geo::Vector3d(1.0, offset, 2.0),
+        geo::Vector3d(-offset, 1.0, 3.0),
+        geo::Vector3d(0.0, 1.0, offset)
+      };
+      beziers.emplace_back(ctrls.cbegin(), ctrls.cend());
+    }
+
+    geo::BezierBatch<3, double, 3> const batch(beziers);
+    expect(batch.size() == beziers.size());
+    expect(batch.lane(2, 0)[5] == -5.0);
+
+    std::vector<geo::Vector3d> points;
+    geo::evaluate_at<geo::Vector3d>(batch, 0.3, std::back_inserter(points));
+    expect(points.size() == beziers.size());
+
+    constexpr auto epsilon = 1000 * std::numeric_limits<double>::epsilon();
+    for (std::size_t j = 0; j < beziers.size(); ++j) {
+      expect(geo::distance(points[j], geo::evaluate_at(beziers[j], 0.3)) < epsilon);
+    }
+
+    std::vector<CubicBezier> unpacked;
+    geo::unpack<geo::Vector3d>(batch, std::back_inserter(unpacked));
+    expect(unpacked.size() == beziers.size());
+    expect(geo::distance(unpacked[7].ctrls[2], beziers[7].ctrls[2]) == 0.0);
+
+    auto const static_bezier = batch.bezier<geo::Vector3d, std::array<geo::Vector3d, 4>>(9);
+    expect(geo::distance(static_bezier.ctrls[1], geo::Vector3d(1.0, 9.0, 2.0)) == 0.0);
+
+    geo::BezierBatch<3, double, 3> grown;
+    for (std::size_t j = 0; j < 600; ++j) {
+      grown.push_back(beziers[j % beziers.size()]);
+    }
+    for (std::size_t i = 0; i <= 3; ++i) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        expect(grown.lane(i, k).size() == 600_ul);
+      }
+    }
+    std::vector<geo::Vector3d> tiled;
+    geo::evaluate_at<geo::Vector3d>(grown, 0.3, std::back_inserter(tiled));
+    expect(tiled.size() == 600_ul);
+    expect(geo::distance(tiled[599], points[599 % beziers.size()]) == 0.0);
+    expect(geo::distance(tiled[300], points[300 % beziers.size()]) == 0.0);
+  };
+
+  "InlineVector and pmr Bezier containers"_test = [] {
+    static_assert(geo::concepts::container<geo::InlineVector<geo::Vector3d, 4>>);
+    static_assert(geo::concepts::container<std::pmr::vector<geo::Vector3d>>);
+
+    constexpr std::array<geo::Vector3d, 4> ctrls{
+      geo::Vector3d(1.0, 0.0, 0.0),
+      geo::Vector3d(1.0, 0.558, 0.0),
+      geo::Vector3d(0.558, 1.0, 0.0),
+      geo::Vector3d(0.0, 1.0, 0.0)
+    };
+
+    constexpr geo::InlineBezier<3, geo::Vector3d> inline_bezier(ctrls.cbegin(), ctrls.cend());
+    constexpr auto inline_point = geo::evaluate_at(inline_bezier, 0.5);
+    static_assert(inline_bezier.ctrls.size() == 4);
+
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource());
+    geo::pmr::Bezier<3, geo::Vector3d> const pmr_bezier(
+      ctrls.cbegin(), ctrls.cend(), std::pmr::polymorphic_allocator<geo::Vector3d>(&arena));
+    expect(pmr_bezier.ctrls.get_allocator().resource() == &arena);
+
+    constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
+    expect(geo::distance(inline_point, geo::evaluate_at(pmr_bezier, 0.5)) < epsilon);
+
+    geo::InlineVector<int, 3> vector{1, 2};
+    vector.push_back(3);
+    expect(vector.size() == 3_ul);
+    expect(throws<std::length_error>([&] { vector.push_back(4); }));
+    vector.resize(1);
+    expect(vector == geo::InlineVector<int, 3>{1});
+  };
+
+  "transform Affine and Projective"_test = [] {
+    constexpr auto xf = geo::Affine3d::translation(geo::Vector3d(1.0, 2.0, 3.0))
+                      * geo::Affine3d::rotation(geo::Vector3d(0.0, 0.0, 1.0), std::numbers::pi / 2.0)
+                      * geo::Affine3d::scaling(2.0);
+    constexpr auto point = geo::transform(xf, geo::Vector3d(1.0, 0.0, 1.0));
+
+    constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
+    expect(geo::distance(point, geo::Vector3d(1.0, 4.0, 5.0)) < epsilon);
+    expect(std::abs(xf.determinant() - 8.0) < epsilon);
+
+    constexpr auto rotation = geo::Affine2d::rotation(std::numbers::pi / 4.0);
+    auto const rotated = geo::transform(rotation, geo::Vector2d(1.0, 1.0));
+    expect(std::abs(rotated.x) < epsilon and std::abs(rotated.y - std::sqrt(2.0)) < epsilon);
+
+    /* perspective division by z */
+    geo::detail::matrix<double, 4> perspective{};
+    perspective[0][0] = perspective[1][1] = perspective[2][2] = perspective[3][2] = 1.0;
+    geo::Projective3d const projective = geo::Projective3d(perspective) * xf;
+    expect(geo::distance(geo::transform(projective, geo::Vector3d(1.0, 0.0, 1.0)),
+                         geo::Vector3d(0.2, 0.8, 1.0)) < epsilon);
+
+    geo::Circle<geo::Vector3d> const circle(geo::Vector3d(1.0, 0.0, 1.0), 1.5);
+    auto const moved = geo::transform(xf, circle);
+    expect(geo::distance(moved.center, point) < epsilon and std::abs(moved.radius - 3.0) < epsilon);
+
+    std::array const ctrls{
+      geo::Vector3d(1.0, 0.0, 1.0), geo::Vector3d(0.0, 1.0, 0.0),
+      geo::Vector3d(2.0, 2.0, 2.0), geo::Vector3d(1.0, 0.0, 1.0)
+    };
+    std::vector<geo::Bezier<3, geo::Vector3d>> beziers(
+      3, geo::Bezier<3, geo::Vector3d>(ctrls.cbegin(), ctrls.cend()));
+    std::vector<geo::Bezier<3, geo::Vector3d>> transformed;
+    geo::transform(xf, beziers, std::back_inserter(transformed));
+    expect(transformed.size() == 3_ul);
+    expect(geo::distance(transformed[2].ctrls[3], point) < epsilon);
+
+    geo::BezierBatch<3, double, 3> batch(beziers);
+    geo::transform(xf, batch);
+    for (std::size_t i = 0; i < 4; ++i) {
+      expect(geo::distance(batch.ctrl<geo::Vector3d>(1, i), transformed[1].ctrls[i]) < epsilon);
+    }
+  };
+
+  "io Writer and Reader"_test = [] {
+    auto const path = std::filesystem::temp_directory_path() / "geometry_tests_io.geo";
+
+    std::vector<geo::Vector3d> const points{
+      geo::Vector3d(1.0, 2.0, 3.0), geo::Vector3d(4.0, 5.0, 6.0)
+    };
+    std::vector<geo::Circle<geo::Vector2d>> const circles{
+      geo::Circle<geo::Vector2d>(geo::Vector2d(1.0, 1.0), 2.0)
+    };
+    std::array const ctrls{
+      geo::Vector3d(1.0, 0.0, 0.0), geo::Vector3d(1.0, 0.558, 0.0),
+      geo::Vector3d(0.558, 1.0, 0.0), geo::Vector3d(0.0, 1.0, 0.0)
+    };
+    std::vector<geo::Bezier<3, geo::Vector3d>> const beziers(
+      5, geo::Bezier<3, geo::Vector3d>(ctrls.cbegin(), ctrls.cend()));
+
+    {
+      geo::io::Writer writer(path);
+      writer.write_points(points);
+      writer.write_circles(circles);
+      writer.write_beziers(beziers);
+    }
+
+    geo::io::Reader const reader(path);
+    expect(reader.section_count() == 3_ul);
+
+    auto const mapped_points = reader.points<geo::Vector3d>(0);
+    static_assert(std::ranges::random_access_range<decltype(mapped_points)>);
+    expect(mapped_points.size() == 2_ul);
+    expect(geo::distance(mapped_points[1], points[1]) == 0.0);
+
+    auto const mapped_circles = reader.circles<geo::Circle<geo::Vector2d>>(1);
+    expect(mapped_circles.size() == 1_ul and mapped_circles[0].radius == 2.0);
+
+    auto const mapped_beziers = reader.beziers<3, geo::Vector3d>(2);
+    expect(std::ranges::size(mapped_beziers) == 5_ul);
+    expect(geo::distance(geo::evaluate_at(mapped_beziers[4], 0.5),
+                         geo::evaluate_at(beziers[4], 0.5)) == 0.0);
+
+    expect(throws<std::invalid_argument>([&] { (void)reader.points<geo::Vector2d>(0); }));
+    expect(throws<std::invalid_argument>([&] { (void)reader.beziers<2, geo::Vector3d>(2); }));
+
+    /* corrupted section headers must not map beyond the file, also where
+     * the byte count of the section wraps around */
+    auto const patch = [&](std::size_t section, std::size_t field, std::uint64_t value) {
+      auto const copy = std::filesystem::temp_directory_path() / "geometry_tests_io_corrupt.geo";
+      std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing);
+      std::fstream file(copy, std::ios::in | std::ios::out | std::ios::binary);
+      std::uint64_t table_offset = 0;
+      file.seekg(24);
+      file.read(reinterpret_cast<char *>(&table_offset), sizeof(table_offset));
+      file.seekp(static_cast<std::streamoff>(table_offset + section * 32 + field));
+      file.write(reinterpret_cast<char const *>(&value), sizeof(value));
+      return copy;
+    };
+    for (std::size_t section = 0; section < 3; ++section) {
+      for (std::uint64_t const count : {std::uint64_t{0x5555555555555556}, std::uint64_t{1} << 62, std::uint64_t{1000}}) {
+        auto const corrupt = patch(section, 16, count);
+        expect(throws<std::runtime_error>([&] { geo::io::Reader const broken(corrupt); }));
+      }
+    }
+    auto const misaligned = patch(0, 24, 72);
+    expect(throws<std::runtime_error>([&] { geo::io::Reader const broken(misaligned); }));
+    std::filesystem::remove(misaligned);
+    std::filesystem::remove(path);
+  };
+
+  "io SVG path and WKT parsers"_test = [] {
+    struct Collect
+    {
+      void operator()(geo::Line<geo::Vector2d> const & line) { lines.push_back(line); }
+      void operator()(geo::InlineBezier<2, geo::Vector2d> const &) { ++quadratics; }
+      void operator()(geo::InlineBezier<3, geo::Vector2d> const & bezier) { cubics.push_back(bezier); }
+
+      std::vector<geo::Line<geo::Vector2d>> lines;
+      std::vector<geo::InlineBezier<3, geo::Vector2d>> cubics;
+      std::size_t quadratics{};
+    };
+
+    std::string_view const path = "M10,10 h5 v-5 l-5,-5.5e0 C1 2 3 4 5 6 s1,1 2,2 Q0 0 1 1 T4 4 z";
+    auto const whole = geo::io::parse_svg_path<geo::Vector2d>(path, Collect{});
+    expect(whole.lines.size() == 4_ul and whole.cubics.size() == 2_ul and whole.quadratics == 2_ul);
+    expect(geo::distance(whole.lines[1].end, geo::Vector2d(15.0, 5.0)) == 0.0);
+    /* smooth curve reflects the previous control point about the current point */
+    expect(geo::distance(whole.cubics[1].ctrls[1], geo::Vector2d(7.0, 8.0)) == 0.0);
+    expect(geo::distance(whole.lines[3].end, geo::Vector2d(10.0, 10.0)) == 0.0);
+
+    /* chunk boundaries fall inside numbers and commands */
+    Collect chunked;
+    geo::io::SvgPathParser<geo::Vector2d, Collect &> parser(chunked);
+    for (std::size_t i = 0; i < path.size(); i += 3) {
+      parser.feed(path.substr(i, 3));
+    }
+    parser.finish();
+    expect(chunked.lines.size() == 4_ul and chunked.cubics.size() == 2_ul);
+    expect(geo::distance(chunked.cubics[1].ctrls[3], whole.cubics[1].ctrls[3]) == 0.0);
+
+    std::size_t segments = 0;
+    geo::io::parse_wkt<geo::Vector3d>(
+      "POLYGON Z ((0 0 0, 1 0 0, 1 1 0, 0 0 0), (0.2 0.2 1, 0.4 0.2 1)) LINESTRING EMPTY",
+      [&](geo::Line<geo::Vector3d> const &) { ++segments; });
+    expect(segments == 4_ul);
+
+    expect(throws<std::invalid_argument>([] {
+      geo::io::parse_svg_path<geo::Vector2d>("M0 0 A1 1 0 0 1 2 2", Collect{});
+    }));
+    expect(throws<std::invalid_argument>([] {
+      geo::io::parse_wkt<geo::Vector2d>("POINT (1 2)", [](geo::Line<geo::Vector2d> const &) {});
+    }));
+  };
+
+  "CompressedBezierBatch decode and evaluate"_test = [] {
+    std::vector<geo::Bezier<3, geo::Vector3d>> beziers;
+    for (std::size_t i = 0; i < 150; ++i) {
+      auto const offset = geo::Vector3d(static_cast<double>(i) * 10.0, static_cast<double>(i % 7) * 100.0, -5.0);
+      std::array const ctrls{
+        offset, offset + geo::Vector3d(0.5, 0.25, 0.0),
+        offset + geo::Vector3d(1.0, 0.5, 0.125), offset + geo::Vector3d(1.5, 0.0, 0.25)
+      };
+      beziers.emplace_back(ctrls.cbegin(), ctrls.cend());
+    }
+
+    geo::CompressedBezierBatch<3, double, 3> const compressed(beziers);
+    expect(compressed.size() == 150_ul and compressed.block_count() == 3_ul);
+    expect(compressed.bytes() * 3 < beziers.size() * 4 * sizeof(geo::Vector3d));
+    /* 16 bit grid over a 1490 wide box */
+    expect(compressed.max_error() < 0.015);
+
+    auto const curves = compressed.curves<geo::Vector3d>();
+    expect(std::ranges::size(curves) == 150_ul);
+    expect(geo::distance(curves[149].ctrls[2], beziers[149].ctrls[2]) < 0.03);
+
+    std::array<std::vector<double>, 3> components;
+    for (auto & component : components) {
+      component.resize(compressed.size());
+    }
+    geo::evaluate_at(compressed, 0.5, {components[0], components[1], components[2]});
+    for (std::size_t j : {0u, 64u, 149u}) {
+      auto const expected = geo::evaluate_at(beziers[j], 0.5);
+      auto const decoded = geo::evaluate_at(curves[j], 0.5);
+      expect(geo::distance(geo::Vector3d(components[0][j], components[1][j], components[2][j]), expected) < 0.03);
+      expect(geo::distance(decoded, expected) < 0.03);
+    }
+
+    geo::CompressedBezierBatch<3, double, 3, std::uint32_t> const precise(beziers);
+    expect(precise.max_error() < 1e-6);
+
+    /* 32 bit codes in float, the largest anchor lands on the last code */
+    std::vector<geo::Bezier<3, geo::Vector2x<float>>> floats;
+    for (std::size_t i = 0; i <= 30; ++i) {
+      auto const offset = geo::Vector2x<float>(3.0f * static_cast<float>(i), 3.1f * static_cast<float>(i));
+      std::array const ctrls{offset, offset + geo::Vector2x<float>(0.5f, -2.0f), offset + geo::Vector2x<float>(1.0f, 1.0f), offset + geo::Vector2x<float>(-6.0f, 0.0f)};
+      floats.emplace_back(ctrls.cbegin(), ctrls.cend());
+    }
+    geo::CompressedBezierBatch<3, float, 2, std::uint32_t> const wide(floats);
+    expect(wide.max_error() < 1e-4f);
+    auto const last = wide.bezier<geo::Vector2x<float>>(30);
+    expect(std::abs(last.ctrls[0].x - 90.0f) < 1e-4f && std::abs(last.ctrls[0].y - 93.0f) < 1e-4f);
+    expect(std::abs(last.ctrls[3].x - 84.0f) < 1e-4f);
+
+    floats[3].ctrls[1].y = std::numeric_limits<float>::quiet_NaN();
+    expect(throws<std::invalid_argument>([&] { geo::CompressedBezierBatch<3, float, 2, std::uint32_t> const broken(floats); }));
+  };
+
+  "orientation and segment intersection"_test = [] {
+    using Line = geo::Line<geo::Vector2d>;
+
+    static_assert(geo::orientation(geo::Vector2d(0.0, 0.0), geo::Vector2d(1.0, 0.0), geo::Vector2d(0.0, 1.0)) == 1);
+    /* a naive evaluation gets the sign of these nearly collinear points wrong */
+    expect(geo::orientation(geo::Vector2d(0.5, 0.5), geo::Vector2d(12.0, 12.0),
+                            geo::Vector2d(24.0, 24.0 + std::ldexp(1.0, -48))) == 1);
+    expect(geo::orientation(geo::Vector2d(0.1, 0.1), geo::Vector2d(0.3, 0.3), geo::Vector2d(0.7, 0.7)) == 0);
+
+    auto const crossing = geo::intersect(Line({0.0, 0.0}, {2.0, 2.0}), Line({0.0, 2.0}, {2.0, 0.0}));
+    expect(crossing.has_value() and geo::distance(*crossing, geo::Vector2d(1.0, 1.0)) < 1e-15);
+    expect(geo::intersects(Line({0.0, 0.0}, {2.0, 0.0}), Line({1.0, 0.0}, {1.0, 5.0})));
+    auto const overlap = geo::intersect(Line({0.0, 0.0}, {2.0, 0.0}), Line({1.0, 0.0}, {3.0, 0.0}));
+    expect(overlap.has_value() and geo::distance(*overlap, geo::Vector2d(1.0, 0.0)) == 0.0);
+    expect(!geo::intersect(Line({0.0, 0.0}, {2.0, 0.0}), Line({0.0, 1.0}, {2.0, 1.0})).has_value());
+    expect(!geo::intersects(Line({0.0, 0.0}, {1.0, 0.0}), Line({2.0, 0.0}, {3.0, 0.0})));
+  };
+
+  "intersections sweep and grid"_test = [] {
+    using Line = geo::Line<geo::Vector2d>;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0.0, 100.0);
+    std::uniform_real_distribution<double> offset(-5.0, 5.0);
+    std::vector<Line> lines;
+    for (std::size_t i = 0; i < 400; ++i) {
+      geo::Vector2d const start(position(generator), position(generator));
+      lines.emplace_back(start, start + geo::Vector2d(offset(generator), offset(generator)));
+    }
+    /* shared end points and a collinear chain */
+    lines.emplace_back(geo::Vector2d(10.0, 10.0), geo::Vector2d(20.0, 10.0));
+    lines.emplace_back(geo::Vector2d(20.0, 10.0), geo::Vector2d(30.0, 10.0));
+    lines.emplace_back(geo::Vector2d(20.0, 10.0), geo::Vector2d(20.0, 30.0));
+    /* overlapping collinear segments, a point, a star and long diagonals */
+    lines.emplace_back(geo::Vector2d(40.0, 40.0), geo::Vector2d(60.0, 60.0));
+    lines.emplace_back(geo::Vector2d(50.0, 50.0), geo::Vector2d(70.0, 70.0));
+    lines.emplace_back(geo::Vector2d(55.0, 55.0), geo::Vector2d(55.0, 55.0));
+    for (std::size_t i = 0; i < 8; ++i) {
+      double const angle = 0.4 * static_cast<double>(i);
+      geo::Vector2d const direction(std::cos(angle), std::sin(angle));
+      lines.emplace_back(geo::Vector2d(30.0, 70.0) - direction * 10.0, geo::Vector2d(30.0, 70.0) + direction * 10.0);
+    }
+    lines.emplace_back(geo::Vector2d(0.0, 0.0), geo::Vector2d(100.0, 100.0));
+    lines.emplace_back(geo::Vector2d(0.0, 100.0), geo::Vector2d(100.0, 0.0));
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+      for (std::size_t j = i + 1; j < lines.size(); ++j) {
+        if (geo::intersects(lines[i], lines[j])) {
+          expected.emplace_back(i, j);
+        }
+      }
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> swept;
+    geo::intersections(lines, [&](std::size_t i, std::size_t j) { swept.emplace_back(i, j); });
+    std::ranges::sort(swept);
+    expect(std::ranges::equal(swept, expected));
+
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, std::size_t>> gridded;
+    geo::intersections(geo::execution::par, lines, [&](std::size_t i, std::size_t j) {
+      std::lock_guard const lock(mutex);
+      gridded.emplace_back(i, j);
+    });
+    std::ranges::sort(gridded);
+    expect(std::ranges::equal(gridded, expected));
+    expect(expected.size() > 3_ul);
+
+    lines.emplace_back(geo::Vector2d(0.0, 0.0), geo::Vector2d(std::numeric_limits<double>::quiet_NaN(), 1.0));
+    auto const ignore = [](std::size_t, std::size_t) {};
+    expect(throws<std::invalid_argument>([&] { geo::intersections(lines, ignore); }));
+    expect(throws<std::invalid_argument>([&] { geo::intersections(geo::execution::par, lines, ignore); }));
+  };
+
+  "convex_hull 2D and 3D"_test = [] {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<geo::Vector2d> square{
+      geo::Vector2d(1.0, 1.0), geo::Vector2d(0.0, 1.0), geo::Vector2d(0.5, 0.0),
+      geo::Vector2d(0.0, 0.0), geo::Vector2d(1.0, 0.0), geo::Vector2d(1.0, 0.25)
+    };
+    for (std::size_t i = 0; i < 5000; ++i) {
+      square.emplace_back(unit(generator), unit(generator));
+    }
+    std::vector<geo::Vector2d> hull;
+    geo::convex_hull(square, std::back_inserter(hull));
+    expect(hull.size() == 4_ul);
+    expect(geo::distance(hull[0], geo::Vector2d(0.0, 0.0)) == 0.0);
+    expect(geo::distance(hull[1], geo::Vector2d(1.0, 0.0)) == 0.0);
+    expect(geo::distance(hull[3], geo::Vector2d(0.0, 1.0)) == 0.0);
+
+    std::vector<geo::Vector2d> parallel_hull;
+    geo::convex_hull(geo::execution::par, square, std::back_inserter(parallel_hull));
+    expect(parallel_hull.size() == 4_ul);
+
+    std::vector<geo::Vector3d> cloud;
+    for (std::size_t i = 0; i < 8; ++i) {
+      cloud.emplace_back(static_cast<double>(i & 1u), static_cast<double>((i >> 1) & 1u), static_cast<double>(i >> 2));
+    }
+    for (std::size_t i = 0; i < 2000; ++i) {
+      cloud.emplace_back(unit(generator), unit(generator), unit(generator));
+      cloud.emplace_back(unit(generator), unit(generator), 1.0);
+    }
+    std::vector<std::array<geo::Vector3d, 3>> triangles;
+    geo::convex_hull(cloud, std::back_inserter(triangles));
+    expect(triangles.size() == 12_ul);
+    bool const contains_all = std::ranges::all_of(triangles, [&](auto const & t) {
+      return std::ranges::all_of(cloud, [&](auto const & p) { return geo::orientation(t[0], t[1], t[2], p) <= 0; });
+    });
+    expect(contains_all);
+
+    std::vector<std::array<geo::Vector3d, 3>> parallel_triangles;
+    geo::convex_hull(geo::execution::par, cloud, std::back_inserter(parallel_triangles));
+    expect(parallel_triangles.size() == 12_ul);
+
+    std::vector<std::array<geo::Vector3d, 3>> flat;
+    std::vector<geo::Vector3d> const plane{
+      geo::Vector3d(0.0, 0.0, 1.0), geo::Vector3d(1.0, 0.0, 1.0), geo::Vector3d(0.0, 1.0, 1.0), geo::Vector3d(1.0, 1.0, 1.0)
+    };
+    geo::convex_hull(plane, std::back_inserter(flat));
+    expect(flat.empty());
+  };
+
+  "Delaunay triangulation and Voronoi dual"_test = [] {
+    using geo::Vector2d;
+
+    expect(geo::incircle(Vector2d(5.0, 0.0), Vector2d(0.0, 5.0), Vector2d(-5.0, 0.0), Vector2d(3.0, 4.0)) == 0_i);
+    expect(geo::incircle(Vector2d(5.0, 0.0), Vector2d(0.0, 5.0), Vector2d(-5.0, 0.0), Vector2d(3.0, std::nextafter(4.0, 0.0))) == 1_i);
+    expect(geo::incircle(Vector2d(1e6 + 5.0, 1e6), Vector2d(1e6, 1e6 + 5.0), Vector2d(1e6 - 5.0, 1e6),
+                         Vector2d(1e6 + 3.0, std::nextafter(1e6 + 4.0, 1e7))) == -1_i);
+
+    /* random points plus a cocircular grid with duplicates */
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Vector2d> points;
+    for (std::size_t i = 0; i < 20; ++i) {
+      for (std::size_t j = 0; j < 20; ++j) {
+        points.emplace_back(static_cast<double>(i) / 19.0, static_cast<double>(j) / 19.0);
+      }
+    }
+    for (std::size_t i = 0; i < 2000; ++i) {
+      points.emplace_back(unit(generator), unit(generator));
+    }
+    points.push_back(points[3]);
+    points.push_back(points[500]);
+
+    geo::Delaunay const mesh(points);
+    auto const triangles = mesh.triangles();
+    auto const halfedges = mesh.halfedges();
+    std::size_t const next[] = {1, 2, 0};
+
+    bool ccw = true;
+    bool empty_circles = true;
+    bool twins = true;
+    std::size_t hull_edges = 0;
+    for (std::size_t e = 0; e < triangles.size(); ++e) {
+      auto const t = mesh.triangle(e / 3);
+      ccw = ccw && geo::orientation(t[0], t[1], t[2]) > 0;
+      if (halfedges[e] == mesh.none) {
+        ++hull_edges;
+        continue;
+      }
+      std::size_t const f = halfedges[e];
+      twins = twins && halfedges[f] == e && triangles[f] == triangles[e - e % 3 + next[e % 3]];
+      auto const opposite = points[triangles[f - f % 3 + next[next[f % 3]]]];
+      empty_circles = empty_circles && geo::incircle(t[0], t[1], t[2], opposite) <= 0;
+    }
+    expect(ccw);
+    expect(twins);
+    expect(empty_circles);
+    /* the boundary of the unit square holds 76 grid points */
+    expect(hull_edges == 76_ul);
+    expect(mesh.triangle_count() == 2 * (points.size() - 2) - 2 - hull_edges);
+
+    auto const voronoi = mesh.voronoi();
+    expect(voronoi.size() == points.size());
+    expect(!voronoi.bounded(0) && voronoi.bounded(21));
+    expect(voronoi.cell(points.size() - 1).empty());
+    /* no site is closer to a vertex of a cell than the site of the cell */
+    auto const cell = voronoi.cell(21);
+    bool const nearest = std::ranges::all_of(cell, [&](std::size_t v) {
+      double const radius = geo::distance(voronoi.vertices()[v], points[21]);
+      return std::ranges::all_of(points, [&](auto const & p) {
+        return geo::distance(voronoi.vertices()[v], p) >= radius - 1e-12;
+      });
+    });
+    expect(cell.size() >= 3_ul);
+    expect(nearest);
+
+    std::vector<Vector2d> const line{Vector2d(0.0, 0.0), Vector2d(1.0, 1.0), Vector2d(2.0, 2.0)};
+    expect(geo::Delaunay(line).triangle_count() == 0_ul);
+  };
+
+  "VectorNx padded lanes and algebra"_test = [] {
+    static_assert(sizeof(geo::PaddedVector3d) == 32 && alignof(geo::PaddedVector3d) == 32);
+    static_assert(geo::PaddedVector3d::lanes == 4 && geo::VectorNx<double, 3>::lanes == 3);
+    static_assert(sizeof(geo::Vector6d) == 48 && geo::traits::dimension_v<geo::Vector6d> == 6);
+    static_assert(geo::concepts::point<geo::Vector4d>);
+
+    constexpr geo::PaddedVector3d lhs(1.0, 2.0, 3.0);
+    constexpr geo::PaddedVector3d rhs(4.0, -5.0, 6.0);
+    static_assert(geo::dot_product(lhs, rhs) == 12.0);
+    static_assert(geo::norm(geo::PaddedVector3d(2.0, 3.0, 6.0)) == 7.0);
+    constexpr auto cross = geo::vector_product(lhs, rhs);
+    constexpr auto generic = geo::vector_product(geo::Vector3d(1.0, 2.0, 3.0), geo::Vector3d(4.0, -5.0, 6.0));
+    static_assert(cross[0] == generic.x && cross[1] == generic.y && cross[2] == generic.z);
+    static_assert(generic.z == -13.0);
+
+    auto const scaled = (lhs + rhs) / 0.0;
+    expect(scaled.data[3] == 0.0);
+    expect(geo::get<2>(lhs - rhs * 2.0) == -9.0);
+
+    /* homogeneous and 6D state vectors through the generic paths */
+    std::array const ctrls{geo::Vector4d(0.0, 0.0, 0.0, 1.0), geo::Vector4d(2.0, 2.0, 2.0, 1.0)};
+    geo::Bezier<1, geo::Vector4d> const bezier(ctrls.cbegin(), ctrls.cend());
+    expect(geo::evaluate_at(bezier, 0.25)[1] == 0.5);
+    geo::Vector6d const state(1.0, 1.0, 1.0, 1.0, 1.0, 1.0);
+    expect(geo::distance(state, geo::Vector6d{}) == std::sqrt(6.0));
+    expect(geo::dot_product(geo::normalize(state), state) - std::sqrt(6.0) < 1e-15);
+  };
+
+  "views sample, transform_points and segments"_test = [] {
+    using geo::Vector2d;
+
+    std::array const ctrls{Vector2d(0.0, 0.0), Vector2d(1.0, 2.0), Vector2d(2.0, 0.0)};
+    geo::Bezier<2, Vector2d> const bezier(ctrls.cbegin(), ctrls.cend());
+    auto const samples = geo::views::sample(bezier, 5);
+    expect(std::ranges::size(samples) == 5_ul);
+    expect(samples[0].x == 0.0 && samples[4].x == 2.0 && samples[2].y == 1.0);
+    expect(geo::views::sample(geo::Bezier<2, Vector2d>(ctrls.cbegin(), ctrls.cend()), 3)[1].y == 1.0);
+
+    /* sample -> transform -> bounds in one pass, against materialized buffers */
+    std::vector<geo::Bezier<2, Vector2d>> const beziers(3, bezier);
+    auto const shift = geo::Affine2d::translation(Vector2d(10.0, -1.0));
+    double max_y = -1e300;
+    std::size_t count = 0;
+    for (auto const & p : beziers | geo::views::sample(9) | geo::views::transform_points(shift)) {
+      max_y = std::max(max_y, p.y);
+      ++count;
+    }
+    std::vector<Vector2d> buffer;
+    for (auto const & curve : beziers) {
+      for (std::size_t i = 0; i < 9; ++i) {
+        buffer.push_back(geo::transform(shift, geo::evaluate_at(curve, static_cast<double>(i) / 8.0)));
+      }
+    }
+    expect(count == buffer.size());
+    expect(max_y == std::ranges::max(buffer | std::views::transform([](auto const & p) { return p.y; })));
+    expect(std::ranges::equal(geo::views::sample(beziers, 9) | geo::views::transform_points(shift), buffer,
+                              [](auto const & lhs, auto const & rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; }));
+
+    std::vector<Vector2d> const polyline{Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(1.0, 1.0)};
+    auto const lines = polyline | geo::views::segments;
+    expect(std::ranges::size(lines) == 2_ul);
+    expect(lines[1].start.x == 1.0 && lines[1].end.y == 1.0);
+    expect(std::ranges::empty(geo::views::segments(std::span(polyline).first(1))));
+    expect(geo::intersects(*std::ranges::begin(lines), geo::Line<Vector2d>(Vector2d(0.5, -1.0), Vector2d(0.5, 1.0))));
+
+    /* a temporary polyline is owned by the view */
+    auto const owned = std::vector<Vector2d>{Vector2d(0.0, 0.0), Vector2d(2.0, 0.0), Vector2d(2.0, 3.0)} | geo::views::segments;
+    static_assert(std::ranges::random_access_range<decltype(owned)> && std::ranges::sized_range<decltype(owned)>);
+    expect(std::ranges::size(owned) == 2_ul && owned[1].end.y == 3.0);
+    expect(std::ranges::equal(owned, std::array{0.0, 2.0}, {}, [](auto const & line) { return line.start.x; }));
+  };
+
+  "stats are empty when not enabled"_test = [] {
+    geo::stats::reset();
+    expect(geo::norm(geo::Vector3d(1.0, 2.0, 2.0)) == 3.0);
+    auto const snapshot = geo::stats::take_snapshot();
+    expect(snapshot.calls_of(geo::stats::operation::norm) == 0_ul);
+    expect(geo::stats::to_json(snapshot) == "{}");
+  };
+
+  "space-filling curves and spatial_sort"_test = [] {
+    static_assert(geo::morton_code(1u, 0u) == 1 && geo::morton_code(0u, 1u) == 2 && geo::morton_code(3u, 3u) == 15);
+    static_assert(geo::morton_code(0u, 0u, 2u) == 32 && geo::morton_code(1u, 1u, 1u) == 7);
+    std::uint32_t const all = std::numeric_limits<std::uint32_t>::max();
+    expect(geo::morton_code(all, 0u) == std::uint64_t{0x5555555555555555});
+    expect(geo::morton_code(0u, 0u, all) == std::uint64_t{0x4924924924924924});
+    expect(geo::morton_code(geo::Vector3x<std::uint32_t>(5, 0, 0)) == 65_ull);
+
+    /* the first 4^k indices fill the 2^k grid and step between neighbors */
+    auto const walks_grid = [](auto index, std::size_t dim) {
+      std::size_t const cells = std::size_t{1} << (3 * dim);
+      std::vector<std::array<std::uint32_t, 3>> at(cells, {all, all, all});
+      for (std::uint32_t i = 0; i < cells; ++i) {
+        std::array<std::uint32_t, 3> const cell{i & 7u, (i >> 3) & 7u, i >> 6};
+        auto const d = index(cell);
+        if (d < cells) {
+          at[d] = cell;
+        }
+      }
+      for (std::size_t d = 1; d < cells; ++d) {
+        std::uint32_t steps = 0;
+        for (std::size_t k = 0; k < 3; ++k) {
+          steps += at[d][k] > at[d - 1][k] ? at[d][k] - at[d - 1][k] : at[d - 1][k] - at[d][k];
+        }
+        if (steps != 1) {
+          return false;
+        }
+      }
+      return true;
+    };
+    expect(walks_grid([](auto const & c) { return geo::hilbert_index(c[0], c[1]); }, 2));
+    expect(walks_grid([](auto const & c) { return geo::hilbert_index(c[0], c[1], c[2]); }, 3));
+    expect(geo::hilbert_index(geo::Vector2x<std::uint32_t>(0, 1)) == 3_ull);
+
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<geo::Vector2d> points;
+    for (std::size_t i = 0; i < 100000; ++i) {
+      points.emplace_back(unit(generator), unit(generator));
+    }
+    auto const order = geo::spatial_order(points);
+    expect(std::ranges::equal(order, geo::spatial_order(geo::execution::par, points)));
+    auto sorted_order = order;
+    std::ranges::sort(sorted_order);
+    expect(std::ranges::equal(sorted_order, std::views::iota(std::size_t{0}, points.size())));
+
+    /* curve order keeps consecutive points close, input order does not */
+    auto const path_length = [](std::vector<geo::Vector2d> const & path) {
+      double length = 0.0;
+      for (std::size_t i = 1; i < path.size(); ++i) {
+        length += geo::distance(path[i - 1], path[i]);
+      }
+      return length;
+    };
+    auto sorted = points;
+    geo::spatial_sort(geo::execution::par, sorted);
+    expect(sorted[0].x == points[order[0]].x && sorted.back().y == points[order.back()].y);
+    expect(path_length(sorted) * 50.0 < path_length(points));
+    auto morton = points;
+    geo::spatial_sort(morton, geo::space_filling_curve::morton);
+    expect(path_length(morton) * 25.0 < path_length(points));
+
+    std::vector<geo::Circle<geo::Vector2d>> circles;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      circles.emplace_back(points[i], 0.5);
+    }
+    expect(std::ranges::equal(geo::spatial_order(circles), geo::spatial_order(std::span(points).first(1000))));
+
+    /* bounds whose extent overflows, and infinite coordinates, still give
+     * a permutation; on a row Morton order is the order along it */
+    std::vector<geo::Vector2d> const extremes{
+      geo::Vector2d(1e308, 0.0), geo::Vector2d(-1e308, 0.0), geo::Vector2d(0.0, 0.0), geo::Vector2d(-1e307, 0.0)};
+    expect(std::ranges::equal(geo::spatial_order(extremes, geo::space_filling_curve::morton), std::vector<std::size_t>{1, 3, 2, 0}));
+    std::vector<geo::Vector2d> const infinite{
+      geo::Vector2d(std::numeric_limits<double>::infinity(), 1.0), geo::Vector2d(0.0, 2.0), geo::Vector2d(0.5, 0.0)};
+    auto infinite_order = geo::spatial_order(infinite);
+    std::ranges::sort(infinite_order);
+    expect(std::ranges::equal(infinite_order, std::vector<std::size_t>{0, 1, 2}));
+  };
+
+  "DynamicBvh insert, remove, update and refit"_test = [] {
+    using geo::Vector2d;
+    using Circle = geo::Circle<Vector2d>;
+
+    constexpr geo::Line<Vector2d> line(Vector2d(2.0, -1.0), Vector2d(0.0, 3.0));
+    static_assert(geo::bounding_box(line).lower.x == 0.0 && geo::bounding_box(line).upper.y == 3.0);
+    std::array const ctrls{Vector2d(0.0, 0.0), Vector2d(1.0, 4.0), Vector2d(2.0, 0.0)};
+    auto const curve_box = geo::bounding_box(geo::Bezier<2, Vector2d>(ctrls.cbegin(), ctrls.cend()));
+    expect(curve_box.upper.y == 4.0 && geo::contains(curve_box, geo::bounding_box(line)) == false);
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    geo::DynamicBvh<Circle> bvh(0.01);
+    std::vector<Circle> circles;
+    std::vector<std::size_t> handles;
+    for (std::size_t i = 0; i < 2000; ++i) {
+      circles.emplace_back(Vector2d(100.0 * unit(generator), 100.0 * unit(generator)), unit(generator));
+      handles.push_back(bvh.insert(circles.back()));
+    }
+    expect(bvh.size() == 2000_ul);
+    expect(bvh.height() < 40_ul);
+
+    auto const matches_brute_force = [&](geo::Box<Vector2d> const & box) {
+      std::vector<std::size_t> found;
+      bvh.query(box, [&](std::size_t h) { found.push_back(h); });
+      std::ranges::sort(found);
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < circles.size(); ++i) {
+        if (bvh.contains(handles[i]) && geo::intersects(bvh.fat_box(handles[i]), box)) {
+          expected.push_back(handles[i]);
+        }
+        if (bvh.contains(handles[i]) && geo::intersects(geo::bounding_box(circles[i]), box)
+            && std::ranges::find(found, handles[i]) == found.end()) {
+          return false;
+        }
+      }
+      return std::ranges::equal(found, expected);
+    };
+    geo::Box<Vector2d> const window(Vector2d(20.0, 30.0), Vector2d(45.0, 50.0));
+    expect(matches_brute_force(window));
+
+    /* motion within the margin leaves the tree alone */
+    bvh[handles[0]].center.x += 0.005;
+    expect(bvh.refit() == 0_ul);
+    expect(!bvh.update(handles[1], Circle(circles[1].center, circles[1].radius + 0.005)));
+
+    /* everything drifts, refit in parallel */
+    double const cost = bvh.cost();
+    for (std::size_t i = 0; i < circles.size(); ++i) {
+      circles[i].center = circles[i].center + Vector2d(unit(generator) - 0.5, unit(generator) - 0.5);
+      bvh[handles[i]] = circles[i];
+    }
+    expect(bvh.refit(geo::execution::par) > 1900_ul);
+    expect(matches_brute_force(window));
+    expect(bvh.cost() < 1.5 * cost);
+
+    /* a far jump reinserts, removed handles are reused */
+    circles[2].center = Vector2d(500.0, 500.0);
+    expect(bvh.update(handles[2], circles[2]));
+    expect(matches_brute_force(geo::Box<Vector2d>(Vector2d(499.0, 499.0), Vector2d(501.0, 501.0))));
+    for (std::size_t i = 0; i < circles.size(); i += 2) {
+      bvh.remove(handles[i]);
+    }
+    expect(bvh.size() == 1000_ul);
+    expect(matches_brute_force(window));
+    expect(bvh.insert(circles[0]) == handles[1998]);
+    expect(throws<std::invalid_argument>([&] { bvh.remove(handles[2]); }));
+
+    std::size_t visited = 0;
+    bvh.query(geo::Box<Vector2d>(Vector2d(-10.0, -10.0), Vector2d(200.0, 200.0)), [&](std::size_t) { return ++visited < 10; });
+    expect(visited == 10_ul);
+
+    geo::DynamicBvh<geo::Bezier<2, Vector2d>> curves;
+    auto const curve = curves.insert(geo::Bezier<2, Vector2d>(ctrls.cbegin(), ctrls.cend()));
+    curves.query(geo::Box<Vector2d>(Vector2d(1.0, 3.0), Vector2d(1.0, 3.0)), [&](std::size_t h) { expect(h == curve); });
+  };
+
+  "sweep and prune pair events"_test = [] {
+    using geo::Vector2d;
+    using Circle = geo::Circle<Vector2d>;
+    using Pair = std::pair<std::size_t, std::size_t>;
+
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Circle> circles;
+    for (std::size_t i = 0; i < 400; ++i) {
+      circles.emplace_back(Vector2d(40.0 * unit(generator), 40.0 * unit(generator)), 0.2 + unit(generator));
+    }
+
+    auto const check = [&]<typename Broadphase>(Broadphase broadphase, auto policy) {
+      std::vector<std::size_t> handles;
+      std::set<Pair> pairs;
+      bool consistent = true;
+      auto const on_add = [&](std::size_t a, std::size_t b) { consistent = consistent && a < b && pairs.emplace(a, b).second; };
+      auto const on_remove = [&](std::size_t a, std::size_t b) { consistent = consistent && pairs.erase({a, b}) == 1; };
+      auto const brute_force = [&] {
+        std::set<Pair> expected;
+        for (std::size_t i = 0; i < handles.size(); ++i) {
+          for (std::size_t j = i + 1; j < handles.size(); ++j) {
+            if (broadphase.contains(handles[i]) && broadphase.contains(handles[j])
+                && geo::intersects(geo::bounding_box(broadphase[handles[i]]), geo::bounding_box(broadphase[handles[j]]))) {
+              expected.insert(std::minmax(handles[i], handles[j]));
+            }
+          }
+        }
+        return expected;
+      };
+
+      for (auto const & circle : circles) {
+        handles.push_back(broadphase.insert(circle));
+      }
+      broadphase.update(policy, on_add, on_remove);
+      consistent = consistent && pairs == brute_force() && broadphase.pair_count() == pairs.size();
+
+      for (std::size_t frame = 0; frame < 6; ++frame) {
+        for (std::size_t const h : handles) {
+          if (broadphase.contains(h)) {
+            broadphase[h].center = broadphase[h].center + Vector2d(unit(generator) - 0.5, unit(generator) - 0.5);
+          }
+        }
+        if (frame == 2) {
+          for (std::size_t i = 0; i < handles.size(); i += 3) {
+            broadphase.remove(handles[i]);
+          }
+          /* removed handles are not reused before the next update */
+          handles.push_back(broadphase.insert(circles[0]));
+          consistent = consistent && handles.back() == circles.size();
+        }
+        broadphase.update(policy, on_add, on_remove);
+        consistent = consistent && pairs == brute_force() && broadphase.pair_count() == pairs.size();
+      }
+      return consistent;
+    };
+
+    expect(check(geo::SweepAndPrune<Circle>(), geo::execution::seq));
+    expect(check(geo::SweepAndPrune<Circle>(1), geo::execution::par));
+    expect(check(geo::MultiAxisSweepAndPrune<Circle>(), geo::execution::seq));
+    expect(check(geo::MultiAxisSweepAndPrune<Circle>(), geo::execution::par));
+    expect(throws<std::invalid_argument>([] { geo::SweepAndPrune<Circle> broadphase(2); }));
+
+    geo::MultiAxisSweepAndPrune<geo::Line<geo::Vector3d>> lines;
+    auto const a = lines.insert(geo::Line<geo::Vector3d>(geo::Vector3d(0.0, 0.0, 0.0), geo::Vector3d(1.0, 1.0, 1.0)));
+    auto const b = lines.insert(geo::Line<geo::Vector3d>(geo::Vector3d(1.0, 2.0, 0.5), geo::Vector3d(3.0, 3.0, 3.0)));
+    std::size_t count = 0;
+    lines.update([&](std::size_t, std::size_t) { ++count; }, [&](std::size_t, std::size_t) { --count; });
+    expect(count == 0_ul);
+    lines[b].start.y = 1.0;
+    lines.update([&](std::size_t x, std::size_t y) { count += (x == a && y == b) ? 1 : 0; }, [&](std::size_t, std::size_t) { --count; });
+    expect(count == 1_ul);
+  };
+
+  "min_enclosing_circle and fit_circle"_test = [] {
+    using geo::Vector2d;
+    using Circle = geo::Circle<Vector2d>;
+
+    std::vector<Vector2d> const square{Vector2d(0.0, 0.0), Vector2d(2.0, 0.0), Vector2d(1.0, 1.0), Vector2d(2.0, 2.0), Vector2d(0.0, 2.0)};
+    auto const enclosing = geo::min_enclosing_circle(square);
+    expect(std::abs(enclosing.center.x - 1.0) < 1e-12 && std::abs(enclosing.center.y - 1.0) < 1e-12);
+    expect(std::abs(enclosing.radius - std::sqrt(2.0)) < 1e-12);
+    expect(geo::min_enclosing_circle(std::vector{Vector2d(3.0, 4.0)}).radius == 0.0);
+    expect(throws<std::invalid_argument>([] { static_cast<void>(geo::min_enclosing_circle(std::vector<Vector2d>{})); }));
+
+    /* duplicates far from the origin, where the rounding of the center once
+     * let a duplicate rebuild the circle without an earlier boundary point */
+    std::vector<Vector2d> const far{
+      Vector2d(500800.0, 700.0), Vector2d(499600.0, 200.0), Vector2d(500700.0, -300.0), Vector2d(499700.0, 200.0),
+      Vector2d(500400.0, -100.0), Vector2d(499100.0, 400.0), Vector2d(499900.0, 200.0), Vector2d(499300.0, 100.0),
+      Vector2d(499700.0, 0.0), Vector2d(500800.0, 700.0), Vector2d(500900.0, -400.0)
+    };
+    auto const far_circle = geo::min_enclosing_circle(far);
+    for (auto const & point : far) {
+      expect(geo::distance(point, far_circle.center) <= far_circle.radius * (1.0 + 1e-12));
+    }
+    expect(far_circle.radius < 989.0);
+
+    /* clusters of random points, one of them collinear with duplicates */
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Vector2d> points;
+    std::vector<std::size_t> offsets{0};
+    for (std::size_t c = 0; c < 300; ++c) {
+      std::size_t const size = 1 + c % 40;
+      for (std::size_t i = 0; i < size; ++i) {
+        points.emplace_back(c == 7 ? Vector2d(static_cast<double>(i % 5), 2.0 * static_cast<double>(i % 5)) : Vector2d(10.0 * unit(generator), 10.0 * unit(generator)));
+      }
+      offsets.push_back(points.size());
+    }
+    std::vector<Circle> sequenced;
+    std::vector<Circle> parallel;
+    geo::min_enclosing_circle(points, offsets, std::back_inserter(sequenced));
+    geo::min_enclosing_circle(geo::execution::par, points, offsets, std::back_inserter(parallel));
+    expect(sequenced.size() == 300_ul);
+    bool minimal = true;
+    for (std::size_t c = 0; c < 300; ++c) {
+      auto const & circle = sequenced[c];
+      minimal = minimal && circle.center.x == parallel[c].center.x && circle.radius == parallel[c].radius;
+      /* encloses all points, and at least two of them lie on it */
+      std::size_t on_circle = 0;
+      for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+        double const d = geo::distance(points[i], circle.center);
+        minimal = minimal && d <= circle.radius * (1.0 + 1e-9);
+        on_circle += d >= circle.radius * (1.0 - 1e-9) ? 1 : 0;
+      }
+      minimal = minimal && (on_circle >= 2 || offsets[c + 1] - offsets[c] == 1);
+    }
+    expect(minimal);
+    expect(std::abs(sequenced[7].radius - std::sqrt(80.0) / 2.0) < 1e-12);
+
+    /* exact points give the circle back, a short noisy arc favors Pratt */
+    std::vector<Vector2d> arc;
+    std::normal_distribution<double> noise(0.0, 0.05);
+    for (std::size_t i = 0; i < 200; ++i) {
+      double const angle = 0.6 * static_cast<double>(i) / 200.0;
+      arc.emplace_back(3.0 + 10.0 * std::cos(angle) + noise(generator), -1.0 + 10.0 * std::sin(angle) + noise(generator));
+    }
+    std::vector<Vector2d> exact;
+    for (std::size_t i = 0; i < 5; ++i) {
+      exact.emplace_back(3.0 + 2.0 * std::cos(static_cast<double>(i)), -1.0 + 2.0 * std::sin(static_cast<double>(i)));
+    }
+    for (auto const method : {geo::circle_fit_method::pratt, geo::circle_fit_method::kasa}) {
+      auto const fitted = geo::fit_circle(exact, method);
+      expect(std::abs(fitted.center.x - 3.0) < 1e-9 && std::abs(fitted.center.y + 1.0) < 1e-9 && std::abs(fitted.radius - 2.0) < 1e-9);
+    }
+    auto const pratt = geo::fit_circle(arc);
+    auto const kasa = geo::fit_circle(arc, geo::circle_fit_method::kasa);
+    expect(std::abs(pratt.radius - 10.0) < std::abs(kasa.radius - 10.0));
+    expect(std::abs(pratt.radius - 10.0) < 1.0);
+
+    std::vector<Circle> fitted;
+    std::vector<std::size_t> const arcs{0, 100, 200};
+    geo::fit_circle(geo::execution::par, arc, arcs, std::back_inserter(fitted), geo::circle_fit_method::kasa);
+    expect(fitted.size() == 2_ul && fitted[1].radius == geo::fit_circle(std::span(arc).subspan(100), geo::circle_fit_method::kasa).radius);
+    expect(throws<std::invalid_argument>([&] { static_cast<void>(geo::fit_circle(std::span(arc).first(2))); }));
+    expect(throws<std::invalid_argument>([] {
+      static_cast<void>(geo::fit_circle(std::vector{Vector2d(0.0, 0.0), Vector2d(1.0, 1.0), Vector2d(2.0, 2.0)}));
+    }));
+  };
+
+  "point cloud downsampling, welding and normals"_test = [] {
+    using geo::Vector3d;
+
+    /* a noisy sheet on the plane z = 0.5 x, sampled four times per voxel */
+    std::mt19937 generator(13);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Vector3d> sheet;
+    for (std::size_t i = 0; i < 20000; ++i) {
+      double const x = 4.0 * unit(generator), y = 4.0 * unit(generator);
+      sheet.emplace_back(x, y, 0.5 * x + 1e-4 * (unit(generator) - 0.5));
+    }
+
+    std::vector<Vector3d> thinned;
+    std::vector<Vector3d> thinned_parallel;
+    geo::voxel_downsample(sheet, 0.25, std::back_inserter(thinned));
+    geo::voxel_downsample(geo::execution::par, sheet, 0.25, std::back_inserter(thinned_parallel));
+    expect(thinned.size() > 200_ul && thinned.size() < 600_ul);
+    expect(thinned.size() == thinned_parallel.size());
+    bool on_sheet = true;
+    for (std::size_t i = 0; i < thinned.size(); ++i) {
+      on_sheet = on_sheet && std::abs(thinned[i].z - 0.5 * thinned[i].x) < 1e-3;
+      on_sheet = on_sheet && geo::distance(thinned[i], thinned_parallel[i]) < 1e-12;
+    }
+    expect(on_sheet);
+    std::vector<Vector3d> single;
+    geo::voxel_downsample(std::vector{Vector3d(1.0, 2.0, 3.0), Vector3d(1.2, 2.0, 3.0)}, 1.0, std::back_inserter(single));
+    expect(single.size() == 1_ul && std::abs(single[0].x - 1.1) < 1e-12);
+    expect(throws<std::invalid_argument>([&] { geo::voxel_downsample(sheet, 0.0, std::back_inserter(single)); }));
+
+    /* each point once more, a little off; welding keeps the originals */
+    std::vector<Vector3d> doubled = sheet;
+    for (auto const & p : sheet) {
+      doubled.emplace_back(p.x + 1e-7, p.y - 1e-7, p.z);
+    }
+    std::vector<Vector3d> kept;
+    auto const remap = geo::weld(doubled, 1e-6, std::back_inserter(kept));
+    expect(kept.size() == sheet.size());
+    expect(remap.size() == doubled.size() && remap[sheet.size() + 17] == remap[17] && remap[17] == 17_ul);
+    std::vector<Vector3d> kept_parallel;
+    expect(std::ranges::equal(geo::weld(geo::execution::par, doubled, 1e-6, std::back_inserter(kept_parallel)), remap));
+
+    /* greedy: the chain 0, 0.6, 1.2 with epsilon 1 keeps both ends, and 0.7
+     * near both joins the earlier one */
+    std::vector<geo::Vector2d> chain{
+      geo::Vector2d(0.0, 0.0), geo::Vector2d(0.6, 0.0), geo::Vector2d(1.2, 0.0), geo::Vector2d(0.7, 0.0)};
+    std::vector<geo::Vector2d> chain_kept;
+    expect(std::ranges::equal(geo::weld(chain, 1.0, std::back_inserter(chain_kept)), std::vector<std::size_t>{0, 0, 1, 0}));
+    expect(chain_kept.size() == 2_ul && chain_kept[1].x == 1.2);
+
+    std::vector<Vector3d> normals;
+    geo::estimate_normals(geo::execution::par, sheet, 12, std::back_inserter(normals));
+    expect(normals.size() == sheet.size());
+    Vector3d const expected = geo::normalize(Vector3d(-0.5, 0.0, 1.0));
+    bool aligned = true;
+    for (auto const & normal : normals) {
+      aligned = aligned && std::abs(std::abs(geo::dot_product(normal, expected)) - 1.0) < 1e-3;
+    }
+    expect(aligned);
+    std::vector<Vector3d> normals_sequenced;
+    geo::estimate_normals(sheet, 12, std::back_inserter(normals_sequenced));
+    expect(std::abs(geo::dot_product(normals[99], normals_sequenced[99])) > 1.0 - 1e-12);
+    expect(throws<std::invalid_argument>([&] { geo::estimate_normals(sheet, 2, std::back_inserter(normals)); }));
+
+    /* distant outliers stretch the grid far beyond the sheet; their own
+     * searches end in a scan instead of crossing thousands of empty rings */
+    std::vector<Vector3d> scanned = sheet;
+    scanned.emplace_back(100.0, 100.0, 0.0);
+    scanned.emplace_back(-50.0, 20.0, 10.0);
+    std::vector<Vector3d> scanned_normals;
+    geo::estimate_normals(scanned, 12, std::back_inserter(scanned_normals));
+    bool unchanged = true;
+    for (std::size_t i = 0; i < sheet.size(); i += 97) {
+      unchanged = unchanged && std::abs(geo::dot_product(scanned_normals[i], normals_sequenced[i])) > 1.0 - 1e-9;
+    }
+    expect(unchanged);
+    expect(std::abs(geo::norm(scanned_normals.back()) - 1.0) < 1e-9);
+
+    /* a circle in 2D: normals point to the center */
+    std::vector<geo::Vector2d> ring;
+    for (std::size_t i = 0; i < 360; ++i) {
+      double const angle = static_cast<double>(i) * std::numbers::pi / 180.0;
+      ring.emplace_back(std::cos(angle), std::sin(angle));
+    }
+    std::vector<geo::Vector2d> ring_normals;
+    geo::estimate_normals(ring, 5, std::back_inserter(ring_normals));
+    expect(std::abs(std::abs(geo::dot_product(ring_normals[40], ring[40])) - 1.0) < 1e-6);
+  };
+
+  "fit_beziers compresses polylines"_test = [] {
+    using geo::Vector2d;
+    using Cubic = geo::Bezier<3, Vector2d>;
+
+    /* within tolerance of the curves: every point near a curve, the nearest
+     * parameter found on a coarse sample and refined by ternary search on
+     * the curves that may come close */
+    auto const within = [](auto const & points, auto const & curves, double tolerance) {
+      std::vector<std::vector<std::ranges::range_value_t<decltype(points)>>> samples(curves.size());
+      std::vector<double> spacings(curves.size());
+      for (std::size_t c = 0; c < curves.size(); ++c) {
+        for (std::size_t i = 0; i <= 100; ++i) {
+          samples[c].push_back(geo::evaluate_at(curves[c], static_cast<double>(i) / 100.0));
+          spacings[c] = i == 0 ? 0.0 : std::max(spacings[c], geo::distance(samples[c][i - 1], samples[c][i]));
+        }
+      }
+      for (auto const & p : points) {
+        double nearest = std::numeric_limits<double>::max();
+        for (std::size_t c = 0; c < curves.size(); ++c) {
+          /* the curve lies in the box of its control points */
+          if (!geo::intersects(geo::detail::inflate(geo::bounding_box(curves[c]), tolerance), geo::bounding_box(p))) {
+            continue;
+          }
+          auto const closest = std::ranges::min_element(samples[c], {}, [&](auto const & s) { return geo::distance(s, p); });
+          if (geo::distance(*closest, p) > tolerance + spacings[c]) {
+            continue;
+          }
+          auto const at = [&](double t) { return geo::distance(geo::evaluate_at(curves[c], std::clamp(t, 0.0, 1.0)), p); };
+          double const t = static_cast<double>(closest - samples[c].begin()) / 100.0;
+          double low = t - 0.01, high = t + 0.01;
+          for (int iteration = 0; iteration < 60; ++iteration) {
+            double const a = low + (high - low) / 3.0, b = high - (high - low) / 3.0;
+            if (at(a) < at(b)) {
+              high = b;
+            } else {
+              low = a;
+            }
+          }
+          nearest = std::min({nearest, geo::distance(*closest, p), at((low + high) / 2.0)});
+        }
+        if (nearest > tolerance) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    /* a smooth curve, sampled unevenly, needs only a few */
+    std::array const ctrls{Vector2d(0.0, 0.0), Vector2d(1.0, 3.0), Vector2d(4.0, 3.0), Vector2d(5.0, 0.0)};
+    Cubic const cubic(ctrls.cbegin(), ctrls.cend());
+    std::vector<Vector2d> sampled;
+    for (std::size_t i = 0; i <= 100; ++i) {
+      double const t = static_cast<double>(i) / 100.0;
+      sampled.push_back(geo::evaluate_at(cubic, t * t * (3.0 - 2.0 * t)));
+    }
+    std::vector<Cubic> smooth;
+    geo::fit_beziers(sampled, 0.01, std::back_inserter(smooth));
+    expect(!smooth.empty() && smooth.size() < 10_ul && within(sampled, smooth, 0.01 + 1e-9));
+    expect(geo::distance(smooth.front().ctrls[0], ctrls[0]) == 0.0 && geo::distance(smooth.back().ctrls[3], ctrls[3]) == 0.0);
+
+    /* a noisy spiral needs several, joined with matching tangents */
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<double> noise(-0.002, 0.002);
+    std::vector<Vector2d> spiral;
+    for (std::size_t i = 0; i < 2000; ++i) {
+      double const angle = 0.01 * static_cast<double>(i);
+      double const radius = 1.0 + 0.2 * angle;
+      spiral.emplace_back(radius * std::cos(angle) + noise(generator), radius * std::sin(angle) + noise(generator));
+    }
+    std::vector<Cubic> curves;
+    geo::fit_beziers(spiral, 0.01, std::back_inserter(curves));
+    expect(curves.size() > 3_ul && curves.size() < 100_ul);
+    expect(within(spiral, curves, 0.01 + 1e-9));
+    bool joined = true;
+    for (std::size_t c = 1; c < curves.size(); ++c) {
+      auto const in = curves[c - 1].ctrls[3] - curves[c - 1].ctrls[2];
+      auto const out = curves[c].ctrls[1] - curves[c].ctrls[0];
+      joined = joined && geo::distance(curves[c - 1].ctrls[3], curves[c].ctrls[0]) == 0.0;
+      joined = joined && std::abs(in.x * out.y - in.y * out.x) <= 1e-9 * geo::norm(in) * geo::norm(out);
+    }
+    expect(joined);
+
+    /* quintics in 3D, and many polylines at once */
+    std::vector<geo::Vector3d> helix;
+    for (std::size_t i = 0; i < 500; ++i) {
+      double const angle = 0.02 * static_cast<double>(i);
+      helix.emplace_back(std::cos(angle), std::sin(angle), 0.1 * angle);
+    }
+    std::vector<geo::Bezier<5, geo::Vector3d>> quintics;
+    geo::fit_beziers<5>(helix, 1e-4, std::back_inserter(quintics));
+    expect(!quintics.empty() && within(helix, quintics, 1e-4 + 1e-9));
+
+    std::vector<Vector2d> batch = spiral;
+    batch.insert(batch.end(), sampled.begin(), sampled.end());
+    batch.emplace_back(7.0, 7.0);
+    std::vector<std::size_t> const offsets{0, spiral.size(), spiral.size() + sampled.size(), batch.size()};
+    std::vector<Cubic> batched;
+    auto const curve_offsets = geo::fit_beziers(geo::execution::par, batch, offsets, 0.01, std::back_inserter(batched));
+    expect(std::ranges::equal(curve_offsets, std::vector<std::size_t>{0, curves.size(), curves.size() + smooth.size(), curves.size() + smooth.size()}));
+    expect(geo::distance(batched[5].ctrls[1], curves[5].ctrls[1]) == 0.0);
+
+    /* degenerate input */
+    std::vector<Cubic> few;
+    geo::fit_beziers(std::vector{Vector2d(1.0, 1.0)}, 0.1, std::back_inserter(few));
+    expect(few.empty());
+    geo::fit_beziers(std::vector{Vector2d(1.0, 1.0), Vector2d(1.0, 1.0), Vector2d(1.0, 1.0), Vector2d(4.0, 5.0)}, 0.1, std::back_inserter(few));
+    expect(few.size() == 1_ul && geo::distance(few[0].ctrls[1], Vector2d(2.0, 7.0 / 3.0)) < 1e-12);
+    expect(throws<std::invalid_argument>([&] { geo::fit_beziers(spiral, -1.0, std::back_inserter(few)); }));
+  };
+
+  "elevate, reduce and normalize_degree"_test = [] {
+    using geo::Vector2d;
+
+    /* elevation is exact and usable in constant expressions */
+    constexpr std::array quadratic_ctrls{Vector2d(0.0, 0.0), Vector2d(1.0, 2.0), Vector2d(3.0, 0.0)};
+    constexpr geo::InlineBezier<2, Vector2d> quadratic(quadratic_ctrls.cbegin(), quadratic_ctrls.cend());
+    constexpr auto cubic = geo::elevate<3>(quadratic);
+    static_assert(std::is_same_v<decltype(cubic), geo::InlineBezier<3, Vector2d> const>);
+    static_assert(cubic.ctrls[1].x == 2.0 / 3.0 && cubic.ctrls[2].y == 4.0 / 3.0);
+    auto const quintic = geo::elevate<5>(geo::Bezier<2, Vector2d>(quadratic_ctrls.cbegin(), quadratic_ctrls.cend()));
+    for (double t = 0.0; t <= 1.0; t += 0.125) {
+      expect(geo::distance(geo::evaluate_at(quintic, t), geo::evaluate_at(quadratic, t)) < 1e-15);
+    }
+
+    /* reducing an elevated curve gives it back; otherwise the error bound
+     * holds and is close */
+    auto const [back, exact] = geo::reduce<2>(quintic);
+    expect(exact < 1e-14 && geo::distance(back.ctrls[1], quadratic_ctrls[1]) < 1e-14);
+    std::array const quartic_ctrls{Vector2d(0.0, 0.0), Vector2d(1.0, 3.0), Vector2d(2.0, -1.0), Vector2d(3.0, 2.0), Vector2d(4.0, 0.0)};
+    geo::Bezier<4, Vector2d, std::array<Vector2d, 5>> const quartic(quartic_ctrls);
+    auto const reduced = geo::reduce<3>(quartic);
+    static_assert(std::is_same_v<decltype(reduced.bezier), geo::Bezier<3, Vector2d, std::array<Vector2d, 4>>>);
+    double farthest = 0.0;
+    for (std::size_t i = 0; i <= 1000; ++i) {
+      double const t = static_cast<double>(i) / 1000.0;
+      farthest = std::max(farthest, geo::distance(geo::evaluate_at(quartic, t), geo::evaluate_at(reduced.bezier, t)));
+    }
+    expect(reduced.error >= farthest && reduced.error < 1.05 * farthest);
+    expect(geo::distance(reduced.bezier.ctrls[0], quartic_ctrls[0]) == 0.0 && geo::distance(reduced.bezier.ctrls[3], quartic_ctrls[4]) == 0.0);
+
+    /* path segments of mixed degree in one batch, in order */
+    using Segment = std::variant<geo::Line<Vector2d>, geo::InlineBezier<2, Vector2d>, geo::Bezier<4, Vector2d, std::array<Vector2d, 5>>>;
+    std::vector<Segment> const path{geo::Line<Vector2d>(Vector2d(3.0, 0.0), Vector2d(0.0, 0.0)), quadratic, quartic};
+    geo::BezierBatch<3, double, 2> batch;
+    double const error = geo::normalize_degree(path, batch);
+    expect(batch.size() == 3_ul && error == reduced.error);
+    expect(geo::distance(batch.ctrl<Vector2d>(0, 1), Vector2d(2.0, 0.0)) < 1e-15);
+    expect(geo::distance(batch.ctrl<Vector2d>(1, 2), cubic.ctrls[2]) == 0.0);
+    expect(geo::distance(batch.ctrl<Vector2d>(2, 2), reduced.bezier.ctrls[2]) == 0.0);
+    expect(geo::normalize_degree(std::vector{quadratic, quadratic}, batch) == 0.0 && batch.size() == 5_ul);
+  };
+
+  "ray casts"_test = [] {
+    using geo::Vector2d;
+    using Ray = geo::Ray<Vector2d>;
+    using Quadratic = geo::Bezier<2, Vector2d, std::array<Vector2d, 3>>;
+
+    /* single rays; t is in units of the direction */
+    geo::Circle<Vector2d> const circle(Vector2d(0.0, 0.0), 1.0);
+    expect(geo::raycast(Ray(Vector2d(-5.0, 0.0), Vector2d(2.0, 0.0)), circle) == std::optional(2.0));
+    expect(geo::raycast(Ray(Vector2d(0.5, 0.0), Vector2d(1.0, 0.0)), circle) == std::optional(0.5));
+    expect(!geo::raycast(Ray(Vector2d(-5.0, 0.0), Vector2d(-1.0, 0.0)), circle));
+    geo::Circle<geo::Vector3d> const sphere(geo::Vector3d(0.0, 0.0, 3.0), 1.0);
+    expect(geo::raycast(geo::Ray<geo::Vector3d>(geo::Vector3d(0.0, 0.0, 0.0), geo::Vector3d(0.0, 0.0, 1.0)), sphere) == std::optional(2.0));
+    geo::Line<Vector2d> const line(Vector2d(0.0, -1.0), Vector2d(0.0, 1.0));
+    expect(geo::raycast(Ray(Vector2d(-2.0, 0.5), Vector2d(1.0, 0.0)), line) == std::optional(2.0));
+    expect(!geo::raycast(Ray(Vector2d(0.0, -2.0), Vector2d(0.0, 1.0)), line));
+    Quadratic const arch(std::array{Vector2d(-1.0, 0.0), Vector2d(0.0, 2.0), Vector2d(1.0, 0.0)});
+    auto const top = geo::raycast(Ray(Vector2d(0.0, -1.0), Vector2d(0.0, 1.0)), arch);
+    expect(top && std::abs(*top - 2.0) < 1e-6);
+    auto const side = geo::raycast(Ray(Vector2d(-2.0, 0.75), Vector2d(1.0, 0.0)), arch);
+    expect(side && std::abs(*side - 1.5) < 1e-6);
+    expect(!geo::raycast(Ray(Vector2d(0.0, 1.5), Vector2d(0.0, 1.0)), arch));
+
+    /* packets agree with single rays, unused lanes miss */
+    std::vector<Ray> const rays{Ray(Vector2d(0.0, -1.0), Vector2d(0.0, 1.0)), Ray(Vector2d(-2.0, 0.75), Vector2d(1.0, 0.0)),
+                                Ray(Vector2d(0.5, -1.0), Vector2d(-0.1, 1.0))};
+    geo::RayPacket<Vector2d, 4> packet(rays);
+    auto const hits = geo::raycast(packet, arch);
+    auto const circle_hits = geo::raycast(packet, circle);
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      expect(hits[i] == *geo::raycast(rays[i], arch));
+      expect(circle_hits[i] == *geo::raycast(rays[i], circle));
+    }
+    expect(std::isinf(hits[3]) && std::isinf(circle_hits[3]));
+    packet.push_back(rays[0]);
+    expect(throws<std::length_error>([&] { packet.push_back(rays[0]); }));
+
+    geo::BezierPacket<Quadratic, 4> arches;
+    geo::LinePacket<geo::Line<Vector2d>, 4> lines;
+    for (double offset : {0.0, 0.25, 4.0}) {
+      arches.push_back(Quadratic(std::array{Vector2d(-1.0, offset), Vector2d(0.0, 2.0 + offset), Vector2d(1.0, offset)}));
+      lines.push_back(geo::Line<Vector2d>(Vector2d(-1.0, offset), Vector2d(1.0, offset)));
+    }
+    auto const arch_hits = geo::raycast(rays[0], arches);
+    auto const line_hits = geo::raycast(rays[0], lines);
+    expect(std::abs(arch_hits[0] - 2.0) < 1e-6 && std::abs(arch_hits[1] - 2.25) < 1e-6 && std::abs(arch_hits[2] - 6.0) < 1e-6);
+    expect(line_hits[0] == 1.0 && line_hits[1] == 1.25 && line_hits[2] == 5.0 && std::isinf(line_hits[3]));
+
+    /* nearest objects in a DynamicBvh, a row of packed rays against a grid */
+    geo::DynamicBvh<geo::Circle<Vector2d>> bvh(0.05);
+    std::vector<geo::Circle<Vector2d>> circles;
+    for (std::size_t i = 0; i < 100; ++i) {
+      circles.emplace_back(Vector2d(static_cast<double>(i % 10), static_cast<double>(i / 10)), 0.2 + 0.02 * static_cast<double>(i % 7));
+      bvh.insert(circles.back());
+    }
+    geo::RayPacket<Vector2d, 16> row;
+    for (std::size_t i = 0; i < 16; ++i) {
+      row.push_back(Ray(Vector2d(-1.0, 0.6 * static_cast<double>(i)), Vector2d(1.0, 0.05)));
+    }
+    auto const nearest = geo::raycast(bvh, row);
+    for (std::size_t i = 0; i < 16; ++i) {
+      Ray const ray(Vector2d(-1.0, 0.6 * static_cast<double>(i)), Vector2d(1.0, 0.05));
+      geo::RayHit<double> expected;
+      for (std::size_t j = 0; j < circles.size(); ++j) {
+        if (auto const t = geo::raycast(ray, circles[j]); t && *t < expected.t) {
+          expected = {*t, j};
+        }
+      }
+      auto const single = geo::raycast(bvh, ray);
+      expect(single.object == expected.object && single.t == expected.t);
+      expect(nearest[i].object == expected.object && nearest[i].t == expected.t);
+    }
+    expect(geo::raycast(bvh, Ray(Vector2d(-1.0, 0.0), Vector2d(-1.0, 0.0))).object == bvh.none);
+  };
+
+  "interval arithmetic"_test = [] {
+    using Exact = geo::Interval<double>;
+    using Fast = geo::Interval<double, geo::policy::fast>;
+
+    /* outward rounding keeps the exact result, to nearest does not */
+    constexpr Exact sum = Exact(0.1) + Exact(0.2);
+    static_assert(sum.lower < 0.1 + 0.2 && sum.upper > 0.1 + 0.2);
+    static_assert((Fast(0.1) + Fast(0.2)) == Fast(0.1 + 0.2));
+    expect(sum.upper <= std::nextafter(std::nextafter(0.1 + 0.2, 1.0), 1.0) && sum.lower >= std::nextafter(std::nextafter(0.1 + 0.2, 0.0), 0.0));
+    constexpr Exact tiny = Exact(std::numeric_limits<double>::denorm_min()) * Exact(0.5);
+    static_assert(tiny.lower < 0.0 && tiny.upper > 0.0);
+
+    /* signs, division through zero, square and sqrt */
+    expect(Fast(-1.0, 2.0) * Fast(-3.0, 4.0) == Fast(-6.0, 8.0));
+    auto const product = Exact(-1.0, 2.0) * Exact(-3.0, 4.0);
+    expect(product.contains(-6.0) && product.contains(8.0) && product.width() < 14.0 + 1e-14);
+    expect(Fast(1.0, 2.0) / Fast(-4.0, -2.0) == Fast(-1.0, -0.25));
+    expect(std::isinf((Exact(1.0) / Exact(-1.0, 1.0)).upper));
+    expect(geo::square(Fast(-2.0, 1.0)) == Fast(0.0, 4.0) && Fast(-2.0, 1.0) * Fast(-2.0, 1.0) == Fast(-2.0, 4.0));
+    auto const root = geo::sqrt(Exact(2.0));
+    expect(root.contains(std::sqrt(2.0)) && root.width() > 0.0 && root.width() < 1e-15);
+    expect(geo::hull(Fast(1.0, 2.0), Fast(4.0)) == Fast(1.0, 4.0) && !geo::intersects(Fast(1.0, 2.0), Fast(2.5, 3.0)));
+    expect(throws<std::invalid_argument>([] { static_cast<void>(Exact(2.0, 1.0)); }));
+
+    /* a Bezier over interval points encloses the curve over an interval of
+     * parameters, enough to rule out a point without subdividing */
+    using Point = geo::Vector2x<Exact>;
+    std::array const ctrls{geo::Vector2d(0.0, 0.0), geo::Vector2d(1.0, 2.0), geo::Vector2d(2.0, -1.0), geo::Vector2d(3.0, 0.5)};
+    geo::Bezier<3, geo::Vector2d, std::array<geo::Vector2d, 4>> const curve(ctrls);
+    geo::Bezier<3, Point, std::array<Point, 4>> enclosing;
+    std::ranges::transform(ctrls, enclosing.ctrls.begin(), [](auto const & p) { return Point(p.x, p.y); });
+    auto const part = geo::evaluate_at(enclosing, Exact(0.25, 0.375));
+    for (double t = 0.25; t <= 0.375; t += 1.0 / 1024.0) {
+      auto const p = geo::evaluate_at(curve, t);
+      expect(part.x.contains(p.x) && part.y.contains(p.y));
+    }
+    expect(!part.y.contains(-0.5) && !geo::intersects(part.x, Exact(2.0, 3.0)));
+    auto const norm = geo::norm(Point(3.0, 4.0));
+    expect(norm.contains(5.0) && norm.width() < 1e-14);
+  };
+
+  "quaternion rotations and slerp"_test = [] {
+    using geo::Quaterniond;
+    using geo::Vector3d;
+    constexpr auto epsilon = 10 * std::numeric_limits<double>::epsilon();
+
+    /* agrees with the Rodrigues matrix, composes like Affine */
+    constexpr Vector3d axis(1.0, 2.0, 2.0);
+    constexpr auto q = Quaterniond::rotation(axis, 0.75);
+    constexpr auto xf = geo::Affine3d::rotation(axis, 0.75);
+    constexpr auto point = geo::rotate(q, Vector3d(1.0, -1.0, 0.5));
+    static_assert(geo::norm(point) > 1.5 - 1e-12 && geo::norm(point) < 1.5 + 1e-12);
+    expect(geo::distance(point, geo::transform(xf, Vector3d(1.0, -1.0, 0.5))) < epsilon);
+    auto const r = Quaterniond::rotation(Vector3d(0.0, 0.0, 1.0), std::numbers::pi / 2.0);
+    expect(geo::distance(geo::rotate(r * q, Vector3d(3.0, 0.0, 1.0)),
+                         geo::transform(r.to_matrix() * xf, Vector3d(3.0, 0.0, 1.0))) < epsilon);
+    expect(geo::distance(geo::rotate(geo::inverse(q), point), Vector3d(1.0, -1.0, 0.5)) < epsilon);
+
+    /* from_matrix round trips through every pivot, up to sign */
+    for (auto const & s : {q, Quaterniond::rotation(Vector3d(1.0, 0.0, 0.0), 3.0),
+                           Quaterniond::rotation(Vector3d(0.0, 1.0, 0.1), 3.0),
+                           Quaterniond::rotation(Vector3d(0.1, 0.0, 1.0), -3.0)}) {
+      expect(std::abs(std::abs(geo::dot_product(Quaterniond::from_matrix(s.to_matrix()), s)) - 1.0) < epsilon);
+    }
+
+    /* slerp keeps the angular velocity constant and takes the shorter arc */
+    auto const z = [](double radians) { return Quaterniond::rotation(Vector3d(0.0, 0.0, 1.0), radians); };
+    for (double t : {0.0, 0.25, 0.5, 1.0}) {
+      expect(std::abs(geo::dot_product(geo::slerp(z(0.0), z(2.0), t), z(2.0 * t)) - 1.0) < epsilon);
+      expect(std::abs(std::abs(geo::dot_product(geo::slerp(z(0.0), -z(2.0), t), z(2.0 * t))) - 1.0) < epsilon);
+    }
+    auto const halfway = geo::nlerp(z(0.0), z(2.0), 0.5);
+    expect(std::abs(geo::dot_product(halfway, z(1.0)) - 1.0) < epsilon);
+    expect(geo::slerp(z(0.5), z(0.5 + 1e-9), 0.5) == geo::nlerp(z(0.5), z(0.5 + 1e-9), 0.5));
+
+    /* keyframe arrays */
+    std::vector<Quaterniond> const from{z(0.0), z(1.0), q};
+    std::vector<Quaterniond> const to{z(2.0), z(-1.0), q};
+    std::vector<Quaterniond> frames;
+    geo::slerp(from, to, 0.5, std::back_inserter(frames));
+    expect(frames.size() == 3_ul);
+    expect(std::abs(geo::dot_product(frames[0], z(1.0)) - 1.0) < epsilon);
+    expect(std::abs(geo::dot_product(frames[1], z(0.0)) - 1.0) < epsilon);
+    expect(std::abs(geo::dot_product(frames[2], q) - 1.0) < epsilon);
+    expect(throws<std::invalid_argument>([&] { geo::slerp(from, frames | std::views::take(2), 0.5, frames.begin()); }));
+
+    /* AoS, parallel, SoA and Bezier batches agree with rotating one by one */
+    std::vector<Vector3d> points;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      points.emplace_back(std::cos(static_cast<double>(i)), 0.01 * static_cast<double>(i), std::sin(static_cast<double>(i)));
+    }
+    std::vector<Vector3d> rotated;
+    geo::rotate(q, points, std::back_inserter(rotated));
+    std::vector<Vector3d> parallel(points.size());
+    expect(geo::rotate(geo::execution::par, q, points, parallel.begin()) == parallel.end());
+    std::array<std::vector<double>, 3> soa;
+    for (auto const & p : points) {
+      soa[0].push_back(p.x);
+      soa[1].push_back(p.y);
+      soa[2].push_back(p.z);
+    }
+    geo::rotate(q, {std::span<double const>(soa[0]), std::span<double const>(soa[1]), std::span<double const>(soa[2])},
+                {std::span<double>(soa[0]), std::span<double>(soa[1]), std::span<double>(soa[2])});
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      auto const expected = geo::rotate(q, points[i]);
+      expect(geo::distance(rotated[i], expected) < epsilon * geo::norm(expected) && geo::distance(parallel[i], rotated[i]) == 0.0);
+      expect(geo::distance(Vector3d(soa[0][i], soa[1][i], soa[2][i]), expected) < epsilon * geo::norm(expected));
+    }
+
+    std::vector<geo::Bezier<3, Vector3d>> beziers(2, geo::Bezier<3, Vector3d>(points.cbegin(), points.cbegin() + 4));
+    geo::BezierBatch<3, double, 3> batch(beziers);
+    geo::rotate(q, batch);
+    std::vector<geo::Bezier<3, Vector3d>> nets;
+    geo::rotate(q, beziers, std::back_inserter(nets));
+    for (std::size_t i = 0; i < 4; ++i) {
+      expect(geo::distance(batch.ctrl<Vector3d>(1, i), rotated[i]) < epsilon);
+      expect(geo::distance(nets[1].ctrls[i], rotated[i]) < epsilon);
+    }
+  };
+
   return 0;
 }
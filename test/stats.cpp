@@ -0,0 +1,40 @@
+#include "geometry.hpp"
+#include "ut.hpp"
+
+#include <array>
+#include <string>
+#include <thread>
+
+using namespace boost::ut;
+
+/* built with GEO_ENABLE_STATS and GEO_ENABLE_STATS_TIMERS, so the hooks are
+ * live here and the constant evaluations below also cover them */
+int main()
+{
+  "stats counters and JSON dump"_test = [] {
+    using geo::stats::operation;
+
+    geo::stats::reset();
+    geo::Vector3d const lhs(1.0, 2.0, 2.0);
+    geo::Vector3d const rhs(0.0, 0.0, 1.0);
+    expect(geo::norm(lhs) == 3.0);
+    std::thread([&] { expect(geo::dot_product(lhs, rhs) == 2.0); }).join();
+    std::array const ctrls{geo::Vector2d(0.0, 0.0), geo::Vector2d(1.0, 1.0), geo::Vector2d(2.0, 0.0)};
+    geo::Bezier<2, geo::Vector2d> const bezier(ctrls.cbegin(), ctrls.cend());
+    expect(geo::evaluate_at(bezier, 0.5).y == 0.5);
+
+    auto const snapshot = geo::stats::take_snapshot();
+    expect(snapshot.calls_of(operation::norm) == 1_ul);
+    expect(snapshot.calls_of(operation::dot_product) == 2_ul);
+    expect(snapshot.calls_of(operation::sqrt) == 1_ul);
+    expect(snapshot.calls_of(operation::evaluate_at) == 1_ul);
+    expect(snapshot.calls_of(operation::area) == 0_ul);
+    auto const json = geo::stats::to_json(snapshot);
+    expect(json.starts_with("{\"dot_product\": {\"calls\": 2, \"nanoseconds\": "));
+    expect(json.find("\"area\"") == std::string::npos);
+
+    geo::stats::reset();
+    expect(geo::stats::to_json(geo::stats::take_snapshot()) == "{}");
+    static_assert(geo::dot_product(geo::Vector2d(1.0, 2.0), geo::Vector2d(3.0, 4.0)) == 11.0);
+  };
+}